@@ -0,0 +1,88 @@
+//
+// Created by frostzt on 10/17/2026.
+//
+// Write and read amplification of leveled against tiered compaction on the same update-heavy workload:
+// random overwrites of a fixed key space flushed through a MemTableManager, then random point gets.
+// usage: bench_compaction [writes=2000000] [keys=500000] [gets=200000] [dir=bench_compaction]
+
+#include <cstdio>
+#include <filesystem>
+#include <random>
+
+#include "benchmarks/bench_utils.hpp"
+#include "lib/compaction/compaction_scheduler.hpp"
+#include "lib/io/posix_engine.hpp"
+
+namespace {
+    core::Key keyOf(const int64_t i) {
+        return core::Key{{core::datatypes::Field{i, core::datatypes::FieldType::Int64, nullptr}}};
+    }
+
+    void run(const char *name, const compaction::CompactionStyle style, const std::string &dir, const size_t writes,
+             const size_t keys, const size_t gets) {
+        std::filesystem::remove_all(dir);
+        const auto engine = std::make_shared<io_engine::POSIXEngine>(0);
+
+        compaction::CompactionOptions options;
+        options.style = style;
+        options.baseLevelBytes = 16_MB;
+        options.targetFileBytes = 4_MB;
+        compaction::CompactionScheduler scheduler(engine, dir, options,
+                                                  std::make_shared<sstable::BlockCache>(64_MB));
+        scheduler.start();
+
+        memtable::MemTableManager memTables{"events", memtable::MemTableBackend::SkipList, 4_MB};
+        const std::string payload(100, 'x');
+        std::mt19937_64 rng(42);
+
+        const auto writeStart = bench::Clock::now();
+        for (size_t i = 0; i < writes; ++i) {
+            const auto key = static_cast<int64_t>(rng() % keys);
+            memTables.apply(core::Entry{"events", keyOf(key),
+                                        {{"payload", core::datatypes::Field{payload, core::datatypes::FieldType::String,
+                                                                            nullptr}}},
+                                        false, i + 1});
+            if (memTables.frozenCount() > 0) scheduler.flushFrozen(memTables);
+        }
+
+        scheduler.waitForIdle();
+        const double writeSecs = std::chrono::duration<double>(bench::Clock::now() - writeStart).count();
+
+        size_t found = 0;
+        const auto getStart = bench::Clock::now();
+        for (size_t i = 0; i < gets; ++i) {
+            // Keys still in the active MemTable never reach the tables
+            const auto key = keyOf(static_cast<int64_t>(rng() % keys));
+            found += memTables.get(key) || scheduler.get(key) ? 1 : 0;
+        }
+        const double getSecs = std::chrono::duration<double>(bench::Clock::now() - getStart).count();
+
+        scheduler.stop();
+
+        uint64_t bytes = 0;
+        for (size_t level = 0; level < scheduler.options().levels; ++level) bytes += scheduler.bytesAtLevel(level);
+
+        const auto stats = scheduler.stats();
+        std::printf("%-8s %10.2f %8zu %10.1f %12.0f %12.1f %8.1f %10.2f %8lu\n", name, stats.writeAmplification(),
+                    scheduler.sortedRuns(), static_cast<double>(bytes) / (1024 * 1024),
+                    static_cast<double>(writes) / writeSecs, getSecs * 1e9 / static_cast<double>(gets),
+                    100.0 * static_cast<double>(found) / static_cast<double>(gets),
+                    static_cast<double>(stats.stallNanos) / 1e9, stats.compactions);
+        std::filesystem::remove_all(dir);
+    }
+} // namespace
+
+int main(const int argc, char **argv) {
+    const size_t writes = bench::argOr(argc, argv, 1, 2000000);
+    const size_t keys = bench::argOr(argc, argv, 2, 500000);
+    const size_t gets = bench::argOr(argc, argv, 3, 200000);
+    const std::string dir = argc > 4 ? argv[4] : "bench_compaction";
+
+    std::printf("%zu writes over %zu keys, %zu gets\n\n", writes, keys, gets);
+    std::printf("%-8s %10s %8s %10s %12s %12s %8s %10s %8s\n", "style", "write amp", "runs", "MiB", "writes/s",
+                "get ns", "hit %", "stall s", "merges");
+
+    run("leveled", compaction::CompactionStyle::Leveled, dir, writes, keys, gets);
+    run("tiered", compaction::CompactionStyle::Tiered, dir, writes, keys, gets);
+    return 0;
+}
@@ -0,0 +1,85 @@
+//
+// Created by frostzt on 10/17/2026.
+//
+// CRC32C throughput of the original byte-at-a-time table loop, slicing-by-8 and SSE4.2 across
+// buffer sizes, plus Entry::serialize/deserialize which checksum every WAL record.
+// usage: bench_crc32c [totalMegabytes=256]
+
+#include <cstdio>
+#include <random>
+
+#include "benchmarks/bench_utils.hpp"
+#include "lib/entry/entry.hpp"
+#include "lib/utils/crypto_utils.hpp"
+
+namespace {
+    uint32_t byteAtATime(const uint32_t seed, const std::byte *data, const size_t length) {
+        uint32_t crc = ~seed;
+        for (size_t i = 0; i < length; ++i) {
+            crc = (crc >> 8) ^ Utility::crc32Table[(crc ^ static_cast<uint8_t>(data[i])) & 0xFF];
+        }
+        return ~crc;
+    }
+
+    using CRCFunction = uint32_t (*)(uint32_t, const std::byte *, size_t);
+
+    double gibPerSecond(const CRCFunction fn, const std::vector<std::byte> &buffer, const size_t size,
+                        const size_t totalBytes, uint32_t &sink) {
+        const size_t rounds = std::max<size_t>(1, totalBytes / size);
+        const size_t slots = buffer.size() / size;
+
+        const auto start = bench::Clock::now();
+        for (size_t r = 0; r < rounds; ++r) {
+            sink ^= fn(0, buffer.data() + (r % slots) * size, size);
+        }
+        const double secs = std::chrono::duration<double>(bench::Clock::now() - start).count();
+
+        return static_cast<double>(rounds * size) / secs / (1024.0 * 1024 * 1024);
+    }
+} // namespace
+
+int main(const int argc, char **argv) {
+    const size_t totalBytes = bench::argOr(argc, argv, 1, 256) * 1024 * 1024;
+
+    std::vector<std::byte> buffer(4 * 1024 * 1024);
+    std::mt19937 gen(42);
+    for (auto &b: buffer) b = static_cast<std::byte>(gen() & 0xFF);
+
+    uint32_t sink = 0;
+    std::printf("hardware crc32c: %s\n\n", Utility::hasHardwareCRC32() ? "yes" : "no");
+    std::printf("%10s %12s %12s %12s %12s  (GiB/s)\n", "bytes", "bytewise", "slice-by-8", "sse4.2", "dispatch");
+
+    for (const size_t size: {size_t{64}, size_t{256}, size_t{1024}, size_t{4096}, size_t{65536},
+                             size_t{1024 * 1024}}) {
+        const double bytewise = gibPerSecond(byteAtATime, buffer, size, totalBytes / 4, sink);
+        const double software = gibPerSecond(Utility::extendCRC32Software, buffer, size, totalBytes, sink);
+        const double hardware = Utility::hasHardwareCRC32()
+                                    ? gibPerSecond(Utility::extendCRC32Hardware, buffer, size, totalBytes, sink)
+                                    : 0.0;
+        const double dispatch = gibPerSecond(Utility::extendCRC32, buffer, size, totalBytes, sink);
+
+        std::printf("%10zu %12.2f %12.2f %12.2f %12.2f\n", size, bytewise, software, hardware, dispatch);
+    }
+
+    // End to end: a typical WAL entry through serialize + deserialize
+    core::Key key{{core::datatypes::Field{static_cast<int64_t>(42), core::datatypes::FieldType::Int64, nullptr}}};
+    core::Row row{
+        {"name", core::datatypes::Field{std::string(200, 'x'), core::datatypes::FieldType::String, nullptr}},
+    };
+    const core::Entry entry{"customers", std::move(key), std::move(row), false};
+
+    constexpr size_t kEntries = 200000;
+    const auto start = bench::Clock::now();
+    size_t bytes = 0;
+    for (size_t i = 0; i < kEntries; ++i) {
+        const auto encoded = entry.serialize();
+        const auto decoded = core::Entry::deserialize(encoded.data(), encoded.size());
+        bytes += encoded.size();
+        sink ^= decoded.has_value();
+    }
+    const double secs = std::chrono::duration<double>(bench::Clock::now() - start).count();
+
+    std::printf("\nentry round trip: %.0f entries/s (%zu bytes each)\n", kEntries / secs, bytes / kEntries);
+    std::printf("(sink %u)\n", sink);
+    return 0;
+}
@@ -0,0 +1,140 @@
+//
+// Created by frostzt on 10/17/2026.
+//
+// Entry serialization throughput and heap allocations per entry: the previous push_back path with a
+// vector per field, serialize() into a fresh and into a reused vector, and serializeInto() a batch
+// buffer sized up front, for a row with named columns and for the same row packed against a schema.
+// usage: bench_entry_serialize [entries=1000000]
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+#include "benchmarks/bench_utils.hpp"
+#include "lib/entry/entry.hpp"
+#include "lib/utils/byte_parser.hpp"
+#include "lib/utils/crypto_utils.hpp"
+
+namespace {
+    std::atomic<size_t> allocations{0};
+} // namespace
+
+void *operator new(const std::size_t size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void *p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept { std::free(p); }
+
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+
+namespace {
+    using core::datatypes::Field;
+    using core::datatypes::FieldType;
+
+    /** Entry::serialize as it was before entries were sized up front */
+    void serializeWithFieldVectors(const core::Entry &entry, std::vector<std::byte> &out) {
+        const size_t start = out.size();
+        Utility::ByteParser::writeMagicBytes(out);
+        for (int i = 0; i < 8; i++) out.push_back(std::byte{0});
+
+        Utility::ByteParser::writeString(out, entry.tableName);
+        Utility::ByteParser::writeKey(out, entry.primaryKey_);
+        Utility::ByteParser::writeUint16(out, entry.rowData_.size());
+        for (const auto &[key, value]: entry.rowData_) {
+            Utility::ByteParser::writeString(out, key);
+            Utility::ByteParser::writeVariant(out, value);
+        }
+
+        out.push_back(static_cast<std::byte>(entry.isTombstone_ ? 1 : 0));
+        Utility::ByteParser::writeUint64(out, entry.timestamp_);
+        Utility::ByteParser::patchUint64(out, start + 5, out.size() - start + 4);
+        Utility::ByteParser::writeUint32(out, Utility::computeCRC32(out.data(), start, out.size() - start));
+    }
+
+    struct Result {
+        double entriesPerSecond;
+        double allocationsPerEntry;
+        size_t bytesPerEntry;
+    };
+
+    template<typename Fn>
+    Result measure(const size_t entries, Fn &&serializeOne) {
+        size_t bytes = 0;
+        const size_t before = allocations.load();
+        const auto start = bench::Clock::now();
+        for (size_t i = 0; i < entries; ++i) bytes += serializeOne();
+        const double secs = std::chrono::duration<double>(bench::Clock::now() - start).count();
+
+        return {
+            entries / secs,
+            static_cast<double>(allocations.load() - before) / entries,
+            bytes / entries,
+        };
+    }
+
+    void report(const char *name, const Result &result) {
+        std::printf("%-34s %14.0f %14.2f %10zu\n", name, result.entriesPerSecond, result.allocationsPerEntry,
+                    result.bytesPerEntry);
+    }
+
+    void run(const char *label, const core::Entry &entry, const size_t entries, const bool legacyBaseline) {
+        std::printf("\n%s\n%-34s %14s %14s %10s\n", label, "path", "entries/s", "allocs/entry", "bytes");
+
+        std::vector<std::byte> reused;
+        if (legacyBaseline) {
+            report("push_back + vector per field", measure(entries, [&] {
+                reused.clear();
+                serializeWithFieldVectors(entry, reused);
+                return reused.size();
+            }));
+        }
+
+        report("serialize()", measure(entries, [&] { return entry.serialize().size(); }));
+
+        report("serialize(reused vector)", measure(entries, [&] {
+            reused.clear();
+            entry.serialize(reused);
+            return reused.size();
+        }));
+
+        // A WAL batch: entries are appended back to back into a buffer that is reused once full
+        std::vector<std::byte> batch(1 << 20);
+        size_t offset = 0;
+        report("serializeInto(batch span)", measure(entries, [&] {
+            const size_t size = entry.serializedSize();
+            if (offset + size > batch.size()) offset = 0;
+
+            entry.serializeInto(std::span(batch).subspan(offset, size));
+            offset += size;
+            return size;
+        }));
+    }
+} // namespace
+
+int main(const int argc, char **argv) {
+    const size_t entries = bench::argOr(argc, argv, 1, 1000000);
+
+    const core::Key key{{Field{int64_t{42}, FieldType::Int64, nullptr}}};
+    const core::Row row{
+        {"name", Field{std::string("customer_0000042"), FieldType::String, nullptr}},
+        {"email", Field{std::string("customer_0000042@example.com"), FieldType::String, nullptr}},
+        {"age", Field{int32_t{37}, FieldType::Int32, nullptr}},
+        {"balance", Field{1234.5, FieldType::Double, nullptr}},
+        {"active", Field{true, FieldType::Bool, nullptr}},
+    };
+
+    const auto schema = std::make_shared<const core::TableSchema>("customers", std::vector<core::ColumnSchema>{
+                                                                      {"name", FieldType::String},
+                                                                      {"email", FieldType::String},
+                                                                      {"age", FieldType::Int32},
+                                                                      {"balance", FieldType::Double},
+                                                                      {"active", FieldType::Bool},
+                                                                  }, 1);
+
+    run("named columns", core::Entry{"customers", key, row, false, 1}, entries, true);
+    run("packed row, table id", core::Entry{schema, key, row, false, 1}, entries, false);
+    return 0;
+}
@@ -0,0 +1,89 @@
+//
+// Created by frostzt on 10/17/2026.
+//
+// False positive rate, size and probe cost of the SSTable filter policies across bits per key,
+// probing keys that are absent (the case filters exist for) and keys that are present.
+// usage: bench_filter [keys=1000000]
+
+#include <cstdio>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "benchmarks/bench_utils.hpp"
+#include "lib/sstable/bloom_filter_policy.hpp"
+#include "lib/sstable/ribbon_filter_policy.hpp"
+
+namespace {
+    std::vector<std::string> makeKeys(const size_t begin, const size_t count) {
+        std::vector<std::string> keys;
+        keys.reserve(count);
+        for (size_t i = begin; i < begin + count; ++i) keys.push_back("customer:" + std::to_string(i));
+        return keys;
+    }
+
+    template<typename Probe>
+    double nanosPerProbe(const std::vector<std::string> &keys, const Probe &probe, size_t &hits) {
+        const auto start = bench::Clock::now();
+        for (const auto &key: keys) hits += probe(key) ? 1 : 0;
+        const double secs = std::chrono::duration<double>(bench::Clock::now() - start).count();
+
+        return secs * 1e9 / static_cast<double>(keys.size());
+    }
+
+    void run(const char *name, const size_t bitsPerKey, sstable::FilterPolicy &writer, sstable::FilterPolicy &reader,
+             const std::vector<std::string> &present, const std::vector<std::string> &absent,
+             const std::function<bool(const std::string &)> &portable) {
+        for (const auto &key: present) writer.add(key);
+
+        std::vector<uint8_t> serialized;
+        writer.serialize(&serialized);
+        reader.deserialize(serialized.data(), serialized.size());
+
+        size_t falsePositives = 0;
+        size_t presentHits = 0;
+        const double absentNs = nanosPerProbe(absent, [&](const std::string &k) { return reader.mayContain(k); },
+                                              falsePositives);
+        const double presentNs = nanosPerProbe(present, [&](const std::string &k) { return reader.mayContain(k); },
+                                               presentHits);
+
+        size_t sink = 0;
+        const double portableNs = portable ? nanosPerProbe(absent, portable, sink) : 0.0;
+
+        std::printf("%-14s %5zu %10.2f %10.4f %12.1f %12.1f %12.1f\n", name, bitsPerKey,
+                    static_cast<double>(serialized.size() * 8) / static_cast<double>(present.size()),
+                    100.0 * static_cast<double>(falsePositives) / static_cast<double>(absent.size()),
+                    absentNs, presentNs, portableNs);
+
+        if (presentHits != present.size()) std::printf("  !! %zu false negatives\n", present.size() - presentHits);
+    }
+} // namespace
+
+int main(const int argc, char **argv) {
+    const size_t count = bench::argOr(argc, argv, 1, 1000000);
+
+    const auto present = makeKeys(0, count);
+    const auto absent = makeKeys(count, count);
+
+    std::printf("avx2 probe: %s, %zu keys\n\n", sstable::BlockedBloomFilterPolicy::hasAVX2Probe() ? "yes" : "no",
+                count);
+    std::printf("%-14s %5s %10s %10s %12s %12s %12s\n", "policy", "bpk", "bits/key", "fp %", "absent ns",
+                "present ns", "portable ns");
+
+    for (const size_t bitsPerKey: {size_t{6}, size_t{8}, size_t{10}, size_t{12}, size_t{16}}) {
+        sstable::BlockedBloomFilterPolicy writer(bitsPerKey);
+        sstable::BlockedBloomFilterPolicy reader(bitsPerKey);
+        run(writer.name().data(), bitsPerKey, writer, reader, present, absent,
+            [&reader](const std::string &k) { return reader.mayContainPortable(k); });
+    }
+
+    // Ribbon spends bits on fingerprints, the false positive rate is 2^-bits
+    for (const size_t resultBits: {size_t{6}, size_t{7}, size_t{8}}) {
+        sstable::RibbonFilterPolicy writer(resultBits);
+        sstable::RibbonFilterPolicy reader(resultBits);
+        run(writer.name().data(), resultBits, writer, reader, present, absent, nullptr);
+    }
+
+    return 0;
+}
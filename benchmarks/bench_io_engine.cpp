@@ -0,0 +1,96 @@
+//
+// Created by frostzt on 10/17/2026.
+//
+// WAL record appends through std::ofstream (the old WALWriter path) against the POSIX IO engine.
+// usage: bench_io_engine [records=200000] [syncEvery=64] [dir=bench_io]
+
+#include <cstdio>
+#include <fcntl.h>
+#include <filesystem>
+#include <unistd.h>
+
+#include "benchmarks/bench_utils.hpp"
+#include "lib/io/posix_engine.hpp"
+#include "lib/wal/wal_codec.hpp"
+
+namespace {
+    core::Entry makeEntry(const size_t id) {
+        core::Key key{{core::datatypes::Field{static_cast<int64_t>(id), core::datatypes::FieldType::Int64, nullptr}}};
+        core::Row row{
+            {"name", core::datatypes::Field{std::string("user_") + std::to_string(id),
+                                            core::datatypes::FieldType::String, nullptr}},
+        };
+        return core::Entry{"customers", std::move(key), std::move(row), false};
+    }
+
+    void report(const char *name, const size_t records, const size_t bytes, const double secs) {
+        std::printf("%-26s %12.0f %10.1f\n", name, static_cast<double>(records) / secs,
+                    static_cast<double>(bytes) / secs / (1024 * 1024));
+    }
+} // namespace
+
+int main(const int argc, char **argv) {
+    const size_t count = bench::argOr(argc, argv, 1, 200000);
+    const size_t syncEvery = std::max<size_t>(1, bench::argOr(argc, argv, 2, 64));
+    const std::string dir = argc > 3 ? argv[3] : "bench_io";
+
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+
+    std::vector<core::Entry> entries;
+    entries.reserve(count);
+    for (size_t i = 0; i < count; ++i) entries.push_back(makeEntry(i));
+
+    std::printf("%-26s %12s %10s\n", "path", "records/s", "MiB/s");
+
+    // Old writer: writeRecord + flush per record, fdatasync through a second descriptor
+    for (const bool sync: {false, true}) {
+        const std::string path = dir + "/ofstream.wal";
+        std::filesystem::remove(path);
+
+        std::ofstream out(path, std::ios::out | std::ios::app | std::ios::binary);
+        const int fd = ::open(path.c_str(), O_WRONLY | O_CLOEXEC);
+
+        size_t bytes = 0;
+        const double secs = bench::runThreads(1, [&](size_t) {
+            for (size_t i = 0; i < count; ++i) {
+                bytes += WAL::writeRecord(out, entries[i], WAL::FlushMode::FORCE_FLUSH);
+                if (sync && (i + 1) % syncEvery == 0) ::fdatasync(fd);
+            }
+        });
+
+        ::close(fd);
+        report(sync ? "ofstream+fdatasync" : "ofstream", count, bytes, secs);
+    }
+
+    // New writer: encode into a reused buffer and hand it to the engine
+    for (const bool sync: {false, true}) {
+        for (const size_t prealloc: {size_t{0}, io_engine::POSIXEngine::kDefaultPreallocateBytes}) {
+            const std::string name = "engine.wal";
+            std::filesystem::remove(dir + "/" + name);
+
+            io_engine::POSIXEngine engine{prealloc};
+            const auto seg = engine.openSegment(dir, name);
+
+            std::vector<std::byte> buffer;
+            size_t bytes = 0;
+            const double secs = bench::runThreads(1, [&](size_t) {
+                for (size_t i = 0; i < count; ++i) {
+                    buffer.clear();
+                    bytes += WAL::encodeRecord(buffer, entries[i]);
+                    engine.write(seg, buffer.data(), buffer.size());
+                    if (sync && (i + 1) % syncEvery == 0) engine.flush(seg);
+                }
+            });
+
+            engine.close(seg);
+
+            std::string label = prealloc ? "engine+fallocate" : "engine";
+            if (sync) label += "+fdatasync";
+            report(label.c_str(), count, bytes, secs);
+        }
+    }
+
+    std::filesystem::remove_all(dir);
+    return 0;
+}
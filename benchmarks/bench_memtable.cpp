@@ -0,0 +1,103 @@
+//
+// Created by frostzt on 10/17/2026.
+//
+// Put/get scaling and heap footprint of the AVL and skiplist MemTable backends.
+// usage: bench_memtable [entries=200000] [maxThreads=hardware_concurrency]
+
+#include <cstdio>
+#include <malloc.h>
+
+#include "benchmarks/bench_utils.hpp"
+#include "lib/memtable/memtable.hpp"
+#include "lib/memtable/memtable_manager.hpp"
+
+namespace {
+    std::vector<core::Entry> makeEntries(const size_t count) {
+        std::vector<core::Entry> entries;
+        entries.reserve(count);
+
+        for (size_t i = 0; i < count; ++i) {
+            // Spread keys so inserts do not arrive in sorted order
+            const auto id = static_cast<int64_t>((i * 2654435761u) % count);
+            core::Key key{{core::datatypes::Field{id, core::datatypes::FieldType::Int64, nullptr}}};
+            core::Row row{
+                {"name", core::datatypes::Field{std::string("user_") + std::to_string(id),
+                                                core::datatypes::FieldType::String, nullptr}},
+                {"balance", core::datatypes::Field{static_cast<double>(id), core::datatypes::FieldType::Double,
+                                                   nullptr}},
+            };
+            entries.emplace_back("customers", std::move(key), std::move(row), false);
+        }
+
+        return entries;
+    }
+
+    const char *backendName(const memtable::MemTableBackend backend) {
+        return backend == memtable::MemTableBackend::SkipList ? "skiplist" : "avl";
+    }
+} // namespace
+
+int main(const int argc, char **argv) {
+    const size_t count = bench::argOr(argc, argv, 1, 200000);
+    const size_t maxThreads = bench::argOr(argc, argv, 2, std::max(1u, std::thread::hardware_concurrency()));
+
+    const auto entries = makeEntries(count);
+
+    // Heap bytes held per entry and the cost of a single-threaded fill plus teardown
+    std::printf("%-9s %14s %14s %14s\n", "backend", "bytes/entry", "insert ops/s", "teardown ms");
+    for (const auto backend: {memtable::MemTableBackend::AVL, memtable::MemTableBackend::SkipList}) {
+        const size_t heapBefore = mallinfo2().uordblks;
+        auto table = std::make_unique<memtable::MemTable>("customers", backend);
+
+        const double putSecs = bench::runThreads(1, [&](size_t) {
+            for (const auto &entry: entries) table->put(entry);
+        });
+        const size_t heapAfter = mallinfo2().uordblks;
+
+        const auto teardownStart = bench::Clock::now();
+        table.reset();
+        const double teardownMs = std::chrono::duration<double, std::milli>(bench::Clock::now() - teardownStart).
+                count();
+
+        std::printf("%-9s %14.1f %14.0f %14.2f\n", backendName(backend),
+                    static_cast<double>(heapAfter - heapBefore) / static_cast<double>(count),
+                    static_cast<double>(count) / putSecs, teardownMs);
+    }
+    std::printf("\n");
+
+    // Write path through the manager, including the per-write rotation check
+    std::printf("%-9s %14s %14s\n", "backend", "apply ops/s", "frozen");
+    for (const auto backend: {memtable::MemTableBackend::AVL, memtable::MemTableBackend::SkipList}) {
+        memtable::MemTableManager manager{"customers", backend};
+
+        const double applySecs = bench::runThreads(1, [&](size_t) {
+            for (const auto &entry: entries) manager.apply(entry);
+        });
+
+        std::printf("%-9s %14.0f %14zu\n", backendName(backend), static_cast<double>(count) / applySecs,
+                    manager.frozenCount());
+    }
+    std::printf("\n");
+
+    std::printf("%-9s %8s %14s %14s\n", "backend", "threads", "put ops/s", "get ops/s");
+    for (const auto backend: {memtable::MemTableBackend::AVL, memtable::MemTableBackend::SkipList}) {
+        for (const size_t threads: bench::threadSteps(maxThreads)) {
+            const memtable::MemTable table{"customers", backend};
+
+            const double putSecs = bench::runThreads(threads, [&](const size_t t) {
+                for (size_t i = t; i < count; i += threads) table.put(entries[i]);
+            });
+
+            const double getSecs = bench::runThreads(threads, [&](const size_t t) {
+                for (size_t i = t; i < count; i += threads) {
+                    if (!table.get(entries[i].primaryKey_)) std::abort();
+                }
+            });
+
+            std::printf("%-9s %8zu %14.0f %14.0f\n", backendName(backend), threads,
+                        static_cast<double>(count) / putSecs, static_cast<double>(count) / getSecs);
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,61 @@
+//
+// Created by frostzt on 10/17/2026.
+//
+
+#ifndef ENIGMA_DB_BENCH_UTILS_HPP
+#define ENIGMA_DB_BENCH_UTILS_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace bench {
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * Reads an unsigned integer from argv[index], falling back to `fallback` when absent.
+     */
+    inline size_t argOr(const int argc, char **argv, const int index, const size_t fallback) {
+        if (argc <= index) return fallback;
+        return std::strtoull(argv[index], nullptr, 10);
+    }
+
+    /**
+     * Runs `fn(threadIdx)` on `threads` threads that start together and returns the wall time in
+     * seconds between the start signal and the last thread finishing.
+     */
+    inline double runThreads(const size_t threads, const std::function<void(size_t)> &fn) {
+        std::atomic<bool> go{false};
+        std::vector<std::thread> pool;
+        pool.reserve(threads);
+
+        for (size_t t = 0; t < threads; ++t) {
+            pool.emplace_back([&go, &fn, t]() {
+                while (!go.load(std::memory_order_acquire)) std::this_thread::yield();
+                fn(t);
+            });
+        }
+
+        const auto start = Clock::now();
+        go.store(true, std::memory_order_release);
+        for (auto &thread: pool) thread.join();
+
+        return std::chrono::duration<double>(Clock::now() - start).count();
+    }
+
+    /**
+     * Thread counts 1, 2, 4, ... up to and including `maxThreads`.
+     */
+    inline std::vector<size_t> threadSteps(const size_t maxThreads) {
+        std::vector<size_t> steps;
+        for (size_t t = 1; t < maxThreads; t *= 2) steps.push_back(t);
+        steps.push_back(maxThreads);
+        return steps;
+    }
+} // namespace bench
+
+#endif //ENIGMA_DB_BENCH_UTILS_HPP
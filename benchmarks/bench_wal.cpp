@@ -0,0 +1,75 @@
+//
+// Created by frostzt on 10/17/2026.
+//
+// Append latency and throughput of the WAL per flush mode at 1, 8 and 64 concurrent appenders.
+// usage: bench_wal [recordsPerThread=2000] [walWriters=1] [dir=bench_wal]
+
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+
+#include "benchmarks/bench_utils.hpp"
+#include "lib/wal/wal_manager.hpp"
+
+namespace {
+    core::Entry makeEntry(const size_t id) {
+        core::Key key{{core::datatypes::Field{static_cast<int64_t>(id), core::datatypes::FieldType::Int64, nullptr}}};
+        core::Row row{
+            {"name", core::datatypes::Field{std::string("user_") + std::to_string(id),
+                                            core::datatypes::FieldType::String, nullptr}},
+        };
+        return core::Entry{"customers", std::move(key), std::move(row), false};
+    }
+
+    const char *modeName(const WAL::FlushMode mode) {
+        return mode == WAL::FlushMode::GROUP_COMMIT ? "group" : "flush";
+    }
+
+    double percentile(const std::vector<double> &sorted, const double p) {
+        if (sorted.empty()) return 0;
+        return sorted[std::min(sorted.size() - 1, static_cast<size_t>(p * static_cast<double>(sorted.size())))];
+    }
+} // namespace
+
+int main(const int argc, char **argv) {
+    const size_t perThread = bench::argOr(argc, argv, 1, 2000);
+    const size_t walWriters = bench::argOr(argc, argv, 2, 1);
+    std::string dir = argc > 3 ? argv[3] : "bench_wal";
+
+    std::printf("%-6s %8s %14s %10s %10s\n", "mode", "threads", "records/s", "p50 us", "p99 us");
+    for (const auto mode: {WAL::FlushMode::FORCE_FLUSH, WAL::FlushMode::GROUP_COMMIT}) {
+        for (const size_t threads: {1, 8, 64}) {
+            std::filesystem::remove_all(dir);
+            std::filesystem::create_directories(dir);
+
+            std::vector<std::vector<double> > latencies(threads);
+            double secs;
+            {
+                WAL::WALManager manager(walWriters, 64_MB, dir, mode);
+                secs = bench::runThreads(threads, [&](const size_t t) {
+                    latencies[t].reserve(perThread);
+                    for (size_t i = 0; i < perThread; ++i) {
+                        const auto entry = makeEntry(t * perThread + i);
+
+                        const auto start = bench::Clock::now();
+                        if (!manager.append(entry)) std::abort();
+                        latencies[t].push_back(
+                            std::chrono::duration<double, std::micro>(bench::Clock::now() - start).count());
+                    }
+                });
+            }
+
+            std::vector<double> all;
+            for (const auto &perThreadLatencies: latencies) {
+                all.insert(all.end(), perThreadLatencies.begin(), perThreadLatencies.end());
+            }
+            std::ranges::sort(all);
+
+            std::printf("%-6s %8zu %14.0f %10.1f %10.1f\n", modeName(mode), threads,
+                        static_cast<double>(all.size()) / secs, percentile(all, 0.50), percentile(all, 0.99));
+        }
+    }
+
+    std::filesystem::remove_all(dir);
+    return 0;
+}
@@ -0,0 +1,93 @@
+//
+// Created by frostzt on 10/17/2026.
+//
+// WAL recovery time: the sequential loadAll() + sort against parallel recover() at 1 and N workers.
+// usage: bench_wal_recovery [megabytes=1024] [workers=8] [dir=bench_wal_recovery] [baseline=1]
+//
+// The baseline keeps every decoded entry in memory at once; pass baseline=0 for WALs that do not fit.
+
+#include <cstdio>
+#include <filesystem>
+
+#include "benchmarks/bench_utils.hpp"
+#include "lib/memtable/memtable_manager.hpp"
+#include "lib/wal/wal_manager.hpp"
+
+namespace {
+    constexpr size_t kWALWriters = 8;
+
+    size_t directoryBytes(const std::string &dir) {
+        size_t bytes = 0;
+        for (const auto &entry: std::filesystem::directory_iterator(dir)) bytes += entry.file_size();
+        return bytes;
+    }
+
+    void generate(std::string &dir, const size_t targetBytes) {
+        WAL::WALManager manager(kWALWriters, 64_MB, dir, WAL::FlushMode::NO_FLUSH);
+
+        const std::string padding(160, 'x');
+        bench::runThreads(kWALWriters, [&](const size_t t) {
+            // Check the size every few thousand records, stat'ing per append would dominate
+            for (size_t i = 0;; ++i) {
+                if (i % 4096 == 0 && directoryBytes(dir) >= targetBytes) return;
+
+                core::Key key{{core::datatypes::Field{static_cast<int64_t>(i * kWALWriters + t),
+                                                      core::datatypes::FieldType::Int64, nullptr}}};
+                core::Row row{{"payload", core::datatypes::Field{padding, core::datatypes::FieldType::String,
+                                                                 nullptr}}};
+                if (!manager.append(core::Entry{"customers", std::move(key), std::move(row), false})) std::abort();
+            }
+        });
+    }
+} // namespace
+
+int main(const int argc, char **argv) {
+    const size_t megabytes = bench::argOr(argc, argv, 1, 1024);
+    const size_t workers = bench::argOr(argc, argv, 2, 8);
+    std::string dir = argc > 3 ? argv[3] : "bench_wal_recovery";
+    const bool baseline = bench::argOr(argc, argv, 4, 1) != 0;
+
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+    generate(dir, megabytes * 1_MB);
+
+    const WAL::WALManager manager(0, 64_MB, dir);
+    std::printf("WAL: %.0f MiB in %zu writer streams, %u hardware threads\n",
+                static_cast<double>(directoryBytes(dir)) / (1024 * 1024), kWALWriters,
+                std::thread::hardware_concurrency());
+    std::printf("%-28s %10s %12s\n", "path", "seconds", "entries");
+
+    size_t entries = 0;
+    double secs = 0;
+    if (baseline) {
+        secs = bench::runThreads(1, [&](size_t) {
+            // What loadAll() did before: one stream at a time, then a global sort
+            std::vector<core::Entry> all;
+            manager.loadAll([&all](core::Entry &&entry) { all.push_back(std::move(entry)); });
+            std::ranges::sort(all, [](const core::Entry &a, const core::Entry &b) {
+                return a.timestamp_ < b.timestamp_;
+            });
+            entries = all.size();
+        });
+        std::printf("%-28s %10.2f %12zu\n", "sequential + sort", secs, entries);
+    }
+
+    for (const size_t w: {size_t{1}, workers}) {
+        entries = 0;
+        secs = bench::runThreads(1, [&](size_t) {
+            manager.recover([&entries](core::Entry &&) { entries++; }, w);
+        });
+        const std::string label = "recover, " + std::to_string(w) + " workers";
+        std::printf("%-28s %10.2f %12zu\n", label.c_str(), secs, entries);
+    }
+
+    for (const size_t w: {size_t{1}, workers}) {
+        memtable::MemTableManager memTables{"customers", memtable::MemTableBackend::SkipList};
+        secs = bench::runThreads(1, [&](size_t) { manager.recoverInto(memTables, w); });
+        const std::string label = "recoverInto, " + std::to_string(w) + " workers";
+        std::printf("%-28s %10.2f %12zu\n", label.c_str(), secs, entries);
+    }
+
+    std::filesystem::remove_all(dir);
+    return 0;
+}
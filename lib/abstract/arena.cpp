@@ -0,0 +1,62 @@
+//
+// Created by frostzt on 10/17/2026.
+//
+
+#include "arena.hpp"
+
+#include <cassert>
+
+Arena::Arena(const size_t blockSize): blockSize_(blockSize), current_(nullptr) {
+    assert(blockSize >= kAlignment);
+    this->current_.store(this->newBlock(blockSize), std::memory_order_release);
+}
+
+Arena::Block *Arena::newBlock(const size_t bytes) {
+    auto block = std::make_unique<Block>(bytes);
+    Block *raw = block.get();
+
+    this->blocks_.push_back(std::move(block));
+    this->memoryUsage_.fetch_add(bytes + sizeof(Block), std::memory_order_relaxed);
+
+    return raw;
+}
+
+std::byte *Arena::allocate(size_t bytes) {
+    assert(bytes > 0);
+
+    // Keep every allocation aligned by rounding sizes up; new[] hands out max-aligned blocks
+    bytes = (bytes + kAlignment - 1) & ~(kAlignment - 1);
+
+    Block *block = this->current_.load(std::memory_order_acquire);
+    const size_t offset = block->used.fetch_add(bytes, std::memory_order_relaxed);
+    if (offset + bytes <= block->size) return block->data.get() + offset;
+
+    return this->allocateFallback(bytes, block);
+}
+
+std::byte *Arena::allocateFallback(const size_t bytes, Block *exhausted) {
+    std::lock_guard lock(this->refillMutex_);
+
+    // Large objects get a dedicated block so the current one is not wasted
+    if (bytes > this->blockSize_ / 4) {
+        return this->newBlock(bytes)->data.get();
+    }
+
+    // Someone else may have refilled while we waited for the lock
+    Block *block = this->current_.load(std::memory_order_acquire);
+    if (block == exhausted) {
+        block = this->newBlock(this->blockSize_);
+        block->used.store(bytes, std::memory_order_relaxed);
+        this->current_.store(block, std::memory_order_release);
+        return block->data.get();
+    }
+
+    const size_t offset = block->used.fetch_add(bytes, std::memory_order_relaxed);
+    if (offset + bytes <= block->size) return block->data.get() + offset;
+
+    // The fresh block filled up as well; start another one
+    block = this->newBlock(this->blockSize_);
+    block->used.store(bytes, std::memory_order_relaxed);
+    this->current_.store(block, std::memory_order_release);
+    return block->data.get();
+}
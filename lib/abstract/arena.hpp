@@ -0,0 +1,77 @@
+//
+// Created by frostzt on 10/17/2026.
+//
+
+#ifndef ENIGMA_DB_ARENA_HPP
+#define ENIGMA_DB_ARENA_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/**
+ * Bump allocator that hands out memory from large blocks and frees everything at once when it is
+ * destroyed. Allocation is thread-safe: the common path is a single atomic add on the current block,
+ * only refilling a block takes the mutex.
+ *
+ * Nothing allocated from an Arena is ever freed individually, so it is meant for data that shares
+ * one lifetime, e.g. everything a MemTable holds.
+ */
+class Arena {
+public:
+    static constexpr size_t kDefaultBlockSize = 64 * 1024;
+    static constexpr size_t kAlignment = alignof(std::max_align_t);
+
+    explicit Arena(size_t blockSize = kDefaultBlockSize);
+
+    Arena(const Arena &) = delete;
+
+    Arena &operator=(const Arena &) = delete;
+
+    /**
+     * Returns `bytes` of memory aligned to `kAlignment`. The memory stays valid until the arena
+     * is destroyed.
+     *
+     * @param bytes Number of bytes to allocate, must be non-zero.
+     * @return Pointer to the allocated memory.
+     */
+    std::byte *allocate(size_t bytes);
+
+    /**
+     * Total bytes reserved from the system allocator, including the unused tail of each block.
+     */
+    [[nodiscard]] size_t memoryUsage() const {
+        return this->memoryUsage_.load(std::memory_order_relaxed);
+    }
+
+private:
+    struct Block {
+        std::unique_ptr<std::byte[]> data;
+        size_t size;
+        std::atomic<size_t> used{0};
+
+        explicit Block(const size_t bytes): data(new std::byte[bytes]), size(bytes) {
+        }
+    };
+
+    size_t blockSize_;
+
+    /** Block currently being bumped; replaced (never freed) when it runs out */
+    std::atomic<Block *> current_;
+
+    /** Every block owned by this arena */
+    std::vector<std::unique_ptr<Block> > blocks_;
+
+    std::atomic<size_t> memoryUsage_{0};
+
+    /** Guards block refills and the blocks_ vector */
+    std::mutex refillMutex_;
+
+    Block *newBlock(size_t bytes);
+
+    std::byte *allocateFallback(size_t bytes, Block *exhausted);
+};
+
+#endif //ENIGMA_DB_ARENA_HPP
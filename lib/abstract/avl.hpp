@@ -9,54 +9,111 @@
 #include <memory>
 #include <vector>
 
+#include "lib/abstract/arena.hpp"
+
+template<typename T>
+class Node;
+
+/**
+ * Releases a node; nodes carved out of an Arena are only destroyed, their memory goes away with the arena.
+ */
+template<typename T>
+struct NodeDeleter {
+    void operator()(Node<T> *node) const;
+};
+
+template<typename T>
+using NodePtr = std::unique_ptr<Node<T>, NodeDeleter<T> >;
+
 template<typename T>
 class Node {
 public:
     T key;
     int height;
-    std::unique_ptr<Node<T> > left;
-    std::unique_ptr<Node<T> > right;
+    bool arenaOwned;
+    NodePtr<T> left;
+    NodePtr<T> right;
 
-    explicit Node(const T &val) : key(val), height(1), left(nullptr), right(nullptr) {
+    explicit Node(const T &val, const bool inArena = false) : key(val), height(1), arenaOwned(inArena), left(nullptr),
+                                                              right(nullptr) {
     }
 
-    static int getHeight(const std::unique_ptr<Node<T> > &node);
+    static int getHeight(const NodePtr<T> &node);
 
-    static int getBalance(const std::unique_ptr<Node<T> > &node);
+    static int getBalance(const NodePtr<T> &node);
 };
 
 template<typename T>
 class AVLTree {
 private:
-    std::unique_ptr<Node<T> > _root;
+    NodePtr<T> _root;
 
     int size_;
 
-    void insert(std::unique_ptr<Node<T> > &root, const T &key);
+    /** Optional arena to carve nodes out of, nodes are heap allocated when null */
+    Arena *arena_;
+
+    NodePtr<T> makeNode(const T &key);
 
-    void remove(std::unique_ptr<Node<T> > &root, const T &key);
+    void insert(NodePtr<T> &root, const T &key);
 
-    static void inorder(const std::unique_ptr<Node<T> > &root);
+    void remove(NodePtr<T> &root, const T &key);
 
-    static Node<T> *search(const std::unique_ptr<Node<T> > &root, const T &key);
+    static void inorder(const NodePtr<T> &root);
 
-    static std::unique_ptr<Node<T> > &findNodeRef(std::unique_ptr<Node<T> > &root, const T &key);
+    static Node<T> *search(const NodePtr<T> &root, const T &key);
 
-    void inOrderIntoVector(const std::unique_ptr<Node<T> > &root, std::vector<T> &_v) const;
+    static NodePtr<T> &findNodeRef(NodePtr<T> &root, const T &key);
 
-    static void rotateLeft(std::unique_ptr<Node<T> > &node);
+    void inOrderIntoVector(const NodePtr<T> &root, std::vector<T> &_v) const;
 
-    static void rotateRight(std::unique_ptr<Node<T> > &node);
+    static void rotateLeft(NodePtr<T> &node);
 
-    static std::unique_ptr<Node<T> > &findLeftMost(std::unique_ptr<Node<T> > &node);
+    static void rotateRight(NodePtr<T> &node);
 
-    static const std::unique_ptr<Node<T> > &findLeftMost(const std::unique_ptr<Node<T> > &node);
+    static NodePtr<T> &findLeftMost(NodePtr<T> &node);
 
-    static std::unique_ptr<Node<T> > &findRightMost(std::unique_ptr<Node<T> > &node);
+    static const NodePtr<T> &findLeftMost(const NodePtr<T> &node);
 
-    static const std::unique_ptr<Node<T> > &findRightMost(const std::unique_ptr<Node<T> > &node);
+    static NodePtr<T> &findRightMost(NodePtr<T> &node);
+
+    static const NodePtr<T> &findRightMost(const NodePtr<T> &node);
 
 public:
+    /**
+     * Bidirectional in-order cursor. Keeps the root-to-node path so stepping is amortised O(1);
+     * any insert or remove on the tree invalidates it.
+     */
+    class Iterator {
+    private:
+        const AVLTree *tree_;
+        std::vector<Node<T> *> path_;
+
+    public:
+        explicit Iterator(const AVLTree *tree): tree_(tree) {
+        }
+
+        [[nodiscard]] bool valid() const { return !this->path_.empty(); }
+
+        [[nodiscard]] const T &key() const { return this->path_.back()->key; }
+
+        void seekToFirst();
+
+        void seekToLast();
+
+        /** Positions at the first key that is not less than `target` */
+        void seek(const T &target);
+
+        /** Positions at the last key that is not greater than `target` */
+        void seekForPrev(const T &target);
+
+        void next();
+
+        void prev();
+    };
+
+    [[nodiscard]] Iterator iterator() const { return Iterator(this); }
+
     void insert(const T &key);
 
     void inorder() const;
@@ -69,14 +126,121 @@ public:
 
     std::vector<T> toSortedVector() const;
 
+    [[nodiscard]] size_t size() const { return static_cast<size_t>(size_); }
+
     [[nodiscard]] Node<T> *search(const T &key) const;
 
-    AVLTree(): _root(nullptr), size_(0) {
+    explicit AVLTree(Arena *arena = nullptr): _root(nullptr), size_(0), arena_(arena) {
     }
 };
 
 template<typename T>
-int Node<T>::getHeight(const std::unique_ptr<Node<T> > &node) {
+void AVLTree<T>::Iterator::seekToFirst() {
+    this->path_.clear();
+    for (Node<T> *node = this->tree_->_root.get(); node != nullptr; node = node->left.get()) {
+        this->path_.push_back(node);
+    }
+}
+
+template<typename T>
+void AVLTree<T>::Iterator::seekToLast() {
+    this->path_.clear();
+    for (Node<T> *node = this->tree_->_root.get(); node != nullptr; node = node->right.get()) {
+        this->path_.push_back(node);
+    }
+}
+
+template<typename T>
+void AVLTree<T>::Iterator::seek(const T &target) {
+    this->path_.clear();
+
+    // The answer is the last node we turned left at; cut the path back to it
+    size_t found = 0;
+    for (Node<T> *node = this->tree_->_root.get(); node != nullptr;) {
+        this->path_.push_back(node);
+        if (std::less<T>{}(node->key, target)) {
+            node = node->right.get();
+        } else {
+            found = this->path_.size();
+            node = node->left.get();
+        }
+    }
+
+    this->path_.resize(found);
+}
+
+template<typename T>
+void AVLTree<T>::Iterator::seekForPrev(const T &target) {
+    this->path_.clear();
+
+    size_t found = 0;
+    for (Node<T> *node = this->tree_->_root.get(); node != nullptr;) {
+        this->path_.push_back(node);
+        if (std::less<T>{}(target, node->key)) {
+            node = node->left.get();
+        } else {
+            found = this->path_.size();
+            node = node->right.get();
+        }
+    }
+
+    this->path_.resize(found);
+}
+
+template<typename T>
+void AVLTree<T>::Iterator::next() {
+    Node<T> *node = this->path_.back();
+    if (node->right) {
+        for (node = node->right.get(); node != nullptr; node = node->left.get()) {
+            this->path_.push_back(node);
+        }
+        return;
+    }
+
+    // Climb until we leave a left subtree; that parent is the successor
+    this->path_.pop_back();
+    while (!this->path_.empty() && this->path_.back()->right.get() == node) {
+        node = this->path_.back();
+        this->path_.pop_back();
+    }
+}
+
+template<typename T>
+void AVLTree<T>::Iterator::prev() {
+    Node<T> *node = this->path_.back();
+    if (node->left) {
+        for (node = node->left.get(); node != nullptr; node = node->right.get()) {
+            this->path_.push_back(node);
+        }
+        return;
+    }
+
+    this->path_.pop_back();
+    while (!this->path_.empty() && this->path_.back()->left.get() == node) {
+        node = this->path_.back();
+        this->path_.pop_back();
+    }
+}
+
+template<typename T>
+void NodeDeleter<T>::operator()(Node<T> *node) const {
+    if (node->arenaOwned) {
+        node->~Node();
+    } else {
+        delete node;
+    }
+}
+
+template<typename T>
+NodePtr<T> AVLTree<T>::makeNode(const T &key) {
+    if (this->arena_ == nullptr) return NodePtr<T>(new Node<T>(key));
+
+    void *mem = this->arena_->allocate(sizeof(Node<T>));
+    return NodePtr<T>(new(mem) Node<T>(key, true));
+}
+
+template<typename T>
+int Node<T>::getHeight(const NodePtr<T> &node) {
     if (node) {
         return node->height;
     }
@@ -85,7 +249,7 @@ int Node<T>::getHeight(const std::unique_ptr<Node<T> > &node) {
 }
 
 template<typename T>
-int Node<T>::getBalance(const std::unique_ptr<Node<T> > &node) {
+int Node<T>::getBalance(const NodePtr<T> &node) {
     if (!node) {
         return 0;
     }
@@ -96,10 +260,11 @@ int Node<T>::getBalance(const std::unique_ptr<Node<T> > &node) {
 template<typename T>
 void AVLTree<T>::clear() {
     _root = nullptr;
+    size_ = 0;
 }
 
 template<typename T>
-void AVLTree<T>::rotateLeft(std::unique_ptr<Node<T> > &node) {
+void AVLTree<T>::rotateLeft(NodePtr<T> &node) {
     const auto oldNode = node.get();
 
     auto newRoot = std::move(node->right);
@@ -114,7 +279,7 @@ void AVLTree<T>::rotateLeft(std::unique_ptr<Node<T> > &node) {
 }
 
 template<typename T>
-void AVLTree<T>::rotateRight(std::unique_ptr<Node<T> > &node) {
+void AVLTree<T>::rotateRight(NodePtr<T> &node) {
     const auto oldNode = node.get();
 
     auto newRoot = std::move(node->left);
@@ -134,7 +299,7 @@ void AVLTree<T>::remove(const T &key) {
 }
 
 template<typename T>
-void AVLTree<T>::remove(std::unique_ptr<Node<T> > &root, const T &key) {
+void AVLTree<T>::remove(NodePtr<T> &root, const T &key) {
     if (!root) return;
 
     if (std::less<T>{}(root->key, key)) {
@@ -189,10 +354,10 @@ void AVLTree<T>::insert(const T &key) {
 }
 
 template<typename T>
-void AVLTree<T>::insert(std::unique_ptr<Node<T> > &root, const T &key) {
+void AVLTree<T>::insert(NodePtr<T> &root, const T &key) {
     if (root == nullptr) {
         size_++;
-        root = std::make_unique<Node<T> >(key);
+        root = this->makeNode(key);
         return;
     }
 
@@ -230,7 +395,7 @@ void AVLTree<T>::insert(std::unique_ptr<Node<T> > &root, const T &key) {
 }
 
 template<typename T>
-void AVLTree<T>::inOrderIntoVector(const std::unique_ptr<Node<T> > &root, std::vector<T> &_v) const {
+void AVLTree<T>::inOrderIntoVector(const NodePtr<T> &root, std::vector<T> &_v) const {
     if (root == nullptr) {
         return;
     }
@@ -257,7 +422,7 @@ void AVLTree<T>::inorder() const {
 }
 
 template<typename T>
-void AVLTree<T>::inorder(const std::unique_ptr<Node<T> > &root) {
+void AVLTree<T>::inorder(const NodePtr<T> &root) {
     if (root == nullptr) {
         return;
     }
@@ -271,7 +436,7 @@ void AVLTree<T>::inorder(const std::unique_ptr<Node<T> > &root) {
 }
 
 template<typename T>
-std::unique_ptr<Node<T> > &AVLTree<T>::findLeftMost(std::unique_ptr<Node<T> > &node) {
+NodePtr<T> &AVLTree<T>::findLeftMost(NodePtr<T> &node) {
     if (!node) {
         throw std::invalid_argument("Cannot find leftmost of a null subtree");
     }
@@ -284,7 +449,7 @@ std::unique_ptr<Node<T> > &AVLTree<T>::findLeftMost(std::unique_ptr<Node<T> > &n
 }
 
 template<typename T>
-const std::unique_ptr<Node<T> > &AVLTree<T>::findLeftMost(const std::unique_ptr<Node<T> > &node) {
+const NodePtr<T> &AVLTree<T>::findLeftMost(const NodePtr<T> &node) {
     if (!node) {
         throw std::invalid_argument("Cannot find leftmost of a null subtree");
     }
@@ -297,7 +462,7 @@ const std::unique_ptr<Node<T> > &AVLTree<T>::findLeftMost(const std::unique_ptr<
 }
 
 template<typename T>
-std::unique_ptr<Node<T> > &AVLTree<T>::findRightMost(std::unique_ptr<Node<T> > &node) {
+NodePtr<T> &AVLTree<T>::findRightMost(NodePtr<T> &node) {
     if (!node) {
         throw std::invalid_argument("Cannot find rightmost of a null subtree");
     }
@@ -310,7 +475,7 @@ std::unique_ptr<Node<T> > &AVLTree<T>::findRightMost(std::unique_ptr<Node<T> > &
 }
 
 template<typename T>
-const std::unique_ptr<Node<T> > &AVLTree<T>::findRightMost(const std::unique_ptr<Node<T> > &node) {
+const NodePtr<T> &AVLTree<T>::findRightMost(const NodePtr<T> &node) {
     if (!node) {
         throw std::invalid_argument("Cannot find rightmost of a null subtree");
     }
@@ -328,7 +493,7 @@ void AVLTree<T>::printTree() const {
 }
 
 template<typename T>
-std::unique_ptr<Node<T> > &AVLTree<T>::findNodeRef(std::unique_ptr<Node<T> > &root, const T &key) {
+NodePtr<T> &AVLTree<T>::findNodeRef(NodePtr<T> &root, const T &key) {
     if (root == nullptr || root->key == key) {
         return root;
     }
@@ -346,7 +511,7 @@ Node<T> *AVLTree<T>::search(const T &key) const {
 }
 
 template<typename T>
-Node<T> *AVLTree<T>::search(const std::unique_ptr<Node<T> > &root, const T &key) {
+Node<T> *AVLTree<T>::search(const NodePtr<T> &root, const T &key) {
     if (root == nullptr || root->key == key) {
         return root.get();
     }
@@ -0,0 +1,308 @@
+//
+// Created by frostzt on 10/17/2026.
+//
+
+#ifndef ENIGMA_DB_SKIPLIST_HPP
+#define ENIGMA_DB_SKIPLIST_HPP
+
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <functional>
+#include <new>
+#include <thread>
+#include <type_traits>
+
+#include "lib/abstract/arena.hpp"
+
+/**
+ * Lock-free skiplist supporting concurrent inserters and wait-free readers.
+ *
+ * Nodes are linked with CAS on every level and are never unlinked, so readers can walk the list
+ * without any synchronisation beyond acquire loads. Nodes are carved out of the Arena passed in and
+ * are released together with it, which matches the MemTable lifecycle (append-only, dropped after flush).
+ *
+ * Keys that compare equal are all kept; callers that need "last write wins" should fold a version
+ * (e.g. a timestamp) into the comparator so that the newest version sorts first.
+ */
+template<typename T, typename Compare = std::less<T> >
+class ConcurrentSkipList {
+public:
+    static constexpr int kMaxHeight = 12;
+    static constexpr uint32_t kBranching = 4;
+
+    struct Node {
+        T key;
+        const int height;
+
+        Node(const T &k, const int h): key(k), height(h) {
+        }
+
+        [[nodiscard]] Node *next(const int level) const {
+            assert(level < this->height);
+            return this->next_[level].load(std::memory_order_acquire);
+        }
+
+        void setNextRelaxed(const int level, Node *node) {
+            this->next_[level].store(node, std::memory_order_relaxed);
+        }
+
+        bool casNext(const int level, Node *expected, Node *node) {
+            return this->next_[level].compare_exchange_strong(expected, node, std::memory_order_release,
+                                                              std::memory_order_relaxed);
+        }
+
+        // Over-allocated to `height` slots by newNode()
+        std::atomic<Node *> next_[1];
+    };
+
+    /**
+     * Cursor over the list. The cursor is valid as long as the list is alive, inserts racing with
+     * iteration may or may not be observed. Stepping backwards costs a search since nodes only link
+     * forward.
+     */
+    class Iterator {
+    private:
+        const ConcurrentSkipList *list_;
+        Node *node_;
+
+    public:
+        explicit Iterator(const ConcurrentSkipList *list): list_(list), node_(nullptr) {
+        }
+
+        [[nodiscard]] bool valid() const { return this->node_ != nullptr; }
+
+        [[nodiscard]] const T &key() const {
+            assert(valid());
+            return this->node_->key;
+        }
+
+        void next() {
+            assert(valid());
+            this->node_ = this->node_->next(0);
+        }
+
+        void prev() {
+            assert(valid());
+            this->node_ = this->list_->findLessThan(this->node_->key);
+        }
+
+        void seekToFirst() { this->node_ = this->list_->head_->next(0); }
+
+        void seekToLast() { this->node_ = this->list_->findLast(); }
+
+        void seek(const T &target) { this->node_ = this->list_->findGreaterOrEqual(target); }
+
+        /** Positions at the last node whose key is less than `target` */
+        void seekBefore(const T &target) { this->node_ = this->list_->findLessThan(target); }
+    };
+
+    explicit ConcurrentSkipList(Arena &arena, Compare cmp = Compare{}): compare_(std::move(cmp)),
+                                                                        arena_(arena),
+                                                                        head_(newNode(T{}, kMaxHeight)),
+                                                                        maxHeight_(1) {
+        for (int i = 0; i < kMaxHeight; ++i) {
+            this->head_->setNextRelaxed(i, nullptr);
+        }
+    }
+
+    ~ConcurrentSkipList() {
+        // Memory belongs to the arena; only non-trivial keys need their destructors run
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            Node *node = this->head_;
+            while (node != nullptr) {
+                Node *next = node->next_[0].load(std::memory_order_relaxed);
+                node->~Node();
+                node = next;
+            }
+        }
+    }
+
+    ConcurrentSkipList(const ConcurrentSkipList &) = delete;
+
+    ConcurrentSkipList &operator=(const ConcurrentSkipList &) = delete;
+
+    /**
+     * Inserts a key into the list. Safe to call from any number of threads concurrently with other
+     * inserts and with readers.
+     *
+     * @return The linked node, its successor tells callers what the key landed in front of.
+     */
+    Node *insert(const T &key);
+
+    /**
+     * Returns the first node whose key is not less than `key`, or nullptr if there is none.
+     */
+    [[nodiscard]] Node *findGreaterOrEqual(const T &key) const;
+
+    /**
+     * Returns the last node whose key is less than `key`, or nullptr if there is none.
+     */
+    [[nodiscard]] Node *findLessThan(const T &key) const;
+
+    /**
+     * Returns the last node in the list, or nullptr if the list is empty.
+     */
+    [[nodiscard]] Node *findLast() const;
+
+    [[nodiscard]] bool contains(const T &key) const {
+        const Node *node = findGreaterOrEqual(key);
+        return node != nullptr && !this->compare_(key, node->key);
+    }
+
+    [[nodiscard]] Iterator iterator() const { return Iterator(this); }
+
+private:
+    Compare compare_;
+    Arena &arena_;
+    Node *const head_;
+    std::atomic<int> maxHeight_;
+
+    Node *newNode(const T &key, const int height) {
+        static_assert(alignof(Node) <= Arena::kAlignment);
+
+        const size_t bytes = sizeof(Node) + sizeof(std::atomic<Node *>) * (height - 1);
+        Node *node = new(this->arena_.allocate(bytes)) Node(key, height);
+        for (int i = 1; i < height; ++i) {
+            new(&node->next_[i]) std::atomic<Node *>(nullptr);
+        }
+
+        return node;
+    }
+
+    static int randomHeight();
+
+    [[nodiscard]] bool keyIsAfterNode(const T &key, const Node *node) const {
+        return node != nullptr && this->compare_(node->key, key);
+    }
+
+    /**
+     * Walks forward on `level` starting at `before` until the insertion point of `key` is found.
+     * On return `key` belongs between `*outPrev` and `*outNext`.
+     */
+    void findSpliceForLevel(const T &key, Node *before, int level, Node **outPrev, Node **outNext) const;
+};
+
+template<typename T, typename Compare>
+int ConcurrentSkipList<T, Compare>::randomHeight() {
+    // xorshift32 seeded per thread; plenty for picking tower heights
+    thread_local uint32_t state = static_cast<uint32_t>(std::hash<std::thread::id>{}(std::this_thread::get_id())) |
+                                  1u;
+
+    int height = 1;
+    while (height < kMaxHeight) {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        if (state % kBranching != 0) break;
+        height++;
+    }
+
+    return height;
+}
+
+template<typename T, typename Compare>
+void ConcurrentSkipList<T, Compare>::findSpliceForLevel(const T &key, Node *before, const int level, Node **outPrev,
+                                                        Node **outNext) const {
+    while (true) {
+        Node *next = before->next(level);
+        if (!keyIsAfterNode(key, next)) {
+            *outPrev = before;
+            *outNext = next;
+            return;
+        }
+
+        before = next;
+    }
+}
+
+template<typename T, typename Compare>
+typename ConcurrentSkipList<T, Compare>::Node *ConcurrentSkipList<T, Compare>::findGreaterOrEqual(const T &key) const {
+    Node *node = this->head_;
+    int level = this->maxHeight_.load(std::memory_order_relaxed) - 1;
+
+    while (true) {
+        Node *next = node->next(level);
+        if (keyIsAfterNode(key, next)) {
+            node = next;
+            continue;
+        }
+
+        if (level == 0) return next;
+        level--;
+    }
+}
+
+template<typename T, typename Compare>
+typename ConcurrentSkipList<T, Compare>::Node *ConcurrentSkipList<T, Compare>::findLessThan(const T &key) const {
+    Node *node = this->head_;
+    int level = this->maxHeight_.load(std::memory_order_relaxed) - 1;
+
+    while (true) {
+        Node *next = node->next(level);
+        if (keyIsAfterNode(key, next)) {
+            node = next;
+            continue;
+        }
+
+        if (level == 0) return node == this->head_ ? nullptr : node;
+        level--;
+    }
+}
+
+template<typename T, typename Compare>
+typename ConcurrentSkipList<T, Compare>::Node *ConcurrentSkipList<T, Compare>::findLast() const {
+    Node *node = this->head_;
+    int level = this->maxHeight_.load(std::memory_order_relaxed) - 1;
+
+    while (true) {
+        if (Node *next = node->next(level); next != nullptr) {
+            node = next;
+            continue;
+        }
+
+        if (level == 0) return node == this->head_ ? nullptr : node;
+        level--;
+    }
+}
+
+template<typename T, typename Compare>
+typename ConcurrentSkipList<T, Compare>::Node *ConcurrentSkipList<T, Compare>::insert(const T &key) {
+    const int height = randomHeight();
+    Node *node = newNode(key, height);
+
+    // Publish the new max height first so that concurrent searches start high enough
+    int maxHeight = this->maxHeight_.load(std::memory_order_relaxed);
+    while (height > maxHeight) {
+        if (this->maxHeight_.compare_exchange_weak(maxHeight, height, std::memory_order_relaxed)) {
+            maxHeight = height;
+            break;
+        }
+    }
+
+    Node *prev[kMaxHeight];
+    Node *next[kMaxHeight];
+
+    // Top-down search; every level below reuses the predecessor found on the level above
+    Node *before = this->head_;
+    for (int level = maxHeight - 1; level >= 0; --level) {
+        findSpliceForLevel(key, before, level, &prev[level], &next[level]);
+        before = prev[level];
+    }
+
+    // Link bottom-up; level 0 makes the node visible, higher levels only speed up searches
+    for (int level = 0; level < height; ++level) {
+        while (true) {
+            node->setNextRelaxed(level, next[level]);
+            if (prev[level]->casNext(level, next[level], node)) break;
+
+            // Lost the race against another inserter; nodes are never removed so prev is still a
+            // valid starting point for re-computing the splice on this level
+            findSpliceForLevel(key, prev[level], level, &prev[level], &next[level]);
+        }
+    }
+
+    return node;
+}
+
+#endif //ENIGMA_DB_SKIPLIST_HPP
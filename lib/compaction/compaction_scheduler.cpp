@@ -0,0 +1,733 @@
+//
+// Created by frostzt on 10/17/2026.
+//
+
+#include "compaction_scheduler.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <exception>
+#include <filesystem>
+#include <stdexcept>
+
+#include "lib/compaction/table_merging_iterator.hpp"
+#include "spdlog/spdlog.h"
+
+namespace compaction {
+    namespace {
+        /** Written bytes a compaction accumulates before asking the rate limiter for them */
+        constexpr uint64_t kRateLimitChunk = 64_KB;
+
+        int compareKeys(const std::string_view lhs, const std::string_view rhs) {
+            return core::Key::compareOrdered(lhs, rhs);
+        }
+
+        bool overlaps(const TableFile &file, const std::string_view smallest, const std::string_view largest) {
+            return compareKeys(file.props.largestKey, smallest) >= 0 && compareKeys(file.props.smallestKey, largest) <= 0;
+        }
+
+        /** First table of a level sorted by key whose largest key is not less than `key` */
+        auto findFile(const std::vector<std::shared_ptr<TableFile> > &files, const std::string_view key) {
+            return std::lower_bound(files.begin(), files.end(), key,
+                                    [](const std::shared_ptr<TableFile> &file, const std::string_view target) {
+                                        return compareKeys(file->props.largestKey, target) < 0;
+                                    });
+        }
+
+        /** Whether any of the key-sorted levels in `levels` has a table whose range covers `key` */
+        bool mayExistIn(const std::vector<std::vector<std::shared_ptr<TableFile> > > &levels,
+                        const std::string_view key) {
+            for (const auto &files: levels) {
+                const auto it = findFile(files, key);
+                if (it != files.end() && compareKeys((*it)->props.smallestKey, key) <= 0) return true;
+            }
+
+            return false;
+        }
+    } // namespace
+
+    CompactionScheduler::CompactionScheduler(std::shared_ptr<io_engine::IoEngine> engine, std::string dir,
+                                             CompactionOptions options, std::shared_ptr<sstable::BlockCache> cache)
+        : engine_(std::move(engine)), dir_(std::move(dir)), options_(std::move(options)), cache_(std::move(cache)),
+          limiter_(this->options_.rateLimitBytesPerSecond),
+          versions_(this->engine_, this->dir_, std::max<size_t>(this->options_.levels, 2),
+                    [this](const uint64_t number) { return this->openTable(number); }) {
+        this->options_.levels = std::max<size_t>(this->options_.levels, 2);
+        this->options_.l0CompactionTrigger = std::max<size_t>(this->options_.l0CompactionTrigger, 1);
+        this->options_.l0StopWritesTrigger = std::max(this->options_.l0StopWritesTrigger,
+                                                      this->options_.l0CompactionTrigger);
+        this->options_.levelSizeMultiplier = std::max<size_t>(this->options_.levelSizeMultiplier, 2);
+        this->options_.tieredMinMergeWidth = std::max<size_t>(this->options_.tieredMinMergeWidth, 2);
+        this->options_.tieredMaxMergeWidth = std::max(this->options_.tieredMaxMergeWidth,
+                                                      this->options_.tieredMinMergeWidth);
+
+        this->versions_.recover();
+    }
+
+    CompactionScheduler::~CompactionScheduler() {
+        this->stop();
+    }
+
+    void CompactionScheduler::start() {
+        std::lock_guard lock(this->mutex_);
+        if (this->running_ || this->options_.backgroundThreads == 0) return;
+
+        this->running_ = true;
+        for (size_t i = 0; i < this->options_.backgroundThreads; ++i) {
+            this->threads_.emplace_back([this] { this->backgroundLoop(); });
+        }
+    }
+
+    void CompactionScheduler::stop() {
+        {
+            std::lock_guard lock(this->mutex_);
+            if (!this->running_) return;
+            this->running_ = false;
+        }
+
+        this->cv_.notify_all();
+        for (auto &thread: this->threads_) thread.join();
+        this->threads_.clear();
+    }
+
+    void CompactionScheduler::backgroundLoop() {
+        std::unique_lock lock(this->mutex_);
+        while (this->running_) {
+            if (!this->backgroundError_.empty() || !this->runOne(lock)) this->cv_.wait(lock);
+        }
+    }
+
+    uint64_t CompactionScheduler::flush(const memtable::MemTable &table) {
+        if (table.size() == 0) return 0;
+
+        {
+            std::unique_lock lock(this->mutex_);
+            if (this->levels()[0].size() >= this->options_.l0StopWritesTrigger) {
+                const auto start = std::chrono::steady_clock::now();
+                while (this->levels()[0].size() >= this->options_.l0StopWritesTrigger &&
+                       this->backgroundError_.empty()) {
+                    if (this->running_) {
+                        this->cv_.wait(lock);
+                    } else if (!this->runOne(lock)) {
+                        break;
+                    }
+                }
+
+                this->stats_.stalls++;
+                this->stats_.stallNanos += std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now() - start).count();
+            }
+
+            if (!this->backgroundError_.empty()) {
+                throw std::runtime_error("COMPACTION: background compaction failed: " + this->backgroundError_);
+            }
+        }
+
+        const uint64_t number = this->versions_.newFileNumber();
+        sstable::SSTableWriter::writeMemTable(this->engine_, this->dir_, sstable::tableFileName(number), table,
+                                              this->options_.table);
+        auto file = this->openTable(number);
+        file->newestFlush = number;
+
+        {
+            std::lock_guard lock(this->mutex_);
+
+            VersionEdit edit;
+            edit.addFile(0, number, number);
+            try {
+                this->versions_.logAndApply(std::move(edit), {file});
+            } catch (const std::exception &) {
+                // The MANIFEST may still list the table if the failure left that open
+                if (!this->versions_.failed()) this->removeTableFile(number);
+                throw;
+            }
+            this->deleteObsoleteFiles();
+
+            this->stats_.flushes++;
+            this->stats_.bytesFlushed += file->props.fileSize;
+        }
+
+        this->cv_.notify_all();
+        return number;
+    }
+
+    size_t CompactionScheduler::flushFrozen(memtable::MemTableManager &memTables,
+                                            const std::function<void(const memtable::MemTable &)> &flushed) {
+        size_t count = 0;
+        while (const auto oldest = memTables.oldestFrozen()) {
+            this->flush(*oldest);
+            memTables.flushOldestFrozen();
+            if (flushed) flushed(*oldest);
+            ++count;
+        }
+
+        return count;
+    }
+
+    bool CompactionScheduler::compactOnce() {
+        std::unique_lock lock(this->mutex_);
+        if (!this->backgroundError_.empty()) return false;
+
+        return this->runOne(lock);
+    }
+
+    void CompactionScheduler::waitForIdle() {
+        std::unique_lock lock(this->mutex_);
+        while (this->backgroundError_.empty()) {
+            if (this->activeCompactions_ == 0 && !this->needsCompaction()) return;
+
+            if (this->running_) {
+                this->cv_.wait(lock);
+            } else if (!this->runOne(lock)) {
+                // Whatever is left is blocked on a compaction another caller is running
+                if (this->activeCompactions_ == 0) return;
+                this->cv_.wait(lock);
+            }
+        }
+    }
+
+    bool CompactionScheduler::runOne(std::unique_lock<std::mutex> &lock) {
+        auto compaction = this->pickCompaction();
+        if (!compaction) return false;
+
+        ++this->activeCompactions_;
+        lock.unlock();
+
+        std::string error;
+        try {
+            this->execute(*compaction);
+        } catch (const std::exception &e) {
+            error = e.what();
+        }
+
+        lock.lock();
+        if (error.empty()) {
+            try {
+                this->install(*compaction);
+            } catch (const std::exception &e) {
+                error = e.what();
+            }
+        }
+        if (!error.empty()) this->abandon(*compaction, error);
+
+        // The inputs only become obsolete once the compaction lets go of them
+        compaction.reset();
+        this->deleteObsoleteFiles();
+
+        --this->activeCompactions_;
+        this->cv_.notify_all();
+        return true;
+    }
+
+    double CompactionScheduler::levelScore(const size_t level, const bool includeBusy) const {
+        // The last level has nowhere to go
+        if (level + 1 >= this->levels().size()) return 0.0;
+
+        const auto &files = this->levels()[level];
+        if (level == 0) {
+            // L0 tables overlap, so only one L0 compaction may run at a time
+            if (!includeBusy && std::any_of(files.begin(), files.end(), [](const auto &f) { return f->beingCompacted; })) {
+                return 0.0;
+            }
+
+            const double score = static_cast<double>(files.size()) /
+                                 static_cast<double>(this->options_.l0CompactionTrigger);
+            if (this->options_.style != CompactionStyle::Tiered) return score;
+
+            return std::max(score, this->sizeAmplificationPercent() /
+                                   static_cast<double>(this->options_.tieredMaxSizeAmplificationPercent));
+        }
+
+        uint64_t bytes = 0;
+        for (const auto &file: files) {
+            if (includeBusy || !file->beingCompacted) bytes += file->props.fileSize;
+        }
+
+        return static_cast<double>(bytes) / static_cast<double>(this->maxBytesForLevel(level));
+    }
+
+    bool CompactionScheduler::needsCompaction() const {
+        for (size_t level = 0; level < this->levels().size(); ++level) {
+            if (this->levelScore(level, true) >= 1.0) return true;
+        }
+
+        return false;
+    }
+
+    std::unique_ptr<CompactionScheduler::Compaction> CompactionScheduler::pickCompaction() {
+        std::vector<std::pair<double, size_t> > candidates;
+        for (size_t level = 0; level < this->levels().size(); ++level) {
+            const double score = this->levelScore(level, false);
+            if (score >= 1.0) candidates.emplace_back(score, level);
+        }
+
+        std::sort(candidates.begin(), candidates.end(), [](const auto &lhs, const auto &rhs) {
+            return lhs.first > rhs.first;
+        });
+
+        for (const auto &[score, level]: candidates) {
+            std::unique_ptr<Compaction> compaction;
+            if (level > 0) {
+                compaction = this->setupLevel(level);
+            } else if (this->options_.style == CompactionStyle::Tiered) {
+                compaction = this->setupTiered();
+            } else {
+                compaction = this->setupLevel0();
+            }
+
+            if (compaction) return compaction;
+        }
+
+        return nullptr;
+    }
+
+    std::unique_ptr<CompactionScheduler::Compaction> CompactionScheduler::setupLevel0() {
+        auto compaction = std::make_unique<Compaction>();
+        compaction->level = 0;
+        compaction->outputLevel = 1;
+        compaction->inputs = this->levels()[0];
+
+        if (!this->expand(*compaction)) return nullptr;
+        return compaction;
+    }
+
+    std::unique_ptr<CompactionScheduler::Compaction> CompactionScheduler::setupLevel(const size_t level) {
+        const auto &files = this->levels()[level];
+        if (files.empty()) return nullptr;
+
+        // Resume after the table compacted last time, wrapping around at the end of the level
+        size_t start = 0;
+        if (const auto &pointer = this->versions_.compactPointer(level); !pointer.empty()) {
+            while (start < files.size() && compareKeys(files[start]->props.smallestKey, pointer) <= 0) ++start;
+            if (start == files.size()) start = 0;
+        }
+
+        for (size_t i = 0; i < files.size(); ++i) {
+            const auto &file = files[(start + i) % files.size()];
+            if (file->beingCompacted) continue;
+
+            auto compaction = std::make_unique<Compaction>();
+            compaction->level = level;
+            compaction->outputLevel = level + 1;
+            compaction->inputs = {file};
+            if (this->expand(*compaction)) return compaction;
+        }
+
+        return nullptr;
+    }
+
+    std::unique_ptr<CompactionScheduler::Compaction> CompactionScheduler::setupTiered() {
+        // Runs are kept oldest first, merges take a contiguous stretch so the result keeps its place
+        const auto &runs = this->levels()[0];
+        if (runs.size() < 2) return nullptr;
+
+        size_t first = 0;
+        size_t last = 0;
+        if (this->sizeAmplificationPercent() >= static_cast<double>(this->options_.tieredMaxSizeAmplificationPercent)) {
+            last = runs.size();
+        } else {
+            // Starting from the newest run, pull in older runs while each is not much larger than the
+            // ones already picked together
+            for (size_t newest = runs.size(); newest-- > 0 && last == 0;) {
+                uint64_t total = runs[newest]->props.fileSize;
+                size_t oldest = newest;
+                while (oldest > 0 && newest - oldest + 1 < this->options_.tieredMaxMergeWidth) {
+                    const uint64_t next = runs[oldest - 1]->props.fileSize;
+                    if (next * 100 > total * (100 + this->options_.tieredSizeRatioPercent)) break;
+                    total += next;
+                    --oldest;
+                }
+
+                if (newest - oldest + 1 >= this->options_.tieredMinMergeWidth) {
+                    first = oldest;
+                    last = newest + 1;
+                }
+            }
+
+            // No similar sizes but too many runs, merge the newest ones to get back under the trigger
+            if (last == 0) {
+                if (runs.size() < this->options_.l0CompactionTrigger) return nullptr;
+
+                const size_t width = std::max(this->options_.tieredMinMergeWidth,
+                                              runs.size() - this->options_.l0CompactionTrigger + 2);
+                last = runs.size();
+                first = last - std::min(width, runs.size());
+            }
+        }
+
+        auto compaction = std::make_unique<Compaction>();
+        compaction->level = 0;
+        compaction->outputLevel = 0;
+        compaction->inputs.assign(runs.begin() + static_cast<std::ptrdiff_t>(first),
+                                  runs.begin() + static_cast<std::ptrdiff_t>(last));
+
+        // Every older run may still hold a version a tombstone hides
+        for (size_t i = 0; i < first; ++i) compaction->below.push_back({runs[i]});
+
+        for (const auto &file: compaction->inputs) file->beingCompacted = true;
+        return compaction;
+    }
+
+    double CompactionScheduler::sizeAmplificationPercent() const {
+        const auto &runs = this->levels()[0];
+        if (runs.size() < 2) return 0.0;
+
+        uint64_t newer = 0;
+        for (size_t i = 1; i < runs.size(); ++i) newer += runs[i]->props.fileSize;
+        return 100.0 * static_cast<double>(newer) / static_cast<double>(std::max<uint64_t>(runs[0]->props.fileSize, 1));
+    }
+
+    bool CompactionScheduler::expand(Compaction &compaction) {
+        std::string_view smallest = compaction.inputs.front()->props.smallestKey;
+        std::string_view largest = compaction.inputs.front()->props.largestKey;
+        for (const auto &file: compaction.inputs) {
+            if (compareKeys(file->props.smallestKey, smallest) < 0) smallest = file->props.smallestKey;
+            if (compareKeys(file->props.largestKey, largest) > 0) largest = file->props.largestKey;
+        }
+
+        for (const auto &file: this->levels()[compaction.outputLevel]) {
+            if (!overlaps(*file, smallest, largest)) continue;
+            if (file->beingCompacted) return false;
+            compaction.overlaps.push_back(file);
+        }
+
+        // Tables of the output level that overlap the inputs are contiguous, widen the range to them
+        if (!compaction.overlaps.empty()) {
+            if (compareKeys(compaction.overlaps.front()->props.smallestKey, smallest) < 0) {
+                smallest = compaction.overlaps.front()->props.smallestKey;
+            }
+            if (compareKeys(compaction.overlaps.back()->props.largestKey, largest) > 0) {
+                largest = compaction.overlaps.back()->props.largestKey;
+            }
+        }
+
+        for (size_t level = compaction.outputLevel + 1; level < this->levels().size(); ++level) {
+            auto &below = compaction.below.emplace_back();
+            for (const auto &file: this->levels()[level]) {
+                if (overlaps(*file, smallest, largest)) below.push_back(file);
+            }
+        }
+
+        compaction.trivialMove = compaction.inputs.size() == 1 && compaction.overlaps.empty();
+
+        for (const auto &file: compaction.inputs) file->beingCompacted = true;
+        for (const auto &file: compaction.overlaps) file->beingCompacted = true;
+        return true;
+    }
+
+    void CompactionScheduler::execute(Compaction &compaction) {
+        if (compaction.trivialMove) return;
+
+        for (const auto &file: compaction.inputs) compaction.bytesRead += file->props.fileSize;
+        for (const auto &file: compaction.overlaps) compaction.bytesRead += file->props.fileSize;
+
+        const auto boundaries = this->subcompactionBoundaries(compaction);
+        std::vector<Subcompaction> subs(boundaries.size() + 1);
+        for (size_t i = 0; i < boundaries.size(); ++i) {
+            subs[i].upper = boundaries[i];
+            subs[i + 1].lower = boundaries[i];
+        }
+
+        std::vector<std::exception_ptr> errors(subs.size());
+        const auto run = [&](const size_t i) {
+            try {
+                this->executeRange(compaction, subs[i]);
+            } catch (...) {
+                errors[i] = std::current_exception();
+            }
+        };
+
+        // The calling thread takes the first range itself
+        std::vector<std::thread> workers;
+        for (size_t i = 1; i < subs.size(); ++i) workers.emplace_back(run, i);
+        run(0);
+        for (auto &worker: workers) worker.join();
+
+        // Collected even on failure so abandon() removes whatever was written
+        for (auto &sub: subs) {
+            compaction.outputs.insert(compaction.outputs.end(), sub.outputs.begin(), sub.outputs.end());
+            compaction.bytesWritten += sub.bytesWritten;
+            compaction.shadowedDropped += sub.shadowedDropped;
+            compaction.tombstonesDropped += sub.tombstonesDropped;
+        }
+        compaction.subcompactions = subs.size();
+
+        for (const auto &error: errors) {
+            if (error) std::rethrow_exception(error);
+        }
+    }
+
+    std::vector<std::string> CompactionScheduler::subcompactionBoundaries(const Compaction &compaction) const {
+        // A tiered run is a single table, it cannot be split
+        if (compaction.outputLevel == 0 || this->options_.maxSubcompactions <= 1) return {};
+
+        const uint64_t pieces = std::min<uint64_t>(this->options_.maxSubcompactions,
+                                                   compaction.bytesRead /
+                                                   std::max<uint64_t>(this->options_.targetFileBytes, 1));
+        if (pieces <= 1) return {};
+
+        std::vector<sstable::SSTableReader::BlockBoundary> blocks;
+        for (const auto *files: {&compaction.inputs, &compaction.overlaps}) {
+            for (const auto &file: *files) {
+                auto boundaries = file->reader->blockBoundaries();
+                blocks.insert(blocks.end(), std::make_move_iterator(boundaries.begin()),
+                              std::make_move_iterator(boundaries.end()));
+            }
+        }
+
+        std::sort(blocks.begin(), blocks.end(), [](const auto &lhs, const auto &rhs) {
+            return compareKeys(lhs.lastKey, rhs.lastKey) < 0;
+        });
+
+        uint64_t total = 0;
+        for (const auto &block: blocks) total += block.size;
+
+        // Cut after every total / pieces bytes of blocks; the last block never starts a range of its own
+        std::vector<std::string> boundaries;
+        uint64_t seen = 0;
+        for (size_t i = 0; i + 1 < blocks.size() && boundaries.size() + 1 < pieces; ++i) {
+            seen += blocks[i].size;
+            if (seen * pieces < total * (boundaries.size() + 1)) continue;
+            if (!boundaries.empty() && compareKeys(blocks[i].lastKey, boundaries.back()) <= 0) continue;
+
+            boundaries.push_back(blocks[i].lastKey);
+        }
+
+        return boundaries;
+    }
+
+    void CompactionScheduler::executeRange(const Compaction &compaction, Subcompaction &sub) {
+        // Newest data first: L0 tables newest to oldest, one run each, then the output level
+        std::vector<SortedRun> runs;
+        if (compaction.level == 0) {
+            for (auto it = compaction.inputs.rbegin(); it != compaction.inputs.rend(); ++it) {
+                runs.push_back({(*it)->reader});
+            }
+        } else {
+            auto &run = runs.emplace_back();
+            for (const auto &file: compaction.inputs) run.push_back(file->reader);
+        }
+
+        if (!compaction.overlaps.empty()) {
+            auto &run = runs.emplace_back();
+            for (const auto &file: compaction.overlaps) run.push_back(file->reader);
+        }
+
+        std::unique_ptr<sstable::SSTableWriter> writer;
+        uint64_t number = 0;
+        uint64_t charged = 0;
+
+        const auto finishOutput = [&] {
+            const auto props = writer->finish();
+            writer.reset();
+
+            this->limiter_.request(props.fileSize - std::min(charged, props.fileSize));
+            charged = 0;
+
+            sub.outputs.push_back(this->openTable(number));
+            sub.bytesWritten += props.fileSize;
+        };
+
+        TableMergingIterator it(std::move(runs));
+        if (sub.lower.empty()) {
+            it.seekToFirst();
+        } else {
+            it.seek(sub.lower);
+        }
+
+        for (; it.valid(); it.next()) {
+            if (!sub.upper.empty() && compareKeys(it.key(), sub.upper) >= 0) break;
+
+            // Versions shadowed at the key past the range belong to the next one
+            sub.shadowedDropped = it.shadowed();
+
+            const auto value = it.value();
+
+            // The tombstone is the newest version here; once nothing deeper can hold the key it has
+            // nothing left to hide
+            if (it.entry().isTombstone() && !mayExistIn(compaction.below, it.key())) {
+                sub.tombstonesDropped++;
+                continue;
+            }
+
+            if (!writer) {
+                number = this->versions_.newFileNumber();
+                writer = std::make_unique<sstable::SSTableWriter>(this->engine_, this->dir_,
+                                                                  sstable::tableFileName(number), this->options_.table);
+            }
+
+            writer->add(it.key(), value);
+
+            const uint64_t size = writer->fileSize();
+            if (size - charged >= kRateLimitChunk) {
+                this->limiter_.request(size - charged);
+                charged = size;
+            }
+
+            if (size >= this->options_.targetFileBytes && this->options_.style != CompactionStyle::Tiered) {
+                finishOutput();
+            }
+        }
+
+        if (writer) finishOutput();
+    }
+
+    void CompactionScheduler::install(Compaction &compaction) {
+        // A moved table is deleted from its level and added to the next by the same edit
+        const FileList &added = compaction.trivialMove ? compaction.inputs : compaction.outputs;
+
+        // Outputs hold data as new as their newest input, which places a merged run among the others
+        uint64_t newestFlush = 0;
+        for (const auto &file: compaction.inputs) newestFlush = std::max(newestFlush, file->newestFlush);
+        for (const auto &file: compaction.overlaps) newestFlush = std::max(newestFlush, file->newestFlush);
+
+        VersionEdit edit;
+        for (const auto &file: compaction.inputs) edit.deleteFile(compaction.level, file->number);
+        for (const auto &file: compaction.overlaps) edit.deleteFile(compaction.outputLevel, file->number);
+        for (const auto &file: added) {
+            file->newestFlush = std::max(file->newestFlush, newestFlush);
+            edit.addFile(compaction.outputLevel, file->number, file->newestFlush);
+        }
+
+        if (compaction.level > 0) edit.setCompactPointer(compaction.level, compaction.inputs.back()->props.largestKey);
+
+        this->versions_.logAndApply(std::move(edit), added);
+
+        if (compaction.trivialMove) {
+            compaction.inputs.front()->beingCompacted = false;
+            compaction.outputs = compaction.inputs;
+        }
+
+        this->stats_.compactions++;
+        this->stats_.trivialMoves += compaction.trivialMove ? 1 : 0;
+        this->stats_.subcompactions += compaction.subcompactions > 1 ? compaction.subcompactions : 0;
+        this->stats_.bytesRead += compaction.bytesRead;
+        this->stats_.bytesWritten += compaction.bytesWritten;
+        this->stats_.shadowedDropped += compaction.shadowedDropped;
+        this->stats_.tombstonesDropped += compaction.tombstonesDropped;
+
+        spdlog::debug("COMPACTION: L{} -> L{} merged {} + {} tables ({} bytes) into {} tables ({} bytes) in {} ranges{}",
+                      compaction.level, compaction.outputLevel, compaction.inputs.size(), compaction.overlaps.size(),
+                      compaction.bytesRead, compaction.outputs.size(), compaction.bytesWritten,
+                      compaction.subcompactions, compaction.trivialMove ? ", moved" : "");
+    }
+
+    void CompactionScheduler::abandon(Compaction &compaction, const std::string &error) {
+        for (const auto &file: compaction.inputs) file->beingCompacted = false;
+        for (const auto &file: compaction.overlaps) file->beingCompacted = false;
+        if (!this->versions_.failed()) {
+            for (const auto &file: compaction.outputs) this->removeTableFile(file->number);
+        }
+
+        spdlog::error("COMPACTION: L{} -> L{} failed, compactions are suspended: {}", compaction.level,
+                      compaction.outputLevel, error);
+        if (this->backgroundError_.empty()) this->backgroundError_ = error;
+    }
+
+    std::optional<core::Entry> CompactionScheduler::get(const core::Key &key) const {
+        std::string value;
+        const auto entry = this->get(key, value);
+        if (!entry) return std::nullopt;
+
+        return entry->toEntry();
+    }
+
+    std::optional<core::EntryView> CompactionScheduler::get(const core::Key &key, std::string &value) const {
+        const std::string encoded = key.orderedBytes();
+
+        // The pinned version keeps its tables on disk however long the lookup takes
+        const auto version = this->current();
+
+        const auto lookup = [&](const TableFile &file) -> std::optional<core::EntryView> {
+            if (!file.reader->get(encoded, value)) return std::nullopt;
+
+            auto entry = core::EntryView::parse(value, false, file.reader->schemas());
+            if (!entry) throw std::runtime_error("COMPACTION: failed to decode entry of table " +
+                                                 sstable::tableFileName(file.number));
+            return entry;
+        };
+
+        const auto &levels = version->levels;
+        for (auto it = levels[0].rbegin(); it != levels[0].rend(); ++it) {
+            if (!overlaps(**it, encoded, encoded)) continue;
+            if (auto entry = lookup(**it)) return entry;
+        }
+
+        for (size_t level = 1; level < levels.size(); ++level) {
+            const auto &files = levels[level];
+            const auto it = findFile(files, encoded);
+            if (it == files.end() || compareKeys((*it)->props.smallestKey, encoded) > 0) continue;
+            if (auto entry = lookup(**it)) return entry;
+        }
+
+        return std::nullopt;
+    }
+
+    std::shared_ptr<const Version> CompactionScheduler::current() const {
+        std::lock_guard lock(this->mutex_);
+        return this->versions_.current();
+    }
+
+    size_t CompactionScheduler::filesAtLevel(const size_t level) const {
+        std::lock_guard lock(this->mutex_);
+        return level < this->levels().size() ? this->levels()[level].size() : 0;
+    }
+
+    uint64_t CompactionScheduler::bytesAtLevel(const size_t level) const {
+        std::lock_guard lock(this->mutex_);
+        if (level >= this->levels().size()) return 0;
+
+        uint64_t bytes = 0;
+        for (const auto &file: this->levels()[level]) bytes += file->props.fileSize;
+        return bytes;
+    }
+
+    size_t CompactionScheduler::sortedRuns() const {
+        std::lock_guard lock(this->mutex_);
+        size_t runs = this->levels()[0].size();
+        for (size_t level = 1; level < this->levels().size(); ++level) runs += this->levels()[level].empty() ? 0 : 1;
+        return runs;
+    }
+
+    uint64_t CompactionScheduler::maxBytesForLevel(const size_t level) const {
+        if (level == 0) return 0;
+
+        uint64_t bytes = this->options_.baseLevelBytes;
+        for (size_t i = 1; i < level; ++i) bytes *= this->options_.levelSizeMultiplier;
+        return bytes;
+    }
+
+    std::vector<std::shared_ptr<TableFile> > CompactionScheduler::levelFiles(const size_t level) const {
+        std::lock_guard lock(this->mutex_);
+        return level < this->levels().size() ? this->levels()[level] : FileList{};
+    }
+
+    CompactionScheduler::Stats CompactionScheduler::stats() const {
+        std::lock_guard lock(this->mutex_);
+        Stats stats = this->stats_;
+        stats.rateLimitedNanos = this->limiter_.waitNanos();
+        return stats;
+    }
+
+    std::shared_ptr<TableFile> CompactionScheduler::openTable(const uint64_t number) const {
+        auto file = std::make_shared<TableFile>();
+        file->number = number;
+        file->reader = std::make_shared<sstable::SSTableReader>(this->engine_, this->dir_,
+                                                                sstable::tableFileName(number), number, this->cache_,
+                                                                this->options_.table);
+        file->props = file->reader->properties();
+        return file;
+    }
+
+    void CompactionScheduler::deleteObsoleteFiles() {
+        for (const uint64_t number: this->versions_.takeObsoleteFiles()) this->removeTableFile(number);
+    }
+
+    void CompactionScheduler::removeTableFile(const uint64_t number) const {
+        if (this->cache_) this->cache_->eraseFile(number);
+
+        std::error_code ec;
+        std::filesystem::remove(std::filesystem::path(this->dir_) / sstable::tableFileName(number), ec);
+        if (ec) spdlog::warn("COMPACTION: failed to remove {}: {}", sstable::tableFileName(number), ec.message());
+    }
+} // namespace compaction
@@ -0,0 +1,395 @@
+//
+// Created by frostzt on 10/17/2026.
+//
+
+#ifndef ENIGMA_DB_COMPACTION_SCHEDULER_HPP
+#define ENIGMA_DB_COMPACTION_SCHEDULER_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "lib/compaction/rate_limiter.hpp"
+#include "lib/compaction/version_set.hpp"
+#include "lib/entry/entry.hpp"
+#include "lib/entry/entry_view.hpp"
+#include "lib/io/engine.hpp"
+#include "lib/memtable/memtable_manager.hpp"
+#include "lib/sstable/block_cache.hpp"
+#include "lib/sstable/sstable_reader.hpp"
+#include "lib/sstable/sstable_writer.hpp"
+#include "lib/utils/constants.hpp"
+
+namespace compaction {
+    /**
+     * @enum CompactionStyle
+     * @brief How flushed tables are merged over time.
+     */
+    enum class CompactionStyle : uint8_t {
+        /** Levels of growing size with disjoint tables, low read and space amplification */
+        Leveled,
+
+        /** Sorted runs of similar size merged together, low write amplification for write-heavy tables */
+        Tiered,
+    };
+
+    /**
+     * @struct CompactionOptions
+     * @brief Shape of the level tree and how hard background work may push the disk.
+     */
+    struct CompactionOptions {
+        CompactionStyle style = CompactionStyle::Leveled;
+
+        /** Number of levels including L0, the last one is never compacted further; unused when tiered */
+        size_t levels = 7;
+
+        /** L0 tables that trigger an L0 -> L1 compaction, or sorted runs that trigger a tiered merge */
+        size_t l0CompactionTrigger = 4;
+
+        /** L0 tables at which flushes stall until compaction catches up, at least l0CompactionTrigger */
+        size_t l0StopWritesTrigger = 12;
+
+        /** Target size of L1, every following level is levelSizeMultiplier times larger */
+        uint64_t baseLevelBytes = 64_MB;
+
+        size_t levelSizeMultiplier = 10;
+
+        /** Compaction outputs are cut once they reach this size; a tiered merge writes one table */
+        uint64_t targetFileBytes = 8_MB;
+
+        /**
+         * Tiered only: a run joins a merge of newer runs if it is at most this many percent larger than
+         * all of them together
+         */
+        size_t tieredSizeRatioPercent = 1;
+
+        /** Tiered only: fewest and most sorted runs merged at once, at least 2 */
+        size_t tieredMinMergeWidth = 2;
+        size_t tieredMaxMergeWidth = 16;
+
+        /**
+         * Tiered only: once every run but the oldest together exceed this many percent of the oldest,
+         * all runs are merged into one so obsolete versions do not pile up on disk
+         */
+        size_t tieredMaxSizeAmplificationPercent = 200;
+
+        /**
+         * Key ranges a single compaction into L1 or deeper may be split into, each merged on a thread of
+         * its own into its own tables. A compaction gets at most one range per targetFileBytes it reads;
+         * 1 keeps every compaction on one thread.
+         */
+        size_t maxSubcompactions = 1;
+
+        /** Compactions that may run at once, 0 only compacts on the calling thread */
+        size_t backgroundThreads = 2;
+
+        /** Bytes per second all compactions together may write, 0 for no limit */
+        uint64_t rateLimitBytesPerSecond = 0;
+
+        /** Options every flushed and compacted table is written and read with */
+        sstable::SSTableOptions table = sstable::SSTableOptions::defaults();
+    };
+
+    /**
+     * @class CompactionScheduler
+     * @brief Owns the SSTables of one directory and keeps them in a leveled or tiered LSM shape.
+     *
+     * Flushed MemTables land in L0, where tables may overlap. Once L0 holds l0CompactionTrigger tables
+     * they are merged with the overlapping part of L1; every deeper level holds tables with disjoint key
+     * ranges and is compacted one table at a time into the next once it outgrows its target size. The
+     * level with the highest size-to-target score goes first, and within a level tables are picked
+     * round robin by key so the whole range gets rewritten evenly.
+     *
+     * A compaction k-way merges its inputs, keeps only the newest version of each key, drops tombstones
+     * no deeper level can hold an older version for, and splits its output at targetFileBytes. A table
+     * that overlaps nothing in the next level is moved down without being rewritten. Compactions run on
+     * a pool of background threads, in parallel as long as their inputs do not overlap, and their writes
+     * go through a shared RateLimiter. Flushes stall while L0 is at l0StopWritesTrigger.
+     *
+     * A large compaction can also be split into up to maxSubcompactions subcompactions. The key range is
+     * cut at data block boundaries taken from the index blocks of the inputs so every piece reads about
+     * the same number of bytes; the pieces are merged in parallel and produce disjoint tables, which
+     * keeps a big L0 -> L1 compaction from holding up flushes on a single core.
+     *
+     * With CompactionStyle::Tiered every table is a sorted run of its own kept in L0, and the deeper
+     * levels stay empty. Once there are l0CompactionTrigger runs, the newest stretch of runs whose sizes
+     * are similar, each no more than tieredSizeRatioPercent larger than the newer ones together, is
+     * merged into a single run; a key is rewritten far less often than with leveling at the cost of more
+     * runs for a lookup to probe. When the runs on top of the oldest grow past
+     * tieredMaxSizeAmplificationPercent of it, everything is merged into one run.
+     *
+     * Every flush and compaction is installed as a VersionEdit through a VersionSet, so the level layout
+     * survives restarts in the directory's MANIFEST. Lookups pin the current Version; tables a compaction
+     * swapped out stay on disk until the last Version referring to them is gone.
+     */
+    class CompactionScheduler {
+    public:
+        struct Stats {
+            uint64_t flushes = 0;
+
+            /** Bytes of the tables written by flushes, the baseline for write amplification */
+            uint64_t bytesFlushed = 0;
+
+            uint64_t compactions = 0;
+
+            /** Compactions that moved a table down a level without rewriting it */
+            uint64_t trivialMoves = 0;
+
+            /** Key ranges merged by compactions that were split into more than one */
+            uint64_t subcompactions = 0;
+
+            uint64_t bytesRead = 0;
+            uint64_t bytesWritten = 0;
+
+            /** Older versions of a key discarded because a newer one was merged in */
+            uint64_t shadowedDropped = 0;
+
+            /** Tombstones discarded because no deeper level could hold the key */
+            uint64_t tombstonesDropped = 0;
+
+            /** Flushes that had to wait for L0 to drain, and how long they waited in total */
+            uint64_t stalls = 0;
+            uint64_t stallNanos = 0;
+
+            /** Time compactions spent sleeping in the rate limiter */
+            uint64_t rateLimitedNanos = 0;
+
+            /** Bytes written to tables by flushes and compactions per byte flushed */
+            [[nodiscard]] double writeAmplification() const {
+                if (this->bytesFlushed == 0) return 0.0;
+                return static_cast<double>(this->bytesFlushed + this->bytesWritten) /
+                       static_cast<double>(this->bytesFlushed);
+            }
+        };
+
+        /**
+         * Recovers the tables of `dir` from its MANIFEST, creating the directory if needed. Call start() to
+         * compact in the background.
+         *
+         * @param cache Block cache shared by the readers of every table, none when null.
+         * @throw std::runtime_error If the MANIFEST lists a table that cannot be opened or a new MANIFEST
+         *                           cannot be written.
+         */
+        CompactionScheduler(std::shared_ptr<io_engine::IoEngine> engine, std::string dir,
+                            CompactionOptions options = CompactionOptions{},
+                            std::shared_ptr<sstable::BlockCache> cache = nullptr);
+
+        ~CompactionScheduler();
+
+        CompactionScheduler(const CompactionScheduler &) = delete;
+
+        CompactionScheduler &operator=(const CompactionScheduler &) = delete;
+
+        /**
+         * Starts the background compaction threads. Has no effect if they are already running.
+         */
+        void start();
+
+        /**
+         * Stops the background threads once their current compactions are installed. Has no effect if
+         * they are not running.
+         */
+        void stop();
+
+        /**
+         * Writes `table` into a new L0 table. Stalls while L0 is at l0StopWritesTrigger; without
+         * background threads the stalled caller runs the compactions itself.
+         *
+         * @return Number of the new table, 0 if `table` was empty and nothing was written.
+         * @throw std::runtime_error If writing the table fails or a background compaction has failed.
+         */
+        uint64_t flush(const memtable::MemTable &table);
+
+        /**
+         * Flushes every frozen MemTable of `memTables`, oldest first. A table leaves the manager only
+         * once its SSTable is installed, so reads never miss its entries.
+         *
+         * @param flushed Called with every MemTable once its SSTable is durable and every older one's
+         *                is too, e.g. to truncate the WAL up to its MemTable::logPosition().
+         * @return Number of MemTables flushed.
+         */
+        size_t flushFrozen(memtable::MemTableManager &memTables,
+                           const std::function<void(const memtable::MemTable &)> &flushed = {});
+
+        /**
+         * Runs the most urgent compaction, if any, on the calling thread.
+         *
+         * @return Whether a compaction ran.
+         */
+        bool compactOnce();
+
+        /**
+         * Blocks until no level needs compacting and no compaction is running. Without background
+         * threads the compactions are run on the calling thread.
+         */
+        void waitForIdle();
+
+        /**
+         * Looks `key` up in L0 newest first and then level by level. Tombstones are returned like any
+         * other entry.
+         *
+         * @throw std::runtime_error If a block on the lookup path is corrupted.
+         */
+        [[nodiscard]] std::optional<core::Entry> get(const core::Key &key) const;
+
+        /**
+         * Same lookup, reading the entry in place instead of decoding it: the returned view points into
+         * `value`, which holds the serialized entry and must outlive it.
+         *
+         * @throw std::runtime_error If a block on the lookup path is corrupted.
+         */
+        [[nodiscard]] std::optional<core::EntryView> get(const core::Key &key, std::string &value) const;
+
+        [[nodiscard]] size_t filesAtLevel(size_t level) const;
+
+        [[nodiscard]] uint64_t bytesAtLevel(size_t level) const;
+
+        /**
+         * Tables a point lookup may have to probe in the worst case: every L0 table and one table per
+         * populated deeper level.
+         */
+        [[nodiscard]] size_t sortedRuns() const;
+
+        /** Target size of `level`, 0 for L0 which is sized by file count instead */
+        [[nodiscard]] uint64_t maxBytesForLevel(size_t level) const;
+
+        /**
+         * The live tables as of now. Holding on to it keeps every table in it readable and on disk.
+         */
+        [[nodiscard]] std::shared_ptr<const Version> current() const;
+
+        /** The live tables of `level`, L0 oldest first and every other level by key */
+        [[nodiscard]] std::vector<std::shared_ptr<TableFile> > levelFiles(size_t level) const;
+
+        [[nodiscard]] Stats stats() const;
+
+        [[nodiscard]] const CompactionOptions &options() const { return this->options_; }
+
+    private:
+        /** A key range of a compaction, merged into tables of its own */
+        struct Subcompaction {
+            /** Serialized primary keys bounding the range, inclusive and exclusive; empty is unbounded */
+            std::string lower;
+            std::string upper;
+
+            FileList outputs;
+
+            uint64_t bytesWritten = 0;
+            uint64_t shadowedDropped = 0;
+            uint64_t tombstonesDropped = 0;
+        };
+
+        /** One picked compaction, from choosing its inputs to installing its outputs */
+        struct Compaction {
+            size_t level = 0;
+            size_t outputLevel = 0;
+
+            /** Tables of `level` being compacted */
+            FileList inputs;
+
+            /** Tables of outputLevel overlapping the inputs, merged with them */
+            FileList overlaps;
+
+            /** Per level below outputLevel, the tables overlapping the compacted range, by key */
+            std::vector<FileList> below;
+
+            FileList outputs;
+
+            bool trivialMove = false;
+
+            /** Key ranges the merge was split into, one when it was not */
+            size_t subcompactions = 1;
+
+            uint64_t bytesRead = 0;
+            uint64_t bytesWritten = 0;
+            uint64_t shadowedDropped = 0;
+            uint64_t tombstonesDropped = 0;
+        };
+
+        std::shared_ptr<io_engine::IoEngine> engine_;
+        std::string dir_;
+        CompactionOptions options_;
+        std::shared_ptr<sstable::BlockCache> cache_;
+        RateLimiter limiter_;
+
+        /** Guards versions_ and the bookkeeping below */
+        mutable std::mutex mutex_;
+
+        /** Signalled whenever a compaction finishes, a flush lands or the threads are told to stop */
+        std::condition_variable cv_;
+
+        VersionSet versions_;
+
+        std::vector<std::thread> threads_;
+        bool running_{false};
+        size_t activeCompactions_{0};
+
+        /** First background failure; once set no further compaction is scheduled */
+        std::string backgroundError_;
+
+        Stats stats_;
+
+        /** How urgently `level` needs compacting, 1 or more means it does; ignores busy tables */
+        [[nodiscard]] double levelScore(size_t level, bool includeBusy) const;
+
+        [[nodiscard]] bool needsCompaction() const;
+
+        /** Picks the most urgent compaction whose tables are all free and marks them busy */
+        std::unique_ptr<Compaction> pickCompaction();
+
+        std::unique_ptr<Compaction> setupLevel0();
+
+        std::unique_ptr<Compaction> setupLevel(size_t level);
+
+        /** Picks the runs of a tiered merge, by size amplification first and then by size ratio */
+        std::unique_ptr<Compaction> setupTiered();
+
+        /** How far the runs on top of the oldest outgrew it, in percent of the oldest */
+        [[nodiscard]] double sizeAmplificationPercent() const;
+
+        /**
+         * Fills in the overlapping tables of the output and deeper levels and marks the inputs busy.
+         *
+         * @return false, leaving nothing marked, if an overlapping table is already being compacted.
+         */
+        bool expand(Compaction &compaction);
+
+        /** Merges the inputs into new tables, without holding the mutex */
+        void execute(Compaction &compaction);
+
+        /** Inner boundaries cutting the key range of `compaction` into pieces of about equal size */
+        [[nodiscard]] std::vector<std::string> subcompactionBoundaries(const Compaction &compaction) const;
+
+        /** Merges the part of the inputs inside the range of `sub` into its own tables */
+        void executeRange(const Compaction &compaction, Subcompaction &sub);
+
+        /** Swaps inputs for outputs in the level layout, mutex held */
+        void install(Compaction &compaction);
+
+        /** Releases the inputs of a failed compaction and removes its outputs, mutex held */
+        void abandon(Compaction &compaction, const std::string &error);
+
+        /** Picks, executes and installs one compaction; `lock` is released while it executes */
+        bool runOne(std::unique_lock<std::mutex> &lock);
+
+        void backgroundLoop();
+
+        [[nodiscard]] std::shared_ptr<TableFile> openTable(uint64_t number) const;
+
+        void removeTableFile(uint64_t number) const;
+
+        /** Removes the tables no Version refers to any more, mutex held */
+        void deleteObsoleteFiles();
+
+        /** Levels of the current Version, mutex held; valid until the next edit is applied */
+        [[nodiscard]] const std::vector<FileList> &levels() const { return this->versions_.current()->levels; }
+    };
+} // namespace compaction
+
+#endif //ENIGMA_DB_COMPACTION_SCHEDULER_HPP
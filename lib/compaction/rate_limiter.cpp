@@ -0,0 +1,38 @@
+//
+// Created by frostzt on 10/17/2026.
+//
+
+#include "rate_limiter.hpp"
+
+#include <thread>
+
+namespace compaction {
+    RateLimiter::RateLimiter(const uint64_t bytesPerSecond): bytesPerSecond_(bytesPerSecond) {
+    }
+
+    void RateLimiter::request(const uint64_t bytes) {
+        this->bytesRequested_.fetch_add(bytes, std::memory_order_relaxed);
+
+        const uint64_t rate = this->bytesPerSecond_.load(std::memory_order_relaxed);
+        if (rate == 0 || bytes == 0) return;
+
+        const auto cost = std::chrono::nanoseconds(static_cast<int64_t>(static_cast<double>(bytes) * 1e9 /
+                                                                        static_cast<double>(rate)));
+
+        Clock::time_point start;
+        const auto now = Clock::now();
+        {
+            std::lock_guard lock(this->mutex_);
+            if (this->available_ < now) this->available_ = now;
+
+            start = this->available_;
+            this->available_ += cost;
+        }
+
+        if (start <= now) return;
+
+        std::this_thread::sleep_until(start);
+        this->waitNanos_.fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - now).count(),
+                                   std::memory_order_relaxed);
+    }
+} // namespace compaction
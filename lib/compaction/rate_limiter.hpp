@@ -0,0 +1,63 @@
+//
+// Created by frostzt on 10/17/2026.
+//
+
+#ifndef ENIGMA_DB_RATE_LIMITER_HPP
+#define ENIGMA_DB_RATE_LIMITER_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+
+namespace compaction {
+    /**
+     * @class RateLimiter
+     * @brief Caps the bytes per second background work may write, shared by every compaction thread.
+     *
+     * Each request reserves the next `bytes / rate` of a virtual clock and sleeps until its reservation
+     * starts, so concurrent callers are served in arrival order and the combined rate never exceeds the
+     * limit. Unused time is not banked: a limiter that sat idle does not allow a burst afterwards.
+     */
+    class RateLimiter {
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        std::mutex mutex_;
+
+        /** Bytes per second, 0 disables limiting */
+        std::atomic<uint64_t> bytesPerSecond_;
+
+        /** Point in time at which the next request may go ahead */
+        Clock::time_point available_{};
+
+        std::atomic<uint64_t> bytesRequested_{0};
+        std::atomic<uint64_t> waitNanos_{0};
+
+    public:
+        /**
+         * @param bytesPerSecond Rate to enforce, 0 lets every request through immediately.
+         */
+        explicit RateLimiter(uint64_t bytesPerSecond);
+
+        RateLimiter(const RateLimiter &) = delete;
+
+        RateLimiter &operator=(const RateLimiter &) = delete;
+
+        /**
+         * Blocks until `bytes` more bytes may be written without going over the rate.
+         */
+        void request(uint64_t bytes);
+
+        void setBytesPerSecond(uint64_t bytesPerSecond) { this->bytesPerSecond_.store(bytesPerSecond); }
+
+        [[nodiscard]] uint64_t bytesPerSecond() const { return this->bytesPerSecond_.load(); }
+
+        [[nodiscard]] uint64_t bytesRequested() const { return this->bytesRequested_.load(); }
+
+        /** Time callers spent sleeping in request(), summed over all calls */
+        [[nodiscard]] uint64_t waitNanos() const { return this->waitNanos_.load(); }
+    };
+} // namespace compaction
+
+#endif //ENIGMA_DB_RATE_LIMITER_HPP
@@ -0,0 +1,163 @@
+//
+// Created by frostzt on 10/17/2026.
+//
+
+#include "table_merging_iterator.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <stdexcept>
+
+namespace compaction {
+    namespace {
+        const std::byte *asBytes(const std::string_view data) {
+            return reinterpret_cast<const std::byte *>(data.data());
+        }
+
+        uint64_t timestampOf(const std::string_view entry) {
+            return core::Entry::serializedTimestamp(asBytes(entry), entry.size());
+        }
+    } // namespace
+
+    void TableMergingIterator::Child::seekToFirst() {
+        this->table = 0;
+        this->it.reset();
+        if (this->tables.empty()) return;
+
+        this->it.emplace(this->tables.front()->newIterator());
+        this->it->seekToFirst();
+        this->skipExhaustedTables();
+    }
+
+    void TableMergingIterator::Child::seek(const std::string_view target) {
+        this->it.reset();
+
+        // Tables of a run are ordered by key with disjoint ranges
+        const auto table = std::lower_bound(this->tables.begin(), this->tables.end(), target,
+                                            [](const std::shared_ptr<sstable::SSTableReader> &reader,
+                                               const std::string_view key) {
+                                                return core::Key::compareOrdered(
+                                                           reader->properties().largestKey, key) < 0;
+                                            });
+        this->table = static_cast<size_t>(table - this->tables.begin());
+        if (table == this->tables.end()) return;
+
+        this->it.emplace((*table)->newIterator());
+        this->it->seek(target);
+        this->skipExhaustedTables();
+    }
+
+    void TableMergingIterator::Child::next() {
+        this->it->next();
+        this->skipExhaustedTables();
+    }
+
+    void TableMergingIterator::Child::skipExhaustedTables() {
+        while (this->it.has_value() && !this->it->valid()) {
+            if (++this->table >= this->tables.size()) {
+                this->it.reset();
+                return;
+            }
+
+            this->it.emplace(this->tables[this->table]->newIterator());
+            this->it->seekToFirst();
+        }
+    }
+
+    TableMergingIterator::TableMergingIterator(std::vector<SortedRun> runs) {
+        this->children_.reserve(runs.size());
+        for (auto &run: runs) this->children_.push_back(Child{std::move(run)});
+
+        this->heap_.reserve(this->children_.size());
+        this->atCurrent_.reserve(this->children_.size());
+    }
+
+    bool TableMergingIterator::greater(const size_t a, const size_t b) const {
+        const int cmp = core::Key::compareOrdered(this->children_[a].key(), this->children_[b].key());
+        if (cmp != 0) return cmp > 0;
+
+        return a > b;
+    }
+
+    void TableMergingIterator::push(const size_t child) {
+        this->heap_.push_back(child);
+        std::push_heap(this->heap_.begin(), this->heap_.end(),
+                       [this](const size_t a, const size_t b) { return this->greater(a, b); });
+    }
+
+    size_t TableMergingIterator::pop() {
+        std::pop_heap(this->heap_.begin(), this->heap_.end(),
+                      [this](const size_t a, const size_t b) { return this->greater(a, b); });
+        const size_t child = this->heap_.back();
+        this->heap_.pop_back();
+        return child;
+    }
+
+    void TableMergingIterator::settle() {
+        this->atCurrent_.clear();
+        this->current_ = -1;
+        if (this->heap_.empty()) return;
+
+        this->atCurrent_.push_back(this->pop());
+        const std::string &key = this->children_[this->atCurrent_.front()].key();
+        while (!this->heap_.empty() &&
+               core::Key::compareOrdered(this->children_[this->heap_.front()].key(), key) == 0) {
+            this->atCurrent_.push_back(this->pop());
+        }
+
+        size_t best = this->atCurrent_.front();
+        uint64_t bestTimestamp = timestampOf(this->children_[best].it->value());
+        for (size_t i = 1; i < this->atCurrent_.size(); ++i) {
+            const size_t candidate = this->atCurrent_[i];
+            const uint64_t timestamp = timestampOf(this->children_[candidate].it->value());
+
+            // Runs are ordered newest first, an equal timestamp keeps the earlier run
+            if (timestamp > bestTimestamp || (timestamp == bestTimestamp && candidate < best)) {
+                best = candidate;
+                bestTimestamp = timestamp;
+            }
+        }
+
+        this->shadowed_ += this->atCurrent_.size() - 1;
+        this->current_ = static_cast<int>(best);
+    }
+
+    void TableMergingIterator::seekToFirst() {
+        this->heap_.clear();
+        for (size_t i = 0; i < this->children_.size(); ++i) {
+            this->children_[i].seekToFirst();
+            if (this->children_[i].valid()) this->push(i);
+        }
+
+        this->settle();
+    }
+
+    void TableMergingIterator::seek(const std::string_view target) {
+        this->heap_.clear();
+        for (size_t i = 0; i < this->children_.size(); ++i) {
+            this->children_[i].seek(target);
+            if (this->children_[i].valid()) this->push(i);
+        }
+
+        this->settle();
+    }
+
+    void TableMergingIterator::next() {
+        assert(this->valid());
+
+        for (const size_t child: this->atCurrent_) {
+            this->children_[child].next();
+            if (this->children_[child].valid()) this->push(child);
+        }
+
+        this->settle();
+    }
+
+    core::EntryView TableMergingIterator::entry() const {
+        const Child &child = this->children_[this->current_];
+        auto entry = core::EntryView::parse(this->value(), false, child.tables[child.table]->schemas());
+        if (!entry) throw std::runtime_error("COMPACTION: failed to decode entry under the merge cursor");
+
+        return std::move(*entry);
+    }
+} // namespace compaction
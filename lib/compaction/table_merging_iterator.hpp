@@ -0,0 +1,117 @@
+//
+// Created by frostzt on 10/17/2026.
+//
+
+#ifndef ENIGMA_DB_TABLE_MERGING_ITERATOR_HPP
+#define ENIGMA_DB_TABLE_MERGING_ITERATOR_HPP
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "lib/entry/entry_view.hpp"
+#include "lib/sstable/sstable_reader.hpp"
+
+namespace compaction {
+    /**
+     * A sorted run: tables whose key ranges do not overlap, ordered by key. A level above L0 is one run,
+     * every L0 table is a run of its own.
+     */
+    using SortedRun = std::vector<std::shared_ptr<sstable::SSTableReader> >;
+
+    /**
+     * @class TableMergingIterator
+     * @brief K-way merge over sorted runs of SSTables that yields every key once, newest version only.
+     *
+     * Each run is walked one table at a time, so a merge over a whole level opens a single table of it
+     * at any moment. Children are kept in a binary heap ordered by key, a step costs O(log k) key
+     * comparisons. When several runs hold a key, the version with the highest timestamp wins and ties go
+     * to the run passed first; the losing versions are skipped and counted as shadowed. Tombstones are
+     * yielded like any other entry, dropping them is up to the caller.
+     */
+    class TableMergingIterator {
+    private:
+        /** Cursor over one run */
+        struct Child {
+            SortedRun tables;
+            size_t table{0};
+            std::optional<sstable::SSTableIterator> it{};
+
+            [[nodiscard]] bool valid() const { return this->it.has_value() && this->it->valid(); }
+
+            [[nodiscard]] const std::string &key() const { return this->it->key(); }
+
+            void seekToFirst();
+
+            /** Opens the first table of the run whose largest key is not less than `target` */
+            void seek(std::string_view target);
+
+            void next();
+
+            /** Moves on to the following tables while the current one is exhausted */
+            void skipExhaustedTables();
+        };
+
+        std::vector<Child> children_;
+
+        /** Min-heap of valid children that are not at the current key */
+        std::vector<size_t> heap_;
+
+        /** Children positioned at the current key, advanced together by next() */
+        std::vector<size_t> atCurrent_;
+
+        /** Index of the child holding the winning version, -1 when invalid */
+        int current_{-1};
+
+        uint64_t shadowed_{0};
+
+        /** Whether child `a` sorts after child `b` in the heap */
+        [[nodiscard]] bool greater(size_t a, size_t b) const;
+
+        void push(size_t child);
+
+        size_t pop();
+
+        /** Gathers every child at the smallest key and picks the newest version among them */
+        void settle();
+
+    public:
+        /**
+         * @param runs The runs to merge, ordered newest first.
+         */
+        explicit TableMergingIterator(std::vector<SortedRun> runs);
+
+        [[nodiscard]] bool valid() const { return this->current_ >= 0; }
+
+        void seekToFirst();
+
+        /**
+         * Positions the cursor at the first key that is not less than the serialized primary key
+         * `target`. Tables of a run that end before it are never opened.
+         */
+        void seek(std::string_view target);
+
+        void next();
+
+        /** Serialized primary key under the cursor */
+        [[nodiscard]] const std::string &key() const { return this->children_[this->current_].key(); }
+
+        /** Serialized entry under the cursor, valid until next() */
+        [[nodiscard]] std::string_view value() const { return this->children_[this->current_].it->value(); }
+
+        /**
+         * The entry under the cursor read in place, valid until next(). Its checksum is not verified
+         * again, the block it was read from already was.
+         *
+         * @throw std::runtime_error If the entry is malformed.
+         */
+        [[nodiscard]] core::EntryView entry() const;
+
+        /** Older versions skipped so far because a newer one of the same key won */
+        [[nodiscard]] uint64_t shadowed() const { return this->shadowed_; }
+    };
+} // namespace compaction
+
+#endif //ENIGMA_DB_TABLE_MERGING_ITERATOR_HPP
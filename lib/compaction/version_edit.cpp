@@ -0,0 +1,136 @@
+//
+// Created by frostzt on 10/17/2026.
+//
+
+#include "version_edit.hpp"
+
+#include <cstring>
+
+#include "lib/utils/crypto_utils.hpp"
+#include "lib/utils/vint/vint.hpp"
+
+namespace compaction {
+    namespace {
+        /** Field tags; new ones may be added, existing ones must keep their value */
+        enum Tag : uint32_t {
+            kNextFileNumber = 1,
+            kCompactPointer = 2,
+            kDeletedFile = 3,
+            kNewFile = 4,
+        };
+
+        void putString(std::vector<uint8_t> &out, const std::string &value) {
+            utility::putVarint32(out, static_cast<uint32_t>(value.size()));
+            out.insert(out.end(), value.begin(), value.end());
+        }
+
+        const uint8_t *getString(const uint8_t *data, const uint8_t *limit, std::string &out) {
+            utility::StatusCode status;
+            uint32_t length = 0;
+            data = utility::getVarint32(status, data, limit, length);
+            if (data == nullptr || static_cast<size_t>(limit - data) < length) return nullptr;
+
+            out.assign(reinterpret_cast<const char *>(data), length);
+            return data + length;
+        }
+
+        const uint8_t *getLevel(const uint8_t *data, const uint8_t *limit, size_t &level) {
+            utility::StatusCode status;
+            uint32_t value = 0;
+            data = utility::getVarint32(status, data, limit, value);
+            level = value;
+            return data;
+        }
+    } // namespace
+
+    void VersionEdit::encodeTo(std::vector<std::byte> &out) const {
+        std::vector<uint8_t> fields;
+
+        if (this->nextFileNumber_) {
+            utility::putVarint32(fields, kNextFileNumber);
+            utility::putVarint64(fields, *this->nextFileNumber_);
+        }
+
+        for (const auto &[level, key]: this->compactPointers_) {
+            utility::putVarint32(fields, kCompactPointer);
+            utility::putVarint32(fields, static_cast<uint32_t>(level));
+            putString(fields, key);
+        }
+
+        for (const auto &[level, number]: this->deletedFiles_) {
+            utility::putVarint32(fields, kDeletedFile);
+            utility::putVarint32(fields, static_cast<uint32_t>(level));
+            utility::putVarint64(fields, number);
+        }
+
+        for (const auto &[level, number, newestFlush]: this->newFiles_) {
+            utility::putVarint32(fields, kNewFile);
+            utility::putVarint32(fields, static_cast<uint32_t>(level));
+            utility::putVarint64(fields, number);
+            utility::putVarint64(fields, newestFlush);
+        }
+
+        const size_t start = out.size();
+        out.resize(start + fields.size() + sizeof(uint32_t));
+        if (!fields.empty()) std::memcpy(out.data() + start, fields.data(), fields.size());
+
+        const uint32_t crc = Utility::computeCRC32(out.data(), start, fields.size());
+        std::memcpy(out.data() + start + fields.size(), &crc, sizeof(crc));
+    }
+
+    std::optional<VersionEdit> VersionEdit::decode(const std::byte *data, const size_t length) {
+        if (length < sizeof(uint32_t)) return std::nullopt;
+
+        const size_t fieldsLength = length - sizeof(uint32_t);
+        uint32_t crc = 0;
+        std::memcpy(&crc, data + fieldsLength, sizeof(crc));
+        if (Utility::computeCRC32(data, 0, fieldsLength) != crc) return std::nullopt;
+
+        const auto *it = reinterpret_cast<const uint8_t *>(data);
+        const auto *limit = it + fieldsLength;
+
+        VersionEdit edit;
+        utility::StatusCode status;
+        while (it != nullptr && it < limit) {
+            uint32_t tag = 0;
+            it = utility::getVarint32(status, it, limit, tag);
+            if (it == nullptr) return std::nullopt;
+
+            switch (tag) {
+                case kNextFileNumber: {
+                    uint64_t number = 0;
+                    it = utility::getVarint64(status, it, limit, number);
+                    edit.nextFileNumber_ = number;
+                    break;
+                }
+                case kCompactPointer: {
+                    CompactPointer pointer;
+                    it = getLevel(it, limit, pointer.level);
+                    if (it != nullptr) it = getString(it, limit, pointer.key);
+                    edit.compactPointers_.push_back(std::move(pointer));
+                    break;
+                }
+                case kDeletedFile: {
+                    DeletedFile file;
+                    it = getLevel(it, limit, file.level);
+                    if (it != nullptr) it = utility::getVarint64(status, it, limit, file.number);
+                    edit.deletedFiles_.push_back(file);
+                    break;
+                }
+                case kNewFile: {
+                    NewFile file;
+                    it = getLevel(it, limit, file.level);
+                    if (it != nullptr) it = utility::getVarint64(status, it, limit, file.number);
+                    if (it != nullptr) it = utility::getVarint64(status, it, limit, file.newestFlush);
+                    edit.newFiles_.push_back(file);
+                    break;
+                }
+                default:
+                    return std::nullopt;
+            }
+        }
+
+        if (it == nullptr) return std::nullopt;
+        return edit;
+    }
+} // namespace compaction
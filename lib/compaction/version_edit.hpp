@@ -0,0 +1,85 @@
+//
+// Created by frostzt on 10/17/2026.
+//
+
+#ifndef ENIGMA_DB_VERSION_EDIT_HPP
+#define ENIGMA_DB_VERSION_EDIT_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace compaction {
+    /**
+     * @class VersionEdit
+     * @brief One atomic change to the set of live tables, the unit the MANIFEST is made of.
+     *
+     * A flush adds a table to L0, a compaction deletes its inputs and adds its outputs, a trivial move
+     * deletes a table from one level and adds it to the next. Replaying every edit of a MANIFEST in
+     * order rebuilds the level layout.
+     *
+     * Encoded as tagged fields with varint numbers and a trailing CRC32C over everything before it.
+     */
+    class VersionEdit {
+    public:
+        struct NewFile {
+            size_t level = 0;
+            uint64_t number = 0;
+
+            /** Orders the tables of L0, see TableFile::newestFlush */
+            uint64_t newestFlush = 0;
+        };
+
+        struct DeletedFile {
+            size_t level = 0;
+            uint64_t number = 0;
+        };
+
+        struct CompactPointer {
+            size_t level = 0;
+            std::string key;
+        };
+
+        void addFile(const size_t level, const uint64_t number, const uint64_t newestFlush) {
+            this->newFiles_.push_back({level, number, newestFlush});
+        }
+
+        void deleteFile(const size_t level, const uint64_t number) {
+            this->deletedFiles_.push_back({level, number});
+        }
+
+        void setNextFileNumber(const uint64_t number) { this->nextFileNumber_ = number; }
+
+        void setCompactPointer(const size_t level, std::string key) {
+            this->compactPointers_.push_back({level, std::move(key)});
+        }
+
+        [[nodiscard]] const std::vector<NewFile> &newFiles() const { return this->newFiles_; }
+
+        [[nodiscard]] const std::vector<DeletedFile> &deletedFiles() const { return this->deletedFiles_; }
+
+        [[nodiscard]] std::optional<uint64_t> nextFileNumber() const { return this->nextFileNumber_; }
+
+        [[nodiscard]] const std::vector<CompactPointer> &compactPointers() const { return this->compactPointers_; }
+
+        /** Appends the encoded edit to `out` */
+        void encodeTo(std::vector<std::byte> &out) const;
+
+        /**
+         * Decodes an edit written by encodeTo().
+         *
+         * @return std::nullopt if the bytes are truncated, malformed or fail their checksum.
+         */
+        static std::optional<VersionEdit> decode(const std::byte *data, size_t length);
+
+    private:
+        std::vector<NewFile> newFiles_;
+        std::vector<DeletedFile> deletedFiles_;
+        std::optional<uint64_t> nextFileNumber_;
+        std::vector<CompactPointer> compactPointers_;
+    };
+} // namespace compaction
+
+#endif //ENIGMA_DB_VERSION_EDIT_HPP
@@ -0,0 +1,316 @@
+//
+// Created by frostzt on 10/17/2026.
+//
+
+#include "version_set.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <set>
+#include <stdexcept>
+
+#include "lib/entry/key.hpp"
+#include "lib/wal/wal_codec.hpp"
+#include "lib/wal/wal_segment_reader.hpp"
+#include "spdlog/spdlog.h"
+
+namespace compaction {
+    namespace {
+        constexpr auto kCurrentFileName = "CURRENT";
+        constexpr auto kCurrentTempFileName = "CURRENT.tmp";
+
+        int compareKeys(const std::string_view lhs, const std::string_view rhs) {
+            return core::Key::compareOrdered(lhs, rhs);
+        }
+
+        void insertByKey(FileList &files, std::shared_ptr<TableFile> file) {
+            const auto position = std::upper_bound(files.begin(), files.end(), file,
+                                                   [](const std::shared_ptr<TableFile> &lhs,
+                                                      const std::shared_ptr<TableFile> &rhs) {
+                                                       return compareKeys(lhs->props.smallestKey,
+                                                                          rhs->props.smallestKey) < 0;
+                                                   });
+            files.insert(position, std::move(file));
+        }
+
+        /** Inserts into L0, which is kept oldest first so newer tables shadow older ones on lookups */
+        void insertByAge(FileList &files, std::shared_ptr<TableFile> file) {
+            const auto position = std::upper_bound(files.begin(), files.end(), file->newestFlush,
+                                                   [](const uint64_t newestFlush, const std::shared_ptr<TableFile> &f) {
+                                                       return newestFlush < f->newestFlush;
+                                                   });
+            files.insert(position, std::move(file));
+        }
+
+        void insertFile(Version &version, const size_t level, std::shared_ptr<TableFile> file) {
+            if (level == 0) {
+                insertByAge(version.levels[0], std::move(file));
+            } else {
+                insertByKey(version.levels[level], std::move(file));
+            }
+        }
+
+        /** Parses "000042.sst" into 42, 0 for anything that is not a table file */
+        uint64_t tableNumber(const std::filesystem::path &path) {
+            if (path.extension() != ".sst") return 0;
+
+            const auto stem = path.stem().string();
+            if (stem.empty() || !std::all_of(stem.begin(), stem.end(), [](const char c) { return c >= '0' && c <= '9'; })) {
+                return 0;
+            }
+
+            return std::stoull(stem);
+        }
+    } // namespace
+
+    std::string manifestFileName(const uint64_t number) {
+        char name[32];
+        std::snprintf(name, sizeof(name), "MANIFEST-%06llu", static_cast<unsigned long long>(number));
+        return name;
+    }
+
+    VersionSet::VersionSet(std::shared_ptr<io_engine::IoEngine> engine, std::string dir, const size_t levels,
+                           TableOpener opener)
+        : engine_(std::move(engine)), dir_(std::move(dir)), opener_(std::move(opener)) {
+        auto version = std::make_shared<Version>();
+        version->levels.resize(levels);
+        this->current_ = std::move(version);
+        this->compactPointers_.resize(levels);
+    }
+
+    VersionSet::~VersionSet() {
+        if (this->manifest_.valid()) this->engine_->close(this->manifest_);
+    }
+
+    void VersionSet::recover() {
+        const auto dir = std::filesystem::path(this->dir_);
+        std::filesystem::create_directories(dir);
+
+        std::string previous;
+        if (std::ifstream current(dir / kCurrentFileName); current) std::getline(current, previous);
+
+        // Per level, table number -> newest flush it holds
+        std::vector<std::map<uint64_t, uint64_t> > live(this->current_->levels.size());
+        uint64_t nextFileNumber = 1;
+
+        if (!previous.empty()) {
+            WAL::WALSegmentReader manifest(dir / previous);
+
+            size_t offset = 0;
+            size_t edits = 0;
+            const std::byte *payload = nullptr;
+            uint32_t payloadLength = 0;
+            while (WAL::nextFrame(manifest.data(), manifest.size(), offset, payload, payloadLength)) {
+                const auto edit = VersionEdit::decode(payload, payloadLength);
+                if (!edit) break;
+
+                for (const auto &[level, number]: edit->deletedFiles()) {
+                    if (level < live.size()) live[level].erase(number);
+                }
+                for (const auto &[level, number, newestFlush]: edit->newFiles()) {
+                    if (level >= live.size()) {
+                        throw std::runtime_error("VERSION: " + previous + " places a table at level " +
+                                                 std::to_string(level) + " beyond the configured levels");
+                    }
+                    live[level][number] = newestFlush;
+                }
+                for (const auto &[level, key]: edit->compactPointers()) {
+                    if (level < this->compactPointers_.size()) this->compactPointers_[level] = key;
+                }
+                if (edit->nextFileNumber()) nextFileNumber = std::max(nextFileNumber, *edit->nextFileNumber());
+
+                ++edits;
+            }
+
+            if (offset != manifest.size()) {
+                spdlog::warn("VERSION: ignoring {} bytes of a torn edit at the end of {}", manifest.size() - offset,
+                             previous);
+            }
+            spdlog::debug("VERSION: replayed {} edits of {}", edits, previous);
+        }
+
+        auto version = std::make_shared<Version>();
+        version->levels.resize(live.size());
+        std::set<uint64_t> liveNumbers;
+        for (size_t level = 0; level < live.size(); ++level) {
+            for (const auto &[number, newestFlush]: live[level]) {
+                auto file = this->opener_(number);
+                file->newestFlush = newestFlush;
+                insertFile(*version, level, std::move(file));
+
+                nextFileNumber = std::max(nextFileNumber, number + 1);
+                liveNumbers.insert(number);
+            }
+        }
+
+        // Never hand out the number of a file that is already there; tables the MANIFEST does not know
+        // are what an interrupted flush or compaction left behind
+        std::vector<std::filesystem::path> orphans;
+        for (const auto &entry: std::filesystem::directory_iterator(dir)) {
+            const uint64_t number = tableNumber(entry.path().filename());
+            if (number == 0) continue;
+
+            nextFileNumber = std::max(nextFileNumber, number + 1);
+            if (!previous.empty() && !liveNumbers.contains(number)) orphans.push_back(entry.path());
+        }
+
+        for (const auto &path: orphans) {
+            spdlog::info("VERSION: removing orphaned table {}", path.filename().string());
+            std::error_code ec;
+            std::filesystem::remove(path, ec);
+        }
+
+        this->nextFileNumber_ = nextFileNumber;
+        this->writeSnapshot(*version, this->compactPointers_);
+        this->current_ = std::move(version);
+
+        // writeSnapshot() synced the directory after swapping CURRENT, nothing refers to it anymore
+        if (!previous.empty()) std::filesystem::remove(dir / previous);
+    }
+
+    void VersionSet::logAndApply(VersionEdit edit, const FileList &newFiles) {
+        if (this->failed_) {
+            throw std::runtime_error("VERSION: refusing edits after " + manifestFileName(this->manifestNumber_) +
+                                     " failed");
+        }
+
+        auto version = std::make_shared<Version>(*this->current_);
+
+        FileList dropped;
+        for (const auto &[level, number]: edit.deletedFiles()) {
+            auto &files = version->levels[level];
+            const auto it = std::find_if(files.begin(), files.end(),
+                                         [number](const auto &file) { return file->number == number; });
+            if (it == files.end()) continue;
+
+            dropped.push_back(*it);
+            files.erase(it);
+        }
+
+        for (const auto &[level, number, newestFlush]: edit.newFiles()) {
+            const auto it = std::find_if(newFiles.begin(), newFiles.end(),
+                                         [number](const auto &file) { return file->number == number; });
+            if (it == newFiles.end()) {
+                throw std::invalid_argument("VERSION: edit adds table " + std::to_string(number) + " without opening it");
+            }
+
+            insertFile(*version, level, *it);
+        }
+
+        edit.setNextFileNumber(this->nextFileNumber_.load());
+        auto compactPointers = this->compactPointers_;
+        for (const auto &[level, key]: edit.compactPointers()) compactPointers[level] = key;
+
+        if (this->manifestBytes_ >= kMaxManifestBytes) {
+            this->writeSnapshot(*version, compactPointers);
+        } else if (!this->appendEdit(edit)) {
+            // The edit may be in the MANIFEST in full, torn or not at all, and a torn frame hides every later
+            // one from recover(). A new MANIFEST without it makes the edit certainly lost before the caller
+            // deletes its tables; should that fail as well, nothing may be appended anymore
+            const auto name = manifestFileName(this->manifestNumber_);
+            this->failed_ = true;
+            this->writeSnapshot(*this->current_, this->compactPointers_);
+            this->failed_ = false;
+
+            throw std::runtime_error("VERSION: failed to append to " + name);
+        }
+
+        this->compactPointers_ = std::move(compactPointers);
+        this->current_ = std::move(version);
+
+        // A table moved between levels is deleted and added by the same edit, it is not obsolete
+        for (auto &file: dropped) {
+            const bool moved = std::any_of(newFiles.begin(), newFiles.end(),
+                                           [&file](const auto &added) { return added == file; });
+            if (!moved) this->obsolete_.emplace_back(file->number, file);
+        }
+    }
+
+    std::vector<uint64_t> VersionSet::takeObsoleteFiles() {
+        std::vector<uint64_t> numbers;
+        std::erase_if(this->obsolete_, [&numbers](const auto &entry) {
+            if (!entry.second.expired()) return false;
+
+            numbers.push_back(entry.first);
+            return true;
+        });
+
+        return numbers;
+    }
+
+    void VersionSet::writeSnapshot(const Version &version, const std::vector<std::string> &compactPointers) {
+        const auto dir = std::filesystem::path(this->dir_);
+        const uint64_t number = this->newFileNumber();
+        const auto name = manifestFileName(number);
+
+        std::filesystem::remove(dir / name);
+        const auto manifest = this->engine_->openSegment(this->dir_, name);
+        if (!manifest.valid()) throw std::runtime_error("VERSION: failed to create " + name);
+
+        VersionEdit snapshot;
+        snapshot.setNextFileNumber(this->nextFileNumber_.load());
+        for (size_t level = 0; level < version.levels.size(); ++level) {
+            for (const auto &file: version.levels[level]) snapshot.addFile(level, file->number, file->newestFlush);
+            if (!compactPointers[level].empty()) snapshot.setCompactPointer(level, compactPointers[level]);
+        }
+
+        const auto previous = std::exchange(this->manifest_, manifest);
+        const uint64_t previousNumber = std::exchange(this->manifestNumber_, number);
+        this->manifestBytes_ = 0;
+
+        const auto rollBack = [&] {
+            this->engine_->close(this->manifest_);
+            std::filesystem::remove(dir / name);
+            this->manifest_ = previous;
+            this->manifestNumber_ = previousNumber;
+        };
+
+        // The new MANIFEST's name must be durable before CURRENT may point at it
+        if (!this->appendEdit(snapshot) || !io_engine::syncDirectory(this->dir_)) {
+            rollBack();
+            throw std::runtime_error("VERSION: failed to write " + name);
+        }
+
+        // CURRENT is swapped in with a rename, a crash leaves either the old or the new MANIFEST in use
+        std::filesystem::remove(dir / kCurrentTempFileName);
+        const auto current = this->engine_->openSegment(this->dir_, kCurrentTempFileName);
+        const std::string contents = name + "\n";
+        const bool written = current.valid() &&
+                             this->engine_->writeSync(current, contents.data(), contents.size()) ==
+                             static_cast<long long>(contents.size());
+        if (current.valid()) this->engine_->close(current);
+
+        if (!written) {
+            rollBack();
+            throw std::runtime_error("VERSION: failed to write " + std::string(kCurrentTempFileName));
+        }
+        std::filesystem::rename(dir / kCurrentTempFileName, dir / kCurrentFileName);
+        if (previous.valid()) this->engine_->close(previous);
+
+        // Until the rename is durable a crash may bring the old CURRENT back, so its MANIFEST stays
+        if (!io_engine::syncDirectory(this->dir_)) {
+            this->failed_ = true;
+            throw std::runtime_error("VERSION: failed to sync " + std::string(kCurrentFileName));
+        }
+        if (previousNumber != 0) std::filesystem::remove(dir / manifestFileName(previousNumber));
+    }
+
+    bool VersionSet::appendEdit(const VersionEdit &edit) {
+        std::vector<std::byte> payload;
+        edit.encodeTo(payload);
+
+        std::vector<std::byte> record;
+        WAL::encodeFrame(record, payload.data(), static_cast<uint32_t>(payload.size()));
+
+        if (this->engine_->writeSync(this->manifest_, record.data(), record.size()) !=
+            static_cast<long long>(record.size())) {
+            return false;
+        }
+
+        this->manifestBytes_ += record.size();
+        return true;
+    }
+} // namespace compaction
@@ -0,0 +1,161 @@
+//
+// Created by frostzt on 10/17/2026.
+//
+
+#ifndef ENIGMA_DB_VERSION_SET_HPP
+#define ENIGMA_DB_VERSION_SET_HPP
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "lib/compaction/version_edit.hpp"
+#include "lib/io/engine.hpp"
+#include "lib/sstable/sstable_reader.hpp"
+#include "lib/utils/constants.hpp"
+
+namespace compaction {
+    /**
+     * @struct TableFile
+     * @brief A live table and the level bookkeeping attached to it.
+     */
+    struct TableFile {
+        uint64_t number = 0;
+        sstable::TableProperties props;
+        std::shared_ptr<sstable::SSTableReader> reader;
+
+        /** Newest flush the table holds data of, orders the overlapping tables of L0 from oldest to newest */
+        uint64_t newestFlush = 0;
+
+        /** Set while a compaction holds the table as an input, guarded by the scheduler mutex */
+        bool beingCompacted = false;
+    };
+
+    using FileList = std::vector<std::shared_ptr<TableFile> >;
+
+    /**
+     * @struct Version
+     * @brief An immutable snapshot of the live tables, L0 oldest first and every other level by key.
+     *
+     * Readers hold on to the shared_ptr for as long as they read, which keeps every table of the
+     * snapshot on disk even after a compaction swapped it out of the current version.
+     */
+    struct Version {
+        std::vector<FileList> levels;
+    };
+
+    /**
+     * @class VersionSet
+     * @brief The current Version of a table directory and the MANIFEST that persists it.
+     *
+     * Every change to the set of live tables is a VersionEdit that is appended to the MANIFEST, framed
+     * like a WAL record and synced, before it becomes the current Version. The file named by CURRENT is
+     * the MANIFEST in use; on startup its edits are replayed to rebuild the levels without looking
+     * inside any table, a torn edit at its tail from a crash mid-append is ignored. Recovery then starts
+     * a new MANIFEST holding a snapshot of the recovered state, as does an append once the MANIFEST has
+     * grown past kMaxManifestBytes.
+     *
+     * Tables dropped from the current Version become obsolete once no older Version still referring to
+     * them is alive; takeObsoleteFiles() hands them out for deletion.
+     *
+     * Not synchronized, the owner serializes every call; newFileNumber() alone may be called from any
+     * thread.
+     */
+    class VersionSet {
+    public:
+        /** Opens table `number` of the directory */
+        using TableOpener = std::function<std::shared_ptr<TableFile>(uint64_t number)>;
+
+        static constexpr uint64_t kMaxManifestBytes = 4_MB;
+
+        VersionSet(std::shared_ptr<io_engine::IoEngine> engine, std::string dir, size_t levels, TableOpener opener);
+
+        ~VersionSet();
+
+        VersionSet(const VersionSet &) = delete;
+
+        VersionSet &operator=(const VersionSet &) = delete;
+
+        /**
+         * Replays the MANIFEST named by CURRENT, opens the tables it lists and removes every other table
+         * of the directory, which an interrupted flush or compaction left behind. Without a CURRENT the
+         * directory starts out empty and tables already in it are left alone. Either way a new MANIFEST
+         * is started.
+         *
+         * @throw std::runtime_error If the MANIFEST names a table that cannot be opened or the new
+         *                           MANIFEST cannot be written.
+         */
+        void recover();
+
+        [[nodiscard]] std::shared_ptr<const Version> current() const { return this->current_; }
+
+        /**
+         * Persists `edit` and makes the result the current Version.
+         *
+         * An append that fails may still have left the edit, or a torn part of it, in the MANIFEST. It is
+         * then replaced by a new MANIFEST holding the unchanged Version before this throws, so the tables
+         * `edit` adds may be deleted. If that fails too, failed() is set.
+         *
+         * @param newFiles The opened tables of every file `edit` adds.
+         * @throw std::runtime_error If the edit cannot be made durable, or failed() is set; the current
+         *                           Version is unchanged.
+         */
+        void logAndApply(VersionEdit edit, const FileList &newFiles);
+
+        /**
+         * Whether a MANIFEST failure left it unknown if the last edit is durable. Every later
+         * logAndApply() throws, and the tables that edit adds must stay, recover() may still list them.
+         */
+        [[nodiscard]] bool failed() const { return this->failed_; }
+
+        uint64_t newFileNumber() { return this->nextFileNumber_.fetch_add(1); }
+
+        /** Largest key of the last table compacted out of `level`, empty if none */
+        [[nodiscard]] const std::string &compactPointer(const size_t level) const {
+            return this->compactPointers_[level];
+        }
+
+        /** Numbers of the tables dropped from every live Version since the last call */
+        std::vector<uint64_t> takeObsoleteFiles();
+
+        /** Number of the MANIFEST in use, 0 before recover() */
+        [[nodiscard]] uint64_t manifestNumber() const { return this->manifestNumber_; }
+
+    private:
+        std::shared_ptr<io_engine::IoEngine> engine_;
+        std::string dir_;
+        TableOpener opener_;
+
+        std::shared_ptr<const Version> current_;
+        std::vector<std::string> compactPointers_;
+        std::atomic<uint64_t> nextFileNumber_{1};
+
+        io_engine::SegmentHandle manifest_;
+        uint64_t manifestNumber_{0};
+        uint64_t manifestBytes_{0};
+        bool failed_{false};
+
+        /** Tables dropped from the current Version that an older one may still refer to */
+        std::vector<std::pair<uint64_t, std::weak_ptr<TableFile> > > obsolete_;
+
+        /**
+         * Starts a new MANIFEST holding `version` and `compactPointers`, points CURRENT at it and removes
+         * the previous one. The directory is synced once the new MANIFEST exists and again after CURRENT
+         * is renamed, the previous MANIFEST is only removed after that.
+         *
+         * @throw std::runtime_error If the new MANIFEST or CURRENT cannot be written or synced. Up to the
+         *                           rename the previous MANIFEST stays in use; past it failed_ is set.
+         */
+        void writeSnapshot(const Version &version, const std::vector<std::string> &compactPointers);
+
+        /** Appends one framed edit to the open MANIFEST and syncs it */
+        [[nodiscard]] bool appendEdit(const VersionEdit &edit);
+    };
+
+    /** Returns the file name of MANIFEST number `number`, e.g. "MANIFEST-000042" */
+    std::string manifestFileName(uint64_t number);
+} // namespace compaction
+
+#endif //ENIGMA_DB_VERSION_SET_HPP
@@ -30,6 +30,14 @@ namespace core::datatypes {
             return Serializer<T>::serialize(std::get<T>(v));
         };
 
+        [[nodiscard]] size_t serializedSize(const FieldValue &v) const override {
+            return Serializer<T>::serializedSize(std::get<T>(v));
+        }
+
+        std::byte *serializeTo(const FieldValue &v, std::byte *out) const override {
+            return Serializer<T>::serializeTo(std::get<T>(v), out);
+        }
+
         [[nodiscard]] FieldValue deserialize(const std::byte *data, size_t len) const override {
             return Serializer<T>::deserialize(data, len);
         }
@@ -47,6 +47,15 @@ namespace core::datatypes {
         return out;
     }
 
+    size_t Field::serializedSize() const {
+        return 1 + this->getDescriptor()->serializedSize(this->value_);
+    }
+
+    std::byte *Field::serializeTo(std::byte *out) const {
+        *out = static_cast<std::byte>(this->type_);
+        return this->getDescriptor()->serializeTo(this->value_, out + 1);
+    }
+
     Field Field::deserialize(const std::byte *data, const size_t len) {
         if (len < 1) throw std::runtime_error("Invalid field length");
 
@@ -57,6 +57,16 @@ namespace core::datatypes {
 
         [[nodiscard]] std::vector<std::byte> serialize() const;
 
+        /** Number of bytes serialize() returns, the type tag included */
+        [[nodiscard]] size_t serializedSize() const;
+
+        /**
+         * Writes what serialize() returns to `out`, which must have room for serializedSize() bytes.
+         *
+         * @return A pointer one past the last byte written.
+         */
+        std::byte *serializeTo(std::byte *out) const;
+
         static Field deserialize(const std::byte *data, size_t len);
 
         bool operator==(const Field &other) const {
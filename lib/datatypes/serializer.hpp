@@ -24,6 +24,15 @@ namespace core::datatypes {
             return out;
         }
 
+        static size_t serializedSize(const T &) { return sizeof(T); }
+
+        static std::byte *serializeTo(const T &v, std::byte *out) {
+            static_assert(std::is_trivially_copyable_v<T>, "T must be trivially copyable");
+
+            std::memcpy(out, &v, sizeof(T));
+            return out + sizeof(T);
+        }
+
         static T deserialize(const std::byte *data, const size_t len) {
             static_assert(std::is_trivially_copyable_v<T>, "T must be trivially copyable");
 
@@ -58,6 +67,19 @@ namespace core::datatypes {
             return ScalarSerializer<T>::serialize(v);
         }
 
+        /** Number of bytes serialize(v) returns */
+        static size_t serializedSize(const T &v) {
+            return ScalarSerializer<T>::serializedSize(v);
+        }
+
+        /**
+         * Writes the bytes serialize(v) returns straight to `out`, which must have room for
+         * serializedSize(v) of them, and returns a pointer one past the last byte written.
+         */
+        static std::byte *serializeTo(const T &v, std::byte *out) {
+            return ScalarSerializer<T>::serializeTo(v, out);
+        }
+
         /**
          * @brief Deserializes a vector of bytes into an object of type `T`.
          *
@@ -100,6 +122,17 @@ namespace core::datatypes {
             return out;
         }
 
+        static size_t serializedSize(const std::string &v) { return sizeof(uint16_t) + v.size(); }
+
+        static std::byte *serializeTo(const std::string &v, std::byte *out) {
+            assert(v.size() <= UINT16_MAX);
+            const auto size = static_cast<uint16_t>(v.size());
+            out[0] = static_cast<std::byte>(size & 0xFF);
+            out[1] = static_cast<std::byte>((size >> 8) & 0xFF);
+            if (size) std::memcpy(out + 2, v.data(), size);
+            return out + 2 + size;
+        }
+
         static std::string deserialize(const std::byte *data, const size_t len) {
             const uint16_t size = Utility::ByteParser::readUint16(data, 0);
             if (len < 2) throw std::runtime_error("Invalid string length");
@@ -126,6 +159,13 @@ namespace core::datatypes {
             return out;
         }
 
+        static size_t serializedSize(const UUID &) { return 16; }
+
+        static std::byte *serializeTo(const UUID &v, std::byte *out) {
+            std::memcpy(out, v._value.data(), 16);
+            return out + 16;
+        }
+
         static UUID deserialize(const std::byte *data, const size_t len) {
             if (len != 16) throw std::runtime_error("Invalid UUID length");
             std::array<uint8_t, 16> uuid{};
@@ -156,6 +196,13 @@ namespace core::datatypes {
             return out;
         }
 
+        static size_t serializedSize(const std::vector<uint8_t> &v) { return v.size(); }
+
+        static std::byte *serializeTo(const std::vector<uint8_t> &v, std::byte *out) {
+            if (!v.empty()) std::memcpy(out, v.data(), v.size());
+            return out + v.size();
+        }
+
         static std::vector<uint8_t> deserialize(const std::byte *data, const size_t len) {
             return std::vector<uint8_t>{
                 reinterpret_cast<const uint8_t *>(data), reinterpret_cast<const uint8_t *>(data) + len
@@ -176,6 +223,13 @@ namespace core::datatypes {
             return {v};
         }
 
+        static size_t serializedSize(std::byte) { return 1; }
+
+        static std::byte *serializeTo(const std::byte v, std::byte *out) {
+            *out = v;
+            return out + 1;
+        }
+
         static std::byte deserialize(const std::byte *data, size_t len) {
             if (len != 1) throw std::runtime_error("Invalid byte length");
             return data[0];
@@ -195,6 +249,13 @@ namespace core::datatypes {
             return ScalarSerializer<int64_t>::serialize(nanos);
         }
 
+        static size_t serializedSize(const std::chrono::system_clock::time_point &) { return sizeof(int64_t); }
+
+        static std::byte *serializeTo(const std::chrono::system_clock::time_point &tp, std::byte *out) {
+            const auto nanos = std::chrono::duration_cast<std::chrono::nanoseconds>(tp.time_since_epoch()).count();
+            return ScalarSerializer<int64_t>::serializeTo(nanos, out);
+        }
+
         static std::chrono::system_clock::time_point deserialize(const std::byte *data, size_t len) {
             int64_t nanos = ScalarSerializer<int64_t>::deserialize(data, len);
             return std::chrono::system_clock::time_point(std::chrono::nanoseconds(nanos));
@@ -214,6 +275,10 @@ namespace core::datatypes {
             return {}; // Nothing to write
         }
 
+        static size_t serializedSize(const std::monostate &) { return 0; }
+
+        static std::byte *serializeTo(const std::monostate &, std::byte *out) { return out; }
+
         static std::monostate deserialize(const std::byte *, size_t) {
             return {};
         }
@@ -8,7 +8,9 @@
 
 #include "field_value.hpp"
 
+#include <cstring>
 #include <string>
+#include <vector>
 
 namespace core::datatypes {
     class ITypeDescriptor {
@@ -23,6 +25,21 @@ namespace core::datatypes {
 
         [[nodiscard]] virtual std::vector<std::byte> serialize(const FieldValue &v) const = 0;
 
+        /** Number of bytes serialize(v) produces; the default serializes, built-in types override it */
+        [[nodiscard]] virtual size_t serializedSize(const FieldValue &v) const { return this->serialize(v).size(); }
+
+        /**
+         * Writes the bytes serialize(v) produces to `out`, which must have room for serializedSize(v) of
+         * them, without an intermediate vector for the built-in types.
+         *
+         * @return A pointer one past the last byte written.
+         */
+        virtual std::byte *serializeTo(const FieldValue &v, std::byte *out) const {
+            const auto bytes = this->serialize(v);
+            if (!bytes.empty()) std::memcpy(out, bytes.data(), bytes.size());
+            return out + bytes.size();
+        }
+
         [[nodiscard]] virtual FieldValue deserialize(const std::byte *data, size_t len) const = 0;
 
         [[nodiscard]] virtual std::string toString(const FieldValue &v) const = 0;
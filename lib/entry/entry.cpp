@@ -2,10 +2,14 @@
 // Created by frostzt on 7/13/25.
 //
 
+#include <cassert>
+#include <cstring>
 #include <sstream>
 #include <iomanip>
 
 #include "entry.hpp"
+#include "lib/entry/entry_view.hpp"
+#include "lib/entry/packed_row.hpp"
 #include "lib/utils/byte_parser.hpp"
 #include "lib/utils/crypto_utils.hpp"
 #include "lib/utils/logger.hpp"
@@ -13,73 +17,128 @@
 namespace core {
     std::vector<std::byte> Entry::serialize() const {
         std::vector<std::byte> byteV{};
+        this->serialize(byteV);
 
-        // Write magic bytes
-        Utility::ByteParser::writeMagicBytes(byteV);
+        return byteV;
+    }
 
-        // Reserve 8 bytes for total size
-        for (int i = 0; i < 8; i++) byteV.push_back(static_cast<std::byte>(0)); // placeholder
+    namespace {
+        /** Tombstone flag, timestamp and checksum */
+        constexpr size_t kTrailerSize = 1 + sizeof(uint64_t) + sizeof(uint32_t);
 
-        Utility::ByteParser::writeString(byteV, this->tableName);
-        Utility::ByteParser::writeKey(byteV, this->primaryKey_);
-        Utility::ByteParser::writeUint16(byteV, this->rowData_.size());
+        // Little endian, like ByteParser
+        std::byte *putUint16(std::byte *out, const uint16_t value) {
+            out[0] = static_cast<std::byte>(value & 0xFF);
+            out[1] = static_cast<std::byte>((value >> 8) & 0xFF);
+            return out + 2;
+        }
 
-        for (const auto &[key, value]: this->rowData_) {
-            Utility::ByteParser::writeString(byteV, key);
-            Utility::ByteParser::writeVariant(byteV, value);
+        std::byte *putUint32(std::byte *out, const uint32_t value) {
+            for (int i = 0; i < 4; ++i) out[i] = static_cast<std::byte>((value >> (i * 8)) & 0xFF);
+            return out + 4;
         }
 
-        byteV.push_back(static_cast<std::byte>(this->isTombstone_ ? 1 : 0));
-        Utility::ByteParser::writeUint64(byteV, this->timestamp_);
+        std::byte *putUint64(std::byte *out, const uint64_t value) {
+            for (int i = 0; i < 8; ++i) out[i] = static_cast<std::byte>((value >> (i * 8)) & 0xFF);
+            return out + 8;
+        }
 
-        // Patch the header to update the total size
-        const uint64_t totalSize = byteV.size() + 4; // +4 for checksum
-        Utility::ByteParser::patchUint64(byteV, 5, totalSize);
+        std::byte *putString(std::byte *out, const std::string &value) {
+            out = putUint16(out, static_cast<uint16_t>(value.size()));
+            if (!value.empty()) std::memcpy(out, value.data(), value.size());
+            return out + value.size();
+        }
 
-        // Compute CRC32
-        const uint32_t checksum = Utility::computeCRC32(byteV, 0, byteV.size());
-        Utility::ByteParser::writeUint32(byteV, checksum);
+        /** A field behind its u16 length, as ByteParser::writeVariant lays it out */
+        std::byte *putField(std::byte *out, const datatypes::Field &field) {
+            std::byte *end = field.serializeTo(out + sizeof(uint16_t));
+            putUint16(out, static_cast<uint16_t>(end - out - sizeof(uint16_t)));
+            return end;
+        }
 
-        return byteV;
+        std::byte *putVarint32(std::byte *out, const uint32_t value) {
+            return reinterpret_cast<std::byte *>(utility::encodeVarint32(reinterpret_cast<uint8_t *>(out), value));
+        }
+    } // namespace
+
+    void Entry::serialize(std::vector<std::byte> &byteV) const {
+        const size_t start = byteV.size();
+        byteV.resize(start + this->serializedSize());
+        this->serializeInto(std::span(byteV).subspan(start));
     }
 
-    std::optional<Entry> Entry::deserialize(const std::byte *data, const size_t length) {
-        if (const auto isEntry = std::string(reinterpret_cast<const char *>(data), 5); isEntry != "ENTRY") {
-            spdlog::error("ENTRY: invalid magic bytes while entry deserialization: {}", isEntry);
-            return std::nullopt;
+    size_t Entry::serializedSize() const {
+        size_t size = Utility::magic.size() + sizeof(uint64_t) + sizeof(uint16_t);
+        size += this->hasTableId() ? utility::varintLength(this->schema_->tableId()) : this->tableName.size();
+
+        size += sizeof(uint16_t);
+        for (const auto &part: this->primaryKey_.parts_) size += sizeof(uint16_t) + part.serializedSize();
+
+        size += sizeof(uint16_t);
+        if (this->schema_) {
+            const size_t packedLength = packedRowSize(*this->schema_, this->rowData_);
+            size += utility::varintLength(packedLength) + packedLength;
+        } else {
+            for (const auto &[name, value]: this->rowData_) {
+                size += sizeof(uint16_t) + name.size() + sizeof(uint16_t) + value.serializedSize();
+            }
         }
 
-        Utility::ByteParser parser(data + 5, length - 5);
-        const uint64_t totalSize = parser.readUint64();
+        return size + kTrailerSize;
+    }
+
+    void Entry::serializeInto(const std::span<std::byte> out) const {
+        std::byte *cursor = out.data();
+        std::byte *const end = out.data() + out.size();
 
-        Entry entry{};
+        std::memcpy(cursor, Utility::magic.data(), Utility::magic.size());
+        cursor = putUint64(cursor + Utility::magic.size(), out.size());
 
-        entry.tableName = parser.readString();
-        entry.primaryKey_ = std::move(parser.readKey());
+        if (this->hasTableId()) {
+            cursor = putVarint32(putUint16(cursor, kTableIdMarker), this->schema_->tableId());
+        } else {
+            cursor = putString(cursor, this->tableName);
+        }
 
-        const auto rowSize = parser.readUint16();
-        for (size_t i = 0; i < static_cast<size_t>(rowSize); i++) {
-            const std::string key = parser.readString();
-            const auto variant = parser.readVariant();
+        cursor = putUint16(cursor, static_cast<uint16_t>(this->primaryKey_.parts_.size()));
+        for (const auto &part: this->primaryKey_.parts_) cursor = putField(cursor, part);
 
-            // Handle corrupt entry
-            if (!variant.has_value()) {
-                return std::nullopt;
-            }
+        if (this->schema_) {
+            cursor = putUint16(cursor, kPackedRowMarker);
 
-            entry.rowData_.emplace(key, *variant);
+            // What is left before the trailer is the packed row behind its varint length, so the
+            // length follows from the buffer size instead of packing the row twice
+            const size_t remaining = end - cursor - kTrailerSize;
+            size_t prefix = 1;
+            while (utility::varintLength(remaining - prefix) != prefix) ++prefix;
+            const size_t packedLength = remaining - prefix;
+
+            cursor = encodePackedRow(*this->schema_, this->rowData_,
+                                     putVarint32(cursor, static_cast<uint32_t>(packedLength)));
+        } else {
+            cursor = putUint16(cursor, static_cast<uint16_t>(this->rowData_.size()));
+            for (const auto &[name, value]: this->rowData_) cursor = putField(putString(cursor, name), value);
         }
 
-        entry.isTombstone_ = static_cast<bool>(parser.readByte());
-        entry.timestamp_ = parser.readUint64();
+        *cursor++ = static_cast<std::byte>(this->isTombstone_ ? 1 : 0);
+        cursor = putUint64(cursor, this->timestamp_);
+
+        const uint32_t checksum = Utility::computeCRC32(out.data(), 0, cursor - out.data());
+        cursor = putUint32(cursor, checksum);
+        assert(cursor == end);
+    }
 
-        const uint32_t expected = parser.readUint32();
-        if (const uint32_t actual = Utility::computeCRC32(data, 0, totalSize - 4); expected != actual) {
-            spdlog::debug("mismatched checksum while entry deserialization: {} != {}", expected, actual);
+    std::optional<Entry> Entry::deserialize(const std::byte *data, const size_t length,
+                                            const SchemaRegistry &schemas) {
+        const auto view = EntryView::parse(data, length, true, schemas);
+        if (!view) return std::nullopt;
+
+        try {
+            return view->toEntry();
+        } catch (const std::runtime_error &e) {
+            spdlog::error("ENTRY: {}", e.what());
             return std::nullopt;
         }
-
-        return entry;
     }
 
     std::string Entry::toHex() const {
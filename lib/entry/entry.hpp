@@ -6,9 +6,12 @@
 #include <iostream>
 #include <variant>
 #include <optional>
+#include <span>
 
 #include "lib/entry/key.hpp"
 #include "lib/entry/core_constants.hpp"
+#include "lib/entry/schema.hpp"
+#include "lib/utils/vint/vint.hpp"
 #include "lib/abstract/timestamp_generator.hpp"
 
 namespace core {
@@ -20,18 +23,104 @@ namespace core {
         bool isTombstone_{false};
         std::uint64_t timestamp_{};
 
+        /**
+         * Schema the row is packed against when serialized, nullptr for the legacy encoding that
+         * names every column. A schema with a catalog table id also has the id written in place of
+         * the table name. Deserializing either sets it to the table's registered schema.
+         */
+        std::shared_ptr<const TableSchema> schema_;
+
+        /** Row size marker that stands for a packed row in place of the legacy column count */
+        static constexpr uint16_t kPackedRowMarker = 0xFFFF;
+
+        /** Table name length marker that stands for a varint table id in place of the name */
+        static constexpr uint16_t kTableIdMarker = 0xFFFF;
+
         Entry() = default;
 
         Entry(std::string table, Key pk, Row data, const bool tombstone = false, const uint64_t ts = 0)
             : tableName(std::move(table)), primaryKey_(std::move(pk)), rowData_(std::move(data)),
               isTombstone_(tombstone) {
+            // Honour an explicit timestamp (e.g. tombstones, lookups), otherwise stamp the entry now
+            if (ts != 0) {
+                this->timestamp_ = ts;
+                return;
+            }
+
             TimestampGenerator tsGen;
             this->timestamp_ = tsGen.next();
         }
 
+        /** An entry of `schema`'s table whose row, and table id if it has one, are serialized compactly */
+        Entry(std::shared_ptr<const TableSchema> schema, Key pk, Row data, const bool tombstone = false,
+              const uint64_t ts = 0)
+            : Entry(schema->tableName(), std::move(pk), std::move(data), tombstone, ts) {
+            this->schema_ = std::move(schema);
+        }
+
         std::vector<std::byte> serialize() const;
 
-        static std::optional<Entry> deserialize(const std::byte *data, size_t length);
+        /**
+         * Appends the serialized entry to `out`, letting callers reuse one buffer across entries.
+         *
+         * @param out Buffer the encoded entry is appended to; existing contents are left untouched.
+         */
+        void serialize(std::vector<std::byte> &out) const;
+
+        /** Exact number of bytes the serialized entry takes */
+        [[nodiscard]] size_t serializedSize() const;
+
+        /**
+         * Serializes the entry in a single pass straight into `out`, e.g. a WAL batch or an arena
+         * allocation, without any intermediate buffer; nothing is allocated for built-in field types.
+         *
+         * @param out Exactly serializedSize() bytes.
+         * @throw std::runtime_error Like encodePackedRow, for an entry with a schema its row does not fit.
+         */
+        void serializeInto(std::span<std::byte> out) const;
+
+        /** Whether the table is referred to by its catalog id rather than by name when serialized */
+        [[nodiscard]] bool hasTableId() const {
+            return this->schema_ && this->schema_->tableId() != TableSchema::kNoTableId;
+        }
+
+        /** Byte offset of the serialized primary key inside `serialize()`'s output */
+        [[nodiscard]] size_t serializedKeyOffset() const {
+            // magic + total size + table name length prefix or id marker + table name or id
+            return 5 + sizeof(uint64_t) + sizeof(uint16_t) +
+                   (this->hasTableId() ? utility::varintLength(this->schema_->tableId()) : this->tableName.size());
+        }
+
+        /**
+         * Decodes a serialized entry, see EntryView to read one in place without materializing it.
+         *
+         * @param schemas The registry of the database the entry was written to.
+         * @return std::nullopt, logged, if the entry is malformed, fails its checksum or its table's
+         *         schema is not registered.
+         */
+        static std::optional<Entry> deserialize(const std::byte *data, size_t length,
+                                                const SchemaRegistry &schemas = SchemaRegistry::global());
+
+        /**
+         * Reads the timestamp of a serialized entry without decoding it, it sits right before the
+         * trailing checksum. The checksum is not verified.
+         */
+        static uint64_t serializedTimestamp(const std::byte *data, const size_t length) {
+            uint64_t timestamp = 0;
+            for (int i = 0; i < 8; ++i) {
+                timestamp |= static_cast<uint64_t>(data[length - 12 + i]) << (i * 8);
+            }
+
+            return timestamp;
+        }
+
+        /**
+         * Reads the tombstone flag of a serialized entry without decoding it, it sits right before
+         * the timestamp.
+         */
+        static bool serializedTombstone(const std::byte *data, const size_t length) {
+            return data[length - 13] != std::byte{0};
+        }
 
         std::string toHex() const;
 
@@ -0,0 +1,296 @@
+//
+// Created by frostzt on 10/17/2026.
+//
+
+#include "entry_view.hpp"
+
+#include <array>
+#include <cstring>
+#include <stdexcept>
+
+#include "lib/utils/byte_parser.hpp"
+#include "lib/utils/crypto_utils.hpp"
+#include "lib/utils/logger.hpp"
+
+namespace core {
+    using datatypes::Field;
+    using datatypes::FieldType;
+
+    namespace {
+        /** Magic bytes and total size */
+        constexpr size_t kHeaderSize = 5 + sizeof(uint64_t);
+
+        /** Tombstone flag, timestamp and checksum */
+        constexpr size_t kTrailerSize = 1 + sizeof(uint64_t) + sizeof(uint32_t);
+
+        uint16_t loadUint16(const std::byte *data, const size_t offset) {
+            return Utility::ByteParser::readUint16(data, offset);
+        }
+
+        uint64_t loadUint64(const std::byte *data) {
+            uint64_t value = 0;
+            for (int i = 0; i < 8; ++i) value |= static_cast<uint64_t>(data[i]) << (i * 8);
+            return value;
+        }
+
+        template<typename T>
+        T load(const std::span<const std::byte> bytes) {
+            if (bytes.size() != sizeof(T)) {
+                throw std::runtime_error("ENTRY: field of " + std::to_string(bytes.size()) + " bytes read as a " +
+                                         std::to_string(sizeof(T)) + " byte value");
+            }
+
+            T value;
+            std::memcpy(&value, bytes.data(), sizeof(T));
+            return value;
+        }
+
+        /** Bounds-checked reads over [offset, limit), every read fails once one has run past the limit */
+        struct Cursor {
+            const std::byte *data;
+            size_t limit;
+            size_t offset;
+            bool ok{true};
+
+            const std::byte *skip(const size_t length) {
+                this->ok = this->ok && this->limit - this->offset >= length;
+                if (!this->ok) return nullptr;
+
+                const std::byte *bytes = this->data + this->offset;
+                this->offset += length;
+                return bytes;
+            }
+
+            uint16_t readUint16() {
+                const std::byte *bytes = this->skip(sizeof(uint16_t));
+                return bytes ? loadUint16(bytes, 0) : 0;
+            }
+
+            uint32_t readVarint32() {
+                if (!this->ok) return 0;
+
+                const auto *begin = reinterpret_cast<const uint8_t *>(this->data + this->offset);
+                utility::StatusCode status;
+                uint32_t value = 0;
+                const uint8_t *end = utility::getVarint32(status, begin, begin + (this->limit - this->offset), value);
+
+                this->ok = end != nullptr;
+                if (this->ok) this->offset += end - begin;
+                return value;
+            }
+
+            /** Skips a field behind its u16 length, checking it decodes */
+            bool skipField() {
+                const uint16_t length = this->readUint16();
+                const std::byte *field = this->skip(length);
+                this->ok = field != nullptr && FieldView::decode(field, length).has_value();
+                return this->ok;
+            }
+        };
+    } // namespace
+
+    std::optional<FieldView> FieldView::decode(const std::byte *data, const size_t length) {
+        if (length < 1 || std::to_integer<uint8_t>(data[0]) > static_cast<uint8_t>(FieldType::Custom)) {
+            return std::nullopt;
+        }
+
+        const auto type = static_cast<FieldType>(data[0]);
+        const size_t valueLength = length - 1;
+        switch (type) {
+            case FieldType::String:
+                if (valueLength < sizeof(uint16_t) || loadUint16(data, 1) != valueLength - sizeof(uint16_t)) {
+                    return std::nullopt;
+                }
+                return FieldView{type, {data + 1 + sizeof(uint16_t), valueLength - sizeof(uint16_t)}};
+            case FieldType::Null:
+                if (valueLength != 0) return std::nullopt;
+                break;
+            default:
+                if (const size_t width = TableSchema::fixedWidth(type); width != 0 && valueLength != width) {
+                    return std::nullopt;
+                }
+        }
+
+        return FieldView{type, {data + 1, valueLength}};
+    }
+
+    int32_t FieldView::asInt32() const { return load<int32_t>(this->bytes_); }
+
+    int64_t FieldView::asInt64() const { return load<int64_t>(this->bytes_); }
+
+    double FieldView::asDouble() const { return load<double>(this->bytes_); }
+
+    bool FieldView::asBool() const { return load<uint8_t>(this->bytes_) != 0; }
+
+    std::chrono::system_clock::time_point FieldView::asTimestamp() const {
+        return std::chrono::system_clock::time_point(std::chrono::nanoseconds(load<int64_t>(this->bytes_)));
+    }
+
+    datatypes::UUID FieldView::asUUID() const {
+        return datatypes::UUID(load<std::array<uint8_t, 16> >(this->bytes_));
+    }
+
+    Field FieldView::toField() const {
+        switch (this->type_) {
+            case FieldType::Null: return Field{std::monostate{}, this->type_, nullptr};
+            case FieldType::String: return Field{std::string(this->asString()), this->type_, nullptr};
+            default: {
+                const auto *descriptor = datatypes::TypeRegistry::get(this->type_);
+                return Field{descriptor->deserialize(this->bytes_.data(), this->bytes_.size()), this->type_, nullptr};
+            }
+        }
+    }
+
+    std::optional<EntryView> EntryView::parse(const std::byte *data, const size_t length, const bool verifyChecksum,
+                                              const SchemaRegistry &schemas) {
+        if (length < Utility::magic.size() || std::memcmp(data, Utility::magic.data(), Utility::magic.size()) != 0) {
+            spdlog::error("ENTRY: invalid magic bytes while entry deserialization: {}",
+                          std::string_view(reinterpret_cast<const char *>(data), std::min(length, Utility::magic.size())));
+            return std::nullopt;
+        }
+
+        // Anything past the entry's own size is not part of it
+        const uint64_t totalSize = length >= kHeaderSize ? loadUint64(data + Utility::magic.size()) : 0;
+        if (totalSize > length || totalSize < kHeaderSize + 3 * sizeof(uint16_t) + kTrailerSize) {
+            spdlog::error("ENTRY: entry of {} bytes does not fit in {}", totalSize, length);
+            return std::nullopt;
+        }
+
+        if (verifyChecksum) {
+            uint32_t expected = 0;
+            std::memcpy(&expected, data + totalSize - sizeof(uint32_t), sizeof(expected));
+            if (const uint32_t actual = Utility::computeCRC32(data, 0, totalSize - sizeof(uint32_t));
+                expected != actual) {
+                spdlog::debug("mismatched checksum while entry deserialization: {} != {}", expected, actual);
+                return std::nullopt;
+            }
+        }
+
+        EntryView view(data, totalSize);
+        Cursor cursor{data, totalSize - kTrailerSize, kHeaderSize};
+
+        if (const uint16_t nameLength = cursor.readUint16(); nameLength == Entry::kTableIdMarker) {
+            view.tableId_ = cursor.readVarint32();
+            if (cursor.ok) view.schema_ = schemas.find(view.tableId_);
+            if (!view.schema_) {
+                spdlog::error("ENTRY: no schema registered for table id {}", view.tableId_);
+                return std::nullopt;
+            }
+
+            view.tableName_ = view.schema_->tableName();
+        } else if (const std::byte *name = cursor.skip(nameLength)) {
+            view.tableName_ = {reinterpret_cast<const char *>(name), nameLength};
+        }
+
+        view.keyOffset_ = cursor.offset;
+        view.keyParts_ = cursor.readUint16();
+        for (uint16_t i = 0; cursor.ok && i < view.keyParts_; ++i) cursor.skipField();
+        view.keyLength_ = cursor.offset - view.keyOffset_;
+
+        if (const uint16_t rowSize = cursor.readUint16(); cursor.ok && rowSize == Entry::kPackedRowMarker) {
+            if (!view.schema_) view.schema_ = schemas.find(view.tableName_);
+            if (!view.schema_) {
+                spdlog::error("ENTRY: no schema registered for the packed row of {}", view.tableName_);
+                return std::nullopt;
+            }
+
+            const uint32_t packedLength = cursor.readVarint32();
+            if (const std::byte *packed = cursor.skip(packedLength)) {
+                try {
+                    view.packed_.emplace(*view.schema_, packed, packedLength);
+                } catch (const std::runtime_error &e) {
+                    spdlog::error("ENTRY: {}", e.what());
+                    return std::nullopt;
+                }
+            }
+        } else {
+            view.rowOffset_ = cursor.offset;
+            view.columns_ = rowSize;
+            for (uint16_t i = 0; cursor.ok && i < rowSize; ++i) {
+                cursor.skip(cursor.readUint16());
+                cursor.skipField();
+            }
+        }
+
+        // The row ends where the trailer begins
+        if (!cursor.ok || cursor.offset != cursor.limit) {
+            spdlog::error("ENTRY: malformed entry of table {}", view.tableName_);
+            return std::nullopt;
+        }
+
+        return view;
+    }
+
+    FieldView EntryView::keyPart(const uint16_t index) const {
+        size_t offset = this->keyOffset_ + sizeof(uint16_t);
+        for (uint16_t i = 0; i < index; ++i) offset += sizeof(uint16_t) + loadUint16(this->data_, offset);
+
+        return *FieldView::decode(this->data_ + offset + sizeof(uint16_t), loadUint16(this->data_, offset));
+    }
+
+    Key EntryView::key() const {
+        std::vector<Field> parts;
+        parts.reserve(this->keyParts_);
+
+        size_t offset = this->keyOffset_ + sizeof(uint16_t);
+        for (uint16_t i = 0; i < this->keyParts_; ++i) {
+            const uint16_t length = loadUint16(this->data_, offset);
+            parts.push_back(FieldView::decode(this->data_ + offset + sizeof(uint16_t), length)->toField());
+            offset += sizeof(uint16_t) + length;
+        }
+
+        return Key{std::move(parts)};
+    }
+
+    std::optional<FieldView> EntryView::column(const std::string_view name) const {
+        if (this->packed_) {
+            const auto id = this->schema_->columnId(name);
+            if (!id || this->packed_->isNull(*id)) return std::nullopt;
+
+            return FieldView{this->schema_->columns()[*id].type, this->packed_->bytes(*id)};
+        }
+
+        size_t offset = this->rowOffset_;
+        for (uint16_t i = 0; i < this->columns_; ++i) {
+            std::string_view columnName;
+            const FieldView value = this->namedColumn(offset, columnName);
+            if (columnName == name) return value;
+        }
+
+        return std::nullopt;
+    }
+
+    FieldView EntryView::namedColumn(size_t &offset, std::string_view &name) const {
+        const uint16_t nameLength = loadUint16(this->data_, offset);
+        name = {reinterpret_cast<const char *>(this->data_ + offset + sizeof(uint16_t)), nameLength};
+        offset += sizeof(uint16_t) + nameLength;
+
+        const uint16_t length = loadUint16(this->data_, offset);
+        const std::byte *field = this->data_ + offset + sizeof(uint16_t);
+        offset += sizeof(uint16_t) + length;
+
+        return *FieldView::decode(field, length);
+    }
+
+    Row EntryView::row() const {
+        Row row;
+        row.reserve(this->packed_ ? this->packed_->storedColumns() : this->columns_);
+        this->forEachColumn([&row](const std::string_view name, const FieldView &value) {
+            row.emplace(std::string(name), value.toField());
+        });
+
+        return row;
+    }
+
+    Entry EntryView::toEntry() const {
+        Entry entry;
+        entry.tableName.assign(this->tableName_);
+        entry.primaryKey_ = this->key();
+        entry.rowData_ = this->row();
+        entry.isTombstone_ = this->isTombstone();
+        entry.timestamp_ = this->timestamp();
+        entry.schema_ = this->schema_;
+
+        return entry;
+    }
+} // namespace core
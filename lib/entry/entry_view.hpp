@@ -0,0 +1,200 @@
+//
+// Created by frostzt on 10/17/2026.
+//
+
+#ifndef ENIGMA_DB_ENTRY_VIEW_HPP
+#define ENIGMA_DB_ENTRY_VIEW_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string_view>
+
+#include "lib/entry/entry.hpp"
+#include "lib/entry/packed_row.hpp"
+
+namespace core {
+    /**
+     * @class FieldView
+     * @brief A field read in place: its type and the bytes holding its value.
+     *
+     * The bytes are laid out like the type's Serializer writes them, except that a string's are only its
+     * characters, without the length prefix; this is also how a packed row stores its columns. The view
+     * does not own its bytes.
+     */
+    class FieldView {
+    public:
+        FieldView(const datatypes::FieldType type, const std::span<const std::byte> bytes)
+            : type_(type), bytes_(bytes) {
+        }
+
+        /**
+         * Reads a field as Field::serialize writes it, a type tag followed by the value.
+         *
+         * @return std::nullopt if the tag is unknown or the value has the wrong size for its type.
+         */
+        static std::optional<FieldView> decode(const std::byte *data, size_t length);
+
+        [[nodiscard]] datatypes::FieldType type() const { return this->type_; }
+
+        [[nodiscard]] std::span<const std::byte> bytes() const { return this->bytes_; }
+
+        [[nodiscard]] bool isNull() const { return this->type_ == datatypes::FieldType::Null; }
+
+        /**
+         * Typed accessors; the field must be of the type read.
+         *
+         * @throw std::runtime_error If the value does not have the size of the type read.
+         */
+        [[nodiscard]] int32_t asInt32() const;
+
+        [[nodiscard]] int64_t asInt64() const;
+
+        [[nodiscard]] double asDouble() const;
+
+        [[nodiscard]] bool asBool() const;
+
+        [[nodiscard]] std::chrono::system_clock::time_point asTimestamp() const;
+
+        [[nodiscard]] datatypes::UUID asUUID() const;
+
+        [[nodiscard]] std::string_view asString() const {
+            return {reinterpret_cast<const char *>(this->bytes_.data()), this->bytes_.size()};
+        }
+
+        [[nodiscard]] std::span<const std::byte> asBinary() const { return this->bytes_; }
+
+        /** Materializes the field, custom types are decoded by their registered descriptor */
+        [[nodiscard]] datatypes::Field toField() const;
+
+    private:
+        datatypes::FieldType type_;
+        std::span<const std::byte> bytes_;
+    };
+
+    /**
+     * @class EntryView
+     * @brief Reads a serialized entry in place, decoding only what is asked for.
+     *
+     * parse() checks the framing and walks the lengths of the key parts and columns once, after which
+     * every accessor stays within the entry. The table name, key and columns come back as views into the
+     * entry's bytes, so reading the timestamp, the key or a single column neither copies nor allocates;
+     * only key(), row() and toEntry() materialize. Entry::deserialize is built on top of it.
+     *
+     * Like Entry::deserialize, parsing resolves a table id or a packed row's schema through a
+     * SchemaRegistry, and the view keeps that schema alive. It does not own the entry's bytes, which must
+     * outlive it.
+     */
+    class EntryView {
+    public:
+        /**
+         * Parses the entry at the start of `data`.
+         *
+         * @param verifyChecksum Whether to check the entry's CRC32; bytes that were already checksummed as
+         *                       a whole, like SSTable blocks, need not be checked again.
+         * @param schemas The registry of the database the entry was written to.
+         * @return std::nullopt, logged, if the bytes are not a well-formed entry or its table's schema is
+         *         not registered.
+         */
+        static std::optional<EntryView> parse(const std::byte *data, size_t length, bool verifyChecksum = true,
+                                              const SchemaRegistry &schemas = SchemaRegistry::global());
+
+        static std::optional<EntryView> parse(const std::string_view data, const bool verifyChecksum = true,
+                                              const SchemaRegistry &schemas = SchemaRegistry::global()) {
+            return parse(reinterpret_cast<const std::byte *>(data.data()), data.size(), verifyChecksum, schemas);
+        }
+
+        /** The serialized entry, from its magic bytes to its checksum */
+        [[nodiscard]] std::span<const std::byte> bytes() const { return {this->data_, this->length_}; }
+
+        [[nodiscard]] std::string_view tableName() const { return this->tableName_; }
+
+        /** The catalog id the entry refers to its table by, TableSchema::kNoTableId if it names it */
+        [[nodiscard]] uint32_t tableId() const { return this->tableId_; }
+
+        /** The schema of a table id or packed row, nullptr for an entry using the legacy encoding */
+        [[nodiscard]] const std::shared_ptr<const TableSchema> &schema() const { return this->schema_; }
+
+        [[nodiscard]] uint64_t timestamp() const { return Entry::serializedTimestamp(this->data_, this->length_); }
+
+        [[nodiscard]] bool isTombstone() const { return Entry::serializedTombstone(this->data_, this->length_); }
+
+        /** The primary key as ByteParser::writeKey lays it out */
+        [[nodiscard]] std::span<const std::byte> keyBytes() const {
+            return {this->data_ + this->keyOffset_, this->keyLength_};
+        }
+
+        [[nodiscard]] uint16_t keyPartCount() const { return this->keyParts_; }
+
+        [[nodiscard]] FieldView keyPart(uint16_t index) const;
+
+        /** Materializes the primary key */
+        [[nodiscard]] Key key() const;
+
+        /** The packed row, std::nullopt for a row of named columns */
+        [[nodiscard]] const std::optional<PackedRowView> &packedRow() const { return this->packed_; }
+
+        /** Column `name`, std::nullopt if the row does not hold it; a packed row holds no null columns */
+        [[nodiscard]] std::optional<FieldView> column(std::string_view name) const;
+
+        /** Calls fn(std::string_view name, const FieldView &value) for every column the row holds */
+        template<typename Fn>
+        void forEachColumn(Fn &&fn) const {
+            if (this->packed_) {
+                for (uint16_t id = 0; id < this->packed_->storedColumns(); ++id) {
+                    if (this->packed_->isNull(id)) continue;
+
+                    const auto &column = this->schema_->columns()[id];
+                    fn(std::string_view(column.name), FieldView{column.type, this->packed_->bytes(id)});
+                }
+                return;
+            }
+
+            size_t offset = this->rowOffset_;
+            for (uint16_t i = 0; i < this->columns_; ++i) {
+                std::string_view name;
+                const FieldView value = this->namedColumn(offset, name);
+                fn(name, value);
+            }
+        }
+
+        /** Materializes the row */
+        [[nodiscard]] Row row() const;
+
+        /**
+         * Materializes the whole entry.
+         *
+         * @throw std::runtime_error If a custom field fails to decode.
+         */
+        [[nodiscard]] Entry toEntry() const;
+
+    private:
+        EntryView(const std::byte *data, const size_t length): data_(data), length_(length) {
+        }
+
+        const std::byte *data_;
+        size_t length_;
+
+        std::string_view tableName_;
+        uint32_t tableId_{TableSchema::kNoTableId};
+        std::shared_ptr<const TableSchema> schema_;
+
+        size_t keyOffset_{0};
+        size_t keyLength_{0};
+        uint16_t keyParts_{0};
+
+        /** A row of named columns: where its first column starts and how many there are */
+        size_t rowOffset_{0};
+        uint16_t columns_{0};
+
+        std::optional<PackedRowView> packed_;
+
+        /** Reads the named column at `offset` into `name` and the returned value, moving `offset` past it */
+        FieldView namedColumn(size_t &offset, std::string_view &name) const;
+    };
+} // namespace core
+
+#endif //ENIGMA_DB_ENTRY_VIEW_HPP
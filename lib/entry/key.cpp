@@ -4,6 +4,13 @@
 
 #include "key.hpp"
 
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+
+#include "lib/utils/byte_parser.hpp"
+
 namespace core {
     inline Key buildKeyFromRow(const std::vector<std::string>& pkCols, const Row& row) {
         std::vector<datatypes::Field> keyParts;
@@ -15,4 +22,187 @@ namespace core {
 
         return Key{std::move(keyParts)};
     }
+
+    namespace {
+        using datatypes::FieldType;
+
+        constexpr auto kEscape = std::byte{0x00};
+        constexpr auto kEscapedZero = std::byte{0xFF};
+        constexpr auto kTerminator = std::byte{0x01};
+
+        void putBigEndian(std::vector<std::byte> &out, const uint64_t value, const size_t width) {
+            for (size_t i = width; i-- > 0;) out.push_back(static_cast<std::byte>(value >> 8 * i));
+        }
+
+        uint64_t getBigEndian(const std::byte *&data, const std::byte *limit, const size_t width) {
+            if (static_cast<size_t>(limit - data) < width) throw std::runtime_error("KEY: truncated ordered key");
+
+            uint64_t value = 0;
+            for (size_t i = 0; i < width; ++i) value = value << 8 | std::to_integer<uint64_t>(data[i]);
+            data += width;
+            return value;
+        }
+
+        /** Flips the sign bit so two's complement orders like unsigned big-endian bytes */
+        template<typename V>
+        void putSigned(std::vector<std::byte> &out, const V value) {
+            using U = std::make_unsigned_t<V>;
+            putBigEndian(out, static_cast<U>(value) ^ (U{1} << (sizeof(V) * 8 - 1)), sizeof(V));
+        }
+
+        template<typename V>
+        V getSigned(const std::byte *&data, const std::byte *limit) {
+            using U = std::make_unsigned_t<V>;
+            return static_cast<V>(static_cast<U>(getBigEndian(data, limit, sizeof(V))) ^ (U{1} << (sizeof(V) * 8 - 1)));
+        }
+
+        void putDouble(std::vector<std::byte> &out, double value) {
+            // -0.0 == 0.0, they must encode the same
+            if (value == 0.0) value = 0.0;
+
+            uint64_t bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+            bits = bits >> 63 ? ~bits : bits | 1ULL << 63;
+            putBigEndian(out, bits, sizeof(bits));
+        }
+
+        double getDouble(const std::byte *&data, const std::byte *limit) {
+            uint64_t bits = getBigEndian(data, limit, sizeof(uint64_t));
+            bits = bits >> 63 ? bits & ~(1ULL << 63) : ~bits;
+
+            double value;
+            std::memcpy(&value, &bits, sizeof(value));
+            return value;
+        }
+
+        void putEscaped(std::vector<std::byte> &out, const uint8_t *data, const size_t length) {
+            for (size_t i = 0; i < length; ++i) {
+                out.push_back(static_cast<std::byte>(data[i]));
+                if (data[i] == 0) out.push_back(kEscapedZero);
+            }
+
+            out.push_back(kEscape);
+            out.push_back(kTerminator);
+        }
+
+        std::vector<uint8_t> getEscaped(const std::byte *&data, const std::byte *limit) {
+            std::vector<uint8_t> bytes;
+            while (true) {
+                if (limit - data < 1) throw std::runtime_error("KEY: unterminated string in ordered key");
+
+                const std::byte b = *data++;
+                if (b != kEscape) {
+                    bytes.push_back(std::to_integer<uint8_t>(b));
+                    continue;
+                }
+
+                if (limit - data < 1) throw std::runtime_error("KEY: unterminated string in ordered key");
+                const std::byte next = *data++;
+                if (next == kTerminator) return bytes;
+                if (next != kEscapedZero) throw std::runtime_error("KEY: malformed escape in ordered key");
+                bytes.push_back(0);
+            }
+        }
+
+        void encodeField(std::vector<std::byte> &out, const datatypes::Field &field) {
+            out.push_back(static_cast<std::byte>(field.type_));
+
+            switch (field.type_) {
+                case FieldType::Int32: putSigned(out, std::get<int32_t>(field.value_));
+                    break;
+                case FieldType::Int64: putSigned(out, std::get<int64_t>(field.value_));
+                    break;
+                case FieldType::Timestamp: {
+                    const auto &tp = std::get<std::chrono::system_clock::time_point>(field.value_);
+                    putSigned(out, static_cast<int64_t>(
+                                  std::chrono::duration_cast<std::chrono::nanoseconds>(tp.time_since_epoch()).count()));
+                    break;
+                }
+                case FieldType::Double: putDouble(out, std::get<double>(field.value_));
+                    break;
+                case FieldType::Bool: out.push_back(std::byte{std::get<bool>(field.value_) ? uint8_t{1} : uint8_t{0}});
+                    break;
+                case FieldType::String: {
+                    const auto &value = std::get<std::string>(field.value_);
+                    putEscaped(out, reinterpret_cast<const uint8_t *>(value.data()), value.size());
+                    break;
+                }
+                case FieldType::Binary: {
+                    const auto &value = std::get<std::vector<uint8_t> >(field.value_);
+                    putEscaped(out, value.data(), value.size());
+                    break;
+                }
+                case FieldType::UUID: {
+                    const auto &value = std::get<datatypes::UUID>(field.value_)._value;
+                    out.insert(out.end(), reinterpret_cast<const std::byte *>(value.data()),
+                               reinterpret_cast<const std::byte *>(value.data() + value.size()));
+                    break;
+                }
+                case FieldType::Null: break;
+                default: throw std::runtime_error("KEY: custom types have no ordered encoding");
+            }
+        }
+
+        datatypes::Field decodeField(const std::byte *&data, const std::byte *limit) {
+            const auto type = static_cast<FieldType>(*data++);
+
+            switch (type) {
+                case FieldType::Int32: return {getSigned<int32_t>(data, limit), type, nullptr};
+                case FieldType::Int64: return {getSigned<int64_t>(data, limit), type, nullptr};
+                case FieldType::Timestamp:
+                    return {
+                        std::chrono::system_clock::time_point(std::chrono::nanoseconds(getSigned<int64_t>(data, limit))),
+                        type, nullptr
+                    };
+                case FieldType::Double: return {getDouble(data, limit), type, nullptr};
+                case FieldType::Bool: return {getBigEndian(data, limit, 1) != 0, type, nullptr};
+                case FieldType::String: {
+                    const auto bytes = getEscaped(data, limit);
+                    return {std::string(bytes.begin(), bytes.end()), type, nullptr};
+                }
+                case FieldType::Binary: return {getEscaped(data, limit), type, nullptr};
+                case FieldType::UUID: {
+                    if (limit - data < 16) throw std::runtime_error("KEY: truncated ordered key");
+
+                    std::array<uint8_t, 16> uuid{};
+                    std::memcpy(uuid.data(), data, uuid.size());
+                    data += uuid.size();
+                    return {datatypes::UUID{uuid}, type, nullptr};
+                }
+                case FieldType::Null: return {std::monostate{}, type, nullptr};
+                default: throw std::runtime_error("KEY: unknown field type in ordered key");
+            }
+        }
+    } // namespace
+
+    void Key::encodeOrdered(std::vector<std::byte> &out) const {
+        for (const auto &part: this->parts_) encodeField(out, part);
+    }
+
+    std::string Key::orderedBytes() const {
+        thread_local std::vector<std::byte> scratch;
+        scratch.clear();
+        this->encodeOrdered(scratch);
+        return {reinterpret_cast<const char *>(scratch.data()), scratch.size()};
+    }
+
+    Key Key::decodeOrdered(const std::byte *data, const size_t length) {
+        const std::byte *limit = data + length;
+
+        std::vector<datatypes::Field> parts;
+        while (data < limit) parts.push_back(decodeField(data, limit));
+
+        return Key{std::move(parts)};
+    }
+
+    size_t Key::encodedLength(const std::byte *data) {
+        const uint16_t count = Utility::ByteParser::readUint16(data, 0);
+
+        size_t offset = 2;
+        for (uint16_t i = 0; i < count; ++i) {
+            offset += 2 + Utility::ByteParser::readUint16(data, offset);
+        }
+
+        return offset;
+    }
 } // namespace core
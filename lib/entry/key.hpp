@@ -8,6 +8,7 @@
 #include <iostream>
 #include <vector>
 #include <sstream>
+#include <string_view>
 
 #include "core_constants.hpp"
 
@@ -37,6 +38,45 @@ namespace core {
             return parts_ == other.parts_;
         }
 
+        /**
+         * Appends the order-preserving ("memcomparable") encoding of this key to `out`: comparing two
+         * encodings with memcmp, the shorter one first on a tie, orders them like `operator<`.
+         *
+         * Every component is its FieldType tag followed by the value: integers and timestamps
+         * big-endian with the sign bit flipped, doubles big-endian with the sign bit flipped for
+         * positive values and every bit flipped for negative ones, bools as one byte, UUIDs as their
+         * 16 raw bytes, strings and binaries with every 0x00 escaped as 0x00 0xFF and terminated by
+         * 0x00 0x01. Nulls are the tag alone. No component is a prefix of another, so comparing
+         * whole keys compares them component by component.
+         *
+         * @throw std::runtime_error If a component is of a custom type, which has no such encoding.
+         */
+        void encodeOrdered(std::vector<std::byte> &out) const;
+
+        /** Same as encodeOrdered(), returned as the string SSTables and filters key on */
+        [[nodiscard]] std::string orderedBytes() const;
+
+        /**
+         * Decodes a key written by encodeOrdered().
+         *
+         * @throw std::runtime_error If the bytes are truncated or malformed.
+         */
+        static Key decodeOrdered(const std::byte *data, size_t length);
+
+        /**
+         * Three-way comparison of two keys in their encodeOrdered() form, a single memcmp.
+         *
+         * @return A negative value, zero or a positive value if `lhs` sorts before, equal to or after `rhs`.
+         */
+        static int compareOrdered(const std::string_view lhs, const std::string_view rhs) {
+            return lhs.compare(rhs);
+        }
+
+        /**
+         * Returns the number of bytes a serialized key (as written by `ByteParser::writeKey`) occupies.
+         */
+        static size_t encodedLength(const std::byte *data);
+
         [[nodiscard]] std::string toString() const {
             std::ostringstream oss;
             oss << "[";
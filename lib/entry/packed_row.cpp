@@ -0,0 +1,271 @@
+//
+// Created by frostzt on 10/17/2026.
+//
+
+#include "packed_row.hpp"
+
+#include <array>
+#include <cstring>
+#include <stdexcept>
+
+#include "lib/utils/vint/vint.hpp"
+
+namespace core {
+    using datatypes::Field;
+    using datatypes::FieldType;
+
+    namespace {
+        size_t bitmapBytes(const size_t columns) { return (columns + 7) / 8; }
+
+        template<typename T>
+        T load(const std::byte *data) {
+            T value;
+            std::memcpy(&value, data, sizeof(T));
+            return value;
+        }
+
+        template<typename T>
+        void store(std::byte *data, const T &value) { std::memcpy(data, &value, sizeof(T)); }
+
+        /**
+         * The field of `row` packed into column `id`, nullptr when null or absent. Counts the fields of
+         * `row` it finds in `matched`, so the caller can tell whether `row` holds columns the schema lacks
+         * without a lookup per field of `row`.
+         */
+        const Field *columnField(const TableSchema &schema, const Row &row, const uint16_t id, size_t &matched) {
+            if (row.empty()) return nullptr;
+
+            const auto &column = schema.columns()[id];
+            const auto it = row.find(column.name);
+            if (it == row.end()) return nullptr;
+
+            ++matched;
+            if (it->second.isNull()) return nullptr;
+            if (it->second.type_ != column.type) {
+                throw std::runtime_error("ROW: value of " + schema.tableName() + "." + column.name +
+                                         " does not match the column type");
+            }
+
+            return &it->second;
+        }
+
+        /** Throws for the first column of `row` the schema does not have, if any */
+        void rejectUnknownColumns(const TableSchema &schema, const Row &row) {
+            for (const auto &[name, field]: row) {
+                if (!schema.columnId(name)) throw std::runtime_error("ROW: " + schema.tableName() + " has no column " + name);
+            }
+        }
+
+        size_t varLength(const Field &field) {
+            if (field.type_ == FieldType::String) return std::get<std::string>(field.value_).size();
+            return std::get<std::vector<uint8_t> >(field.value_).size();
+        }
+
+        /** Bytes between the column count and the var data */
+        size_t sectionsSize(const TableSchema &schema, const size_t columns) {
+            return bitmapBytes(columns) + schema.fixedBytes(columns) + sizeof(uint32_t) * schema.varColumns(columns);
+        }
+
+        size_t headerSize(const TableSchema &schema, const size_t columns) {
+            return utility::varintLength(columns) + sectionsSize(schema, columns);
+        }
+    } // namespace
+
+    size_t packedRowSize(const TableSchema &schema, const Row &row) {
+        const size_t columns = schema.columnCount();
+
+        size_t size = headerSize(schema, columns);
+        size_t matched = 0;
+        for (uint16_t id = 0; id < columns; ++id) {
+            const Field *field = columnField(schema, row, id, matched);
+            if (field && TableSchema::fixedWidth(field->type_) == 0) size += varLength(*field);
+        }
+
+        if (matched != row.size()) rejectUnknownColumns(schema, row);
+        return size;
+    }
+
+    void encodePackedRow(const TableSchema &schema, const Row &row, std::vector<std::byte> &out) {
+        const size_t start = out.size();
+        out.resize(start + packedRowSize(schema, row));
+        encodePackedRow(schema, row, out.data() + start);
+    }
+
+    std::byte *encodePackedRow(const TableSchema &schema, const Row &row, std::byte *out) {
+        const size_t columns = schema.columnCount();
+
+        auto *bitmap = reinterpret_cast<std::byte *>(
+            utility::encodeVarint32(reinterpret_cast<uint8_t *>(out), static_cast<uint32_t>(columns)));
+        std::byte *fixed = bitmap + bitmapBytes(columns);
+        std::byte *offsets = fixed + schema.fixedBytes(columns);
+        std::byte *var = offsets + sizeof(uint32_t) * schema.varColumns(columns);
+
+        // Null columns leave their bit set and their fixed slot zeroed
+        std::memset(bitmap, 0, fixed + schema.fixedBytes(columns) - bitmap);
+
+        uint32_t varEnd = 0;
+        size_t matched = 0;
+        for (uint16_t id = 0; id < columns; ++id) {
+            const Field *field = columnField(schema, row, id, matched);
+            const FieldType type = schema.columns()[id].type;
+
+            if (!field) bitmap[id / 8] |= std::byte{static_cast<uint8_t>(1u << (id % 8))};
+
+            if (TableSchema::fixedWidth(type) == 0) {
+                if (field) {
+                    const size_t length = varLength(*field);
+                    const void *source = type == FieldType::String
+                                             ? static_cast<const void *>(std::get<std::string>(field->value_).data())
+                                             : std::get<std::vector<uint8_t> >(field->value_).data();
+                    if (length) std::memcpy(var + varEnd, source, length);
+                    varEnd += static_cast<uint32_t>(length);
+                }
+
+                store(offsets + sizeof(uint32_t) * schema.varIndex(id), varEnd);
+                continue;
+            }
+
+            if (!field) continue;
+
+            std::byte *slot = fixed + schema.fixedOffset(id);
+            switch (type) {
+                case FieldType::Int32: store(slot, std::get<int32_t>(field->value_));
+                    break;
+                case FieldType::Int64: store(slot, std::get<int64_t>(field->value_));
+                    break;
+                case FieldType::Double: store(slot, std::get<double>(field->value_));
+                    break;
+                case FieldType::Bool: store(slot, static_cast<uint8_t>(std::get<bool>(field->value_)));
+                    break;
+                case FieldType::Timestamp: {
+                    const auto timePoint = std::get<std::chrono::system_clock::time_point>(field->value_);
+                    store(slot, static_cast<int64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        timePoint.time_since_epoch()).count()));
+                    break;
+                }
+                case FieldType::UUID: std::memcpy(slot, std::get<datatypes::UUID>(field->value_)._value.data(), 16);
+                    break;
+                default: break;
+            }
+        }
+
+        if (matched != row.size()) rejectUnknownColumns(schema, row);
+        return var + varEnd;
+    }
+
+    PackedRowView::PackedRowView(const TableSchema &schema, const std::byte *data, const size_t length)
+        : schema_(&schema) {
+        const auto *begin = reinterpret_cast<const uint8_t *>(data);
+        utility::StatusCode status;
+        uint32_t columns = 0;
+        const uint8_t *end = utility::getVarint32(status, begin, begin + length, columns);
+        if (end == nullptr) throw std::runtime_error("ROW: truncated packed row");
+
+        if (columns > schema.columnCount()) {
+            throw std::runtime_error("ROW: packed row of " + schema.tableName() + " has " +
+                                     std::to_string(columns) + " columns, the schema " +
+                                     std::to_string(schema.columnCount()));
+        }
+        this->columns_ = static_cast<uint16_t>(columns);
+        this->bitmap_ = reinterpret_cast<const std::byte *>(end);
+
+        const size_t header = (end - begin) + sectionsSize(schema, this->columns_);
+        if (length < header) throw std::runtime_error("ROW: truncated packed row");
+
+        this->fixed_ = this->bitmap_ + bitmapBytes(this->columns_);
+        this->offsets_ = this->fixed_ + schema.fixedBytes(this->columns_);
+        this->var_ = data + header;
+
+        uint32_t previous = 0;
+        for (uint32_t i = 0; i < schema.varColumns(this->columns_); ++i) {
+            const auto varEnd = load<uint32_t>(this->offsets_ + sizeof(uint32_t) * i);
+            if (varEnd < previous || varEnd > length - header) throw std::runtime_error("ROW: corrupted var offsets");
+            previous = varEnd;
+        }
+    }
+
+    bool PackedRowView::isNull(const uint16_t id) const {
+        if (id >= this->columns_) return true;
+
+        const auto bits = static_cast<uint8_t>(this->bitmap_[id / 8]);
+        return (bits >> (id % 8)) & 1u;
+    }
+
+    int32_t PackedRowView::getInt32(const uint16_t id) const { return load<int32_t>(this->fixedSlot(id)); }
+
+    int64_t PackedRowView::getInt64(const uint16_t id) const { return load<int64_t>(this->fixedSlot(id)); }
+
+    double PackedRowView::getDouble(const uint16_t id) const { return load<double>(this->fixedSlot(id)); }
+
+    bool PackedRowView::getBool(const uint16_t id) const { return load<uint8_t>(this->fixedSlot(id)) != 0; }
+
+    std::chrono::system_clock::time_point PackedRowView::getTimestamp(const uint16_t id) const {
+        return std::chrono::system_clock::time_point(std::chrono::nanoseconds(load<int64_t>(this->fixedSlot(id))));
+    }
+
+    datatypes::UUID PackedRowView::getUUID(const uint16_t id) const {
+        std::array<uint8_t, 16> bytes{};
+        std::memcpy(bytes.data(), this->fixedSlot(id), bytes.size());
+        return datatypes::UUID(bytes);
+    }
+
+    std::string_view PackedRowView::getString(const uint16_t id) const {
+        const auto bytes = this->varSlot(id);
+        return {reinterpret_cast<const char *>(bytes.data()), bytes.size()};
+    }
+
+    std::span<const std::byte> PackedRowView::getBinary(const uint16_t id) const { return this->varSlot(id); }
+
+    std::span<const std::byte> PackedRowView::bytes(const uint16_t id) const {
+        const size_t width = TableSchema::fixedWidth(this->schema_->columns()[id].type);
+        if (width == 0) return this->varSlot(id);
+
+        return {this->fixedSlot(id), width};
+    }
+
+    std::span<const std::byte> PackedRowView::varSlot(const uint16_t id) const {
+        const uint32_t index = this->schema_->varIndex(id);
+        const uint32_t begin = index == 0 ? 0 : load<uint32_t>(this->offsets_ + sizeof(uint32_t) * (index - 1));
+        const uint32_t end = load<uint32_t>(this->offsets_ + sizeof(uint32_t) * index);
+
+        return {this->var_ + begin, end - begin};
+    }
+
+    std::optional<Field> PackedRowView::field(const uint16_t id) const {
+        if (this->isNull(id)) return std::nullopt;
+
+        const FieldType type = this->schema_->columns()[id].type;
+        switch (type) {
+            case FieldType::Int32: return Field{this->getInt32(id), type, nullptr};
+            case FieldType::Int64: return Field{this->getInt64(id), type, nullptr};
+            case FieldType::Double: return Field{this->getDouble(id), type, nullptr};
+            case FieldType::Bool: return Field{this->getBool(id), type, nullptr};
+            case FieldType::Timestamp: return Field{this->getTimestamp(id), type, nullptr};
+            case FieldType::UUID: return Field{this->getUUID(id), type, nullptr};
+            case FieldType::String: return Field{std::string(this->getString(id)), type, nullptr};
+            case FieldType::Binary: {
+                const auto bytes = this->getBinary(id);
+                const auto *begin = reinterpret_cast<const uint8_t *>(bytes.data());
+                return Field{std::vector<uint8_t>(begin, begin + bytes.size()), type, nullptr};
+            }
+            default: return std::nullopt;
+        }
+    }
+
+    std::optional<Field> PackedRowView::field(const std::string_view name) const {
+        const auto id = this->schema_->columnId(name);
+        if (!id) return std::nullopt;
+
+        return this->field(*id);
+    }
+
+    Row PackedRowView::toRow() const {
+        Row row;
+        row.reserve(this->columns_);
+        for (uint16_t id = 0; id < this->columns_; ++id) {
+            if (auto value = this->field(id)) row.emplace(this->schema_->columns()[id].name, std::move(*value));
+        }
+
+        return row;
+    }
+} // namespace core
@@ -0,0 +1,118 @@
+//
+// Created by frostzt on 10/17/2026.
+//
+
+#ifndef ENIGMA_DB_PACKED_ROW_HPP
+#define ENIGMA_DB_PACKED_ROW_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include "lib/entry/core_constants.hpp"
+#include "lib/entry/schema.hpp"
+
+namespace core {
+    /**
+     * Appends `row` packed against `schema` to `out`:
+     *
+     *   [varint columns][null bitmap][fixed section][u32 var end offsets][var data]
+     *
+     * `columns` is the schema's column count at the time of writing, columns are otherwise only
+     * referred to by their id, i.e. their position. Bit i of the null bitmap
+     * (ceil(columns / 8) bytes, LSB first) is set when column i is null or absent from `row`. Every
+     * fixed-width column has its slot in the fixed section, zeroed when null; the end offset of each
+     * variable-width column is relative to the start of the var data, a null one is empty. Values are
+     * stored like their ScalarSerializer does, host byte order and timestamps as int64 nanoseconds.
+     *
+     * Unlike Entry's legacy row encoding no column name or per-field length is stored, and a field is
+     * read straight from its slot by PackedRowView.
+     *
+     * @throw std::runtime_error If `row` holds a column the schema does not have or a value whose type
+     *                           differs from its column's.
+     */
+    void encodePackedRow(const TableSchema &schema, const Row &row, std::vector<std::byte> &out);
+
+    /**
+     * Writes `row` packed against `schema` to `out`, which must have room for packedRowSize() bytes;
+     * nothing is allocated.
+     *
+     * @return A pointer one past the last byte written.
+     * @throw std::runtime_error Like the appending overload.
+     */
+    std::byte *encodePackedRow(const TableSchema &schema, const Row &row, std::byte *out);
+
+    /** Bytes encodePackedRow writes for `row`, same preconditions */
+    size_t packedRowSize(const TableSchema &schema, const Row &row);
+
+    /**
+     * @class PackedRowView
+     * @brief Reads the fields of a packed row in place, without materializing a Row.
+     *
+     * The view does not own its bytes; they must outlive it. `schema` may have gained columns since the
+     * row was packed, those read as null.
+     */
+    class PackedRowView {
+    public:
+        /**
+         * @throw std::runtime_error If `length` bytes cannot hold the row's header and offsets, or its
+         *                           var data runs past them.
+         */
+        PackedRowView(const TableSchema &schema, const std::byte *data, size_t length);
+
+        [[nodiscard]] const TableSchema &schema() const { return *this->schema_; }
+
+        /** Columns the row was packed with */
+        [[nodiscard]] uint16_t storedColumns() const { return this->columns_; }
+
+        [[nodiscard]] bool isNull(uint16_t id) const;
+
+        /** Typed accessors; the column must be of the type read and not null */
+        [[nodiscard]] int32_t getInt32(uint16_t id) const;
+
+        [[nodiscard]] int64_t getInt64(uint16_t id) const;
+
+        [[nodiscard]] double getDouble(uint16_t id) const;
+
+        [[nodiscard]] bool getBool(uint16_t id) const;
+
+        [[nodiscard]] std::chrono::system_clock::time_point getTimestamp(uint16_t id) const;
+
+        [[nodiscard]] datatypes::UUID getUUID(uint16_t id) const;
+
+        [[nodiscard]] std::string_view getString(uint16_t id) const;
+
+        [[nodiscard]] std::span<const std::byte> getBinary(uint16_t id) const;
+
+        /** The bytes column `id` is stored in, its fixed slot or its var data; the column must not be null */
+        [[nodiscard]] std::span<const std::byte> bytes(uint16_t id) const;
+
+        /** Column `id` as a Field, std::nullopt when null */
+        [[nodiscard]] std::optional<datatypes::Field> field(uint16_t id) const;
+
+        /** Column `name` as a Field, std::nullopt when null or not a column of the schema */
+        [[nodiscard]] std::optional<datatypes::Field> field(std::string_view name) const;
+
+        /** Materializes the non-null columns */
+        [[nodiscard]] Row toRow() const;
+
+    private:
+        const TableSchema *schema_;
+        uint16_t columns_{0};
+
+        const std::byte *bitmap_{nullptr};
+        const std::byte *fixed_{nullptr};
+        const std::byte *offsets_{nullptr};
+        const std::byte *var_{nullptr};
+
+        [[nodiscard]] const std::byte *fixedSlot(uint16_t id) const { return this->fixed_ + this->schema_->fixedOffset(id); }
+
+        [[nodiscard]] std::span<const std::byte> varSlot(uint16_t id) const;
+    };
+} // namespace core
+
+#endif //ENIGMA_DB_PACKED_ROW_HPP
@@ -0,0 +1,117 @@
+//
+// Created by frostzt on 10/17/2026.
+//
+
+#include "schema.hpp"
+
+#include <mutex>
+#include <stdexcept>
+
+namespace core {
+    using datatypes::FieldType;
+
+    TableSchema::TableSchema(std::string tableName, std::vector<ColumnSchema> columns, const uint32_t tableId)
+        : tableName_(std::move(tableName)), columns_(std::move(columns)), tableId_(tableId) {
+        if (this->columns_.size() > UINT16_MAX) {
+            throw std::invalid_argument("SCHEMA: " + this->tableName_ + " has more than 65535 columns");
+        }
+
+        this->slots_.reserve(this->columns_.size());
+        this->fixedBytes_.assign(1, 0);
+        this->varColumns_.assign(1, 0);
+
+        for (size_t id = 0; id < this->columns_.size(); ++id) {
+            const auto &[name, type] = this->columns_[id];
+            if (type == FieldType::Null || type == FieldType::Custom) {
+                throw std::invalid_argument("SCHEMA: column " + name + " of " + this->tableName_ +
+                                            " has no packed representation");
+            }
+            if (!this->ids_.emplace(name, static_cast<uint16_t>(id)).second) {
+                throw std::invalid_argument("SCHEMA: " + this->tableName_ + " has two columns named " + name);
+            }
+
+            const size_t width = fixedWidth(type);
+            this->slots_.push_back(width != 0 ? this->fixedBytes_.back() : this->varColumns_.back());
+            this->fixedBytes_.push_back(this->fixedBytes_.back() + static_cast<uint32_t>(width));
+            this->varColumns_.push_back(this->varColumns_.back() + (width == 0 ? 1 : 0));
+        }
+    }
+
+    std::optional<uint16_t> TableSchema::columnId(const std::string_view name) const {
+        const auto it = this->ids_.find(name);
+        if (it == this->ids_.end()) return std::nullopt;
+
+        return it->second;
+    }
+
+    size_t TableSchema::fixedWidth(const FieldType type) {
+        switch (type) {
+            case FieldType::Bool: return 1;
+            case FieldType::Int32: return 4;
+            case FieldType::Int64:
+            case FieldType::Double:
+            case FieldType::Timestamp: return 8;
+            case FieldType::UUID: return 16;
+            default: return 0;
+        }
+    }
+
+    SchemaRegistry &SchemaRegistry::global() {
+        static SchemaRegistry registry;
+        return registry;
+    }
+
+    void SchemaRegistry::put(std::shared_ptr<const TableSchema> schema) {
+        std::unique_lock lock(this->mutex_);
+        this->checkLocked(*schema);
+
+        if (schema->tableId() != TableSchema::kNoTableId) this->byId_[schema->tableId()] = schema;
+        this->byName_[schema->tableName()] = std::move(schema);
+    }
+
+    void SchemaRegistry::check(const TableSchema &schema) const {
+        std::shared_lock lock(this->mutex_);
+        this->checkLocked(schema);
+    }
+
+    void SchemaRegistry::checkLocked(const TableSchema &schema) const {
+        if (const auto it = this->byName_.find(schema.tableName()); it != this->byName_.end()) {
+            const auto &previous = it->second->columns();
+            const auto &next = schema.columns();
+            bool prefix = previous.size() <= next.size();
+            for (size_t i = 0; prefix && i < previous.size(); ++i) {
+                prefix = previous[i].name == next[i].name && previous[i].type == next[i].type;
+            }
+
+            if (!prefix) {
+                throw std::invalid_argument("SCHEMA: new schema of " + schema.tableName() +
+                                            " does not extend the registered one");
+            }
+            if (it->second->tableId() != schema.tableId()) {
+                throw std::invalid_argument("SCHEMA: new schema of " + schema.tableName() + " changes its table id");
+            }
+        }
+
+        if (schema.tableId() != TableSchema::kNoTableId) {
+            if (const auto it = this->byId_.find(schema.tableId());
+                it != this->byId_.end() && it->second->tableName() != schema.tableName()) {
+                throw std::invalid_argument("SCHEMA: table id " + std::to_string(schema.tableId()) +
+                                            " already belongs to " + it->second->tableName());
+            }
+        }
+    }
+
+    std::shared_ptr<const TableSchema> SchemaRegistry::find(const std::string_view tableName) const {
+        std::shared_lock lock(this->mutex_);
+
+        const auto it = this->byName_.find(tableName);
+        return it == this->byName_.end() ? nullptr : it->second;
+    }
+
+    std::shared_ptr<const TableSchema> SchemaRegistry::find(const uint32_t tableId) const {
+        std::shared_lock lock(this->mutex_);
+
+        const auto it = this->byId_.find(tableId);
+        return it == this->byId_.end() ? nullptr : it->second;
+    }
+} // namespace core
@@ -0,0 +1,161 @@
+//
+// Created by frostzt on 10/17/2026.
+//
+
+#ifndef ENIGMA_DB_SCHEMA_HPP
+#define ENIGMA_DB_SCHEMA_HPP
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "lib/datatypes/field_type.hpp"
+
+namespace core {
+    /** Hashes std::string and std::string_view alike, so the maps below are searched without a copy */
+    struct StringHash {
+        using is_transparent = void;
+
+        size_t operator()(const std::string_view value) const { return std::hash<std::string_view>{}(value); }
+    };
+
+    /** A map keyed by name that is searched with a std::string_view */
+    template<typename T>
+    using NameMap = std::unordered_map<std::string, T, StringHash, std::equal_to<> >;
+
+    /**
+     * @struct ColumnSchema
+     * @brief A column of a table, identified by its position in the table's schema.
+     */
+    struct ColumnSchema {
+        std::string name;
+        datatypes::FieldType type;
+    };
+
+    /**
+     * @class TableSchema
+     * @brief The columns of a table and the packed row layout derived from them.
+     *
+     * A column's id is its index in `columns()`. Columns are only ever appended, so a row packed
+     * under an older version of the schema still reads under a newer one, the columns it does not
+     * know being null. Column types are fixed once added.
+     *
+     * Fixed-width columns (Int32, Int64, Double, Bool, Timestamp, UUID) have a slot at a precomputed
+     * offset of the row's fixed section; variable-width ones (String, Binary) are addressed through
+     * the row's offset array, see PackedRowView.
+     *
+     * A schema handed out by a SchemaCatalog also carries the table's id, which entries write in
+     * place of the table name.
+     */
+    class TableSchema {
+    public:
+        /** Id of a schema that is not part of a catalog */
+        static constexpr uint32_t kNoTableId = 0;
+
+        /**
+         * @throw std::invalid_argument If two columns share a name, a column is of type Null or
+         *                              Custom, or there are more than UINT16_MAX columns.
+         */
+        TableSchema(std::string tableName, std::vector<ColumnSchema> columns, uint32_t tableId = kNoTableId);
+
+        [[nodiscard]] const std::string &tableName() const { return this->tableName_; }
+
+        [[nodiscard]] uint32_t tableId() const { return this->tableId_; }
+
+        [[nodiscard]] const std::vector<ColumnSchema> &columns() const { return this->columns_; }
+
+        [[nodiscard]] size_t columnCount() const { return this->columns_.size(); }
+
+        /** Id of the column named `name`, std::nullopt if the table has no such column */
+        [[nodiscard]] std::optional<uint16_t> columnId(std::string_view name) const;
+
+        /** Width in bytes of a fixed-width type, 0 for String and Binary */
+        static size_t fixedWidth(datatypes::FieldType type);
+
+        /** Offset of column `id`'s slot in the fixed section, only meaningful for fixed-width columns */
+        [[nodiscard]] uint32_t fixedOffset(const uint16_t id) const { return this->slots_[id]; }
+
+        /** Index of column `id` in the offset array, only meaningful for variable-width columns */
+        [[nodiscard]] uint32_t varIndex(const uint16_t id) const { return this->slots_[id]; }
+
+        /** Bytes of the fixed section of a row packed with the first `columns` columns */
+        [[nodiscard]] uint32_t fixedBytes(const size_t columns) const { return this->fixedBytes_[columns]; }
+
+        /** Variable-width columns among the first `columns` columns */
+        [[nodiscard]] uint32_t varColumns(const size_t columns) const { return this->varColumns_[columns]; }
+
+    private:
+        std::string tableName_;
+        std::vector<ColumnSchema> columns_;
+        uint32_t tableId_;
+
+        /** Per column, its fixed section offset or offset array index depending on its type */
+        std::vector<uint32_t> slots_;
+
+        /** Prefix sums over the columns, index i covers the first i columns */
+        std::vector<uint32_t> fixedBytes_;
+        std::vector<uint32_t> varColumns_;
+
+        NameMap<uint16_t> ids_;
+    };
+
+    /**
+     * @class SchemaRegistry
+     * @brief Lookup of the schemas packed rows and table ids were written with, by name and by id.
+     *
+     * Entry::deserialize and EntryView::parse resolve the schema of a packed row or of a table id in a
+     * registry, so a table's schema must be registered before any of its entries are read back. Table
+     * ids are only unique within a database, every SchemaCatalog therefore owns the registry of its
+     * tables and readers of its entries are handed that one. Schemas outside of any catalog go to
+     * global(), which is what readers fall back to when given none. Thread-safe.
+     */
+    class SchemaRegistry {
+    public:
+        SchemaRegistry() = default;
+
+        SchemaRegistry(const SchemaRegistry &) = delete;
+
+        SchemaRegistry &operator=(const SchemaRegistry &) = delete;
+
+        /** The registry of schemas that belong to no catalog */
+        static SchemaRegistry &global();
+
+        /**
+         * Registers `schema`, replacing the one its table had.
+         *
+         * @throw std::invalid_argument Like check(); nothing is registered then.
+         */
+        void put(std::shared_ptr<const TableSchema> schema);
+
+        /**
+         * Checks that put(schema) would succeed, without registering it.
+         *
+         * @throw std::invalid_argument If the replaced schema is not a prefix of `schema`, rows packed
+         *                              with it would no longer read, if it had another table id or if
+         *                              another table holds the id of `schema`.
+         */
+        void check(const TableSchema &schema) const;
+
+        /** The schema of `tableName`, nullptr if none is registered */
+        [[nodiscard]] std::shared_ptr<const TableSchema> find(std::string_view tableName) const;
+
+        /** The schema of the table with id `tableId`, nullptr if none is registered */
+        [[nodiscard]] std::shared_ptr<const TableSchema> find(uint32_t tableId) const;
+
+    private:
+        mutable std::shared_mutex mutex_;
+        NameMap<std::shared_ptr<const TableSchema> > byName_;
+        std::unordered_map<uint32_t, std::shared_ptr<const TableSchema> > byId_;
+
+        /** check() with mutex_ held */
+        void checkLocked(const TableSchema &schema) const;
+    };
+} // namespace core
+
+#endif //ENIGMA_DB_SCHEMA_HPP
@@ -0,0 +1,255 @@
+//
+// Created by frostzt on 10/17/2026.
+//
+
+#include "schema_catalog.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <optional>
+#include <stdexcept>
+
+#include "lib/utils/crypto_utils.hpp"
+#include "lib/utils/vint/vint.hpp"
+#include "lib/wal/wal_codec.hpp"
+#include "lib/wal/wal_segment_reader.hpp"
+#include "spdlog/spdlog.h"
+
+namespace core {
+    namespace {
+        constexpr auto kTempFileName = "CATALOG.tmp";
+
+        struct TableRecord {
+            uint32_t tableId = 0;
+            std::string name;
+            std::vector<ColumnSchema> columns;
+        };
+
+        void putString(std::vector<uint8_t> &out, const std::string &value) {
+            utility::putVarint32(out, static_cast<uint32_t>(value.size()));
+            out.insert(out.end(), value.begin(), value.end());
+        }
+
+        const uint8_t *getString(const uint8_t *data, const uint8_t *limit, std::string &out) {
+            utility::StatusCode status;
+            uint32_t length = 0;
+            data = utility::getVarint32(status, data, limit, length);
+            if (data == nullptr || static_cast<size_t>(limit - data) < length) return nullptr;
+
+            out.assign(reinterpret_cast<const char *>(data), length);
+            return data + length;
+        }
+
+        /**
+         * Appends the framed definition of `schema`:
+         *
+         *   [varint table id][name][varint column count]([name][u8 type])*[crc32]
+         *
+         * every name being a varint length followed by its bytes.
+         */
+        void encodeTable(const TableSchema &schema, std::vector<std::byte> &out) {
+            std::vector<uint8_t> fields;
+            utility::putVarint32(fields, schema.tableId());
+            putString(fields, schema.tableName());
+            utility::putVarint32(fields, static_cast<uint32_t>(schema.columnCount()));
+            for (const auto &[name, type]: schema.columns()) {
+                putString(fields, name);
+                fields.push_back(static_cast<uint8_t>(type));
+            }
+
+            std::vector<std::byte> payload(fields.size() + sizeof(uint32_t));
+            std::memcpy(payload.data(), fields.data(), fields.size());
+            const uint32_t crc = Utility::computeCRC32(payload.data(), 0, fields.size());
+            std::memcpy(payload.data() + fields.size(), &crc, sizeof(crc));
+
+            WAL::encodeFrame(out, payload.data(), static_cast<uint32_t>(payload.size()));
+        }
+
+        std::optional<TableRecord> decodeTable(const std::byte *data, const size_t length) {
+            if (length < sizeof(uint32_t)) return std::nullopt;
+
+            const size_t fieldsLength = length - sizeof(uint32_t);
+            uint32_t crc = 0;
+            std::memcpy(&crc, data + fieldsLength, sizeof(crc));
+            if (Utility::computeCRC32(data, 0, fieldsLength) != crc) return std::nullopt;
+
+            const auto *it = reinterpret_cast<const uint8_t *>(data);
+            const auto *limit = it + fieldsLength;
+
+            TableRecord record;
+            utility::StatusCode status;
+            uint32_t columns = 0;
+            it = utility::getVarint32(status, it, limit, record.tableId);
+            if (it != nullptr) it = getString(it, limit, record.name);
+            if (it != nullptr) it = utility::getVarint32(status, it, limit, columns);
+
+            for (uint32_t i = 0; it != nullptr && i < columns; ++i) {
+                auto &column = record.columns.emplace_back();
+                it = getString(it, limit, column.name);
+                if (it == nullptr || it == limit || *it > static_cast<uint8_t>(datatypes::FieldType::Custom)) {
+                    return std::nullopt;
+                }
+                column.type = static_cast<datatypes::FieldType>(*it++);
+            }
+
+            if (it != limit || record.tableId == TableSchema::kNoTableId) return std::nullopt;
+            return record;
+        }
+    } // namespace
+
+    SchemaCatalog::SchemaCatalog(std::shared_ptr<io_engine::IoEngine> engine, std::string dir)
+        : engine_(std::move(engine)), dir_(std::move(dir)) {
+        std::filesystem::create_directories(this->dir_);
+
+        this->replay();
+        this->writeSnapshot();
+
+        for (const auto &schema: this->tables()) this->schemas_->put(schema);
+    }
+
+    SchemaCatalog::~SchemaCatalog() {
+        if (this->file_.valid()) this->engine_->close(this->file_);
+    }
+
+    std::shared_ptr<const TableSchema> SchemaCatalog::createTable(std::string name, std::vector<ColumnSchema> columns) {
+        std::lock_guard lock(this->mutex_);
+
+        if (this->byName_.contains(name)) throw std::invalid_argument("CATALOG: table " + name + " already exists");
+
+        return this->install(std::make_shared<const TableSchema>(std::move(name), std::move(columns),
+                                                                 this->nextTableId_));
+    }
+
+    std::shared_ptr<const TableSchema> SchemaCatalog::addColumns(const std::string_view name,
+                                                                 std::vector<ColumnSchema> columns) {
+        std::lock_guard lock(this->mutex_);
+
+        const auto it = this->byName_.find(std::string(name));
+        if (it == this->byName_.end()) throw std::invalid_argument("CATALOG: no table " + std::string(name));
+
+        auto merged = it->second->columns();
+        merged.insert(merged.end(), std::make_move_iterator(columns.begin()), std::make_move_iterator(columns.end()));
+
+        return this->install(std::make_shared<const TableSchema>(it->second->tableName(), std::move(merged),
+                                                                 it->second->tableId()));
+    }
+
+    std::shared_ptr<const TableSchema> SchemaCatalog::find(const std::string_view name) const {
+        std::lock_guard lock(this->mutex_);
+
+        const auto it = this->byName_.find(std::string(name));
+        return it == this->byName_.end() ? nullptr : it->second;
+    }
+
+    std::shared_ptr<const TableSchema> SchemaCatalog::find(const uint32_t tableId) const {
+        std::lock_guard lock(this->mutex_);
+
+        const auto it = this->byId_.find(tableId);
+        return it == this->byId_.end() ? nullptr : it->second;
+    }
+
+    std::vector<std::shared_ptr<const TableSchema> > SchemaCatalog::tables() const {
+        std::lock_guard lock(this->mutex_);
+
+        std::vector<std::shared_ptr<const TableSchema> > tables;
+        tables.reserve(this->byId_.size());
+        for (const auto &[id, schema]: this->byId_) tables.push_back(schema);
+
+        std::sort(tables.begin(), tables.end(), [](const auto &lhs, const auto &rhs) {
+            return lhs->tableId() < rhs->tableId();
+        });
+        return tables;
+    }
+
+    void SchemaCatalog::replay() {
+        const auto path = std::filesystem::path(this->dir_) / kFileName;
+        if (!std::filesystem::exists(path)) return;
+
+        WAL::WALSegmentReader catalog(path);
+
+        size_t offset = 0;
+        size_t replayed = 0;
+        const std::byte *payload = nullptr;
+        uint32_t payloadLength = 0;
+        while (WAL::nextFrame(catalog.data(), catalog.size(), offset, payload, payloadLength)) {
+            auto record = decodeTable(payload, payloadLength);
+            if (!record) break;
+            replayed = offset;
+
+            // A later record of a table supersedes the earlier ones, it only ever appends columns
+            auto schema = std::make_shared<const TableSchema>(std::move(record->name), std::move(record->columns),
+                                                              record->tableId);
+            if (const auto previous = this->byId_.find(schema->tableId());
+                previous != this->byId_.end() && previous->second->tableName() != schema->tableName()) {
+                throw std::runtime_error("CATALOG: table id " + std::to_string(schema->tableId()) +
+                                         " names both " + previous->second->tableName() + " and " +
+                                         schema->tableName());
+            }
+
+            this->nextTableId_ = std::max(this->nextTableId_, schema->tableId() + 1);
+            this->byName_[schema->tableName()] = schema;
+            this->byId_[schema->tableId()] = std::move(schema);
+        }
+
+        if (replayed != catalog.size()) {
+            spdlog::warn("CATALOG: ignoring {} bytes of a torn record at the end of {}", catalog.size() - replayed,
+                         path.string());
+        }
+    }
+
+    void SchemaCatalog::writeSnapshot() {
+        const auto dir = std::filesystem::path(this->dir_);
+
+        std::vector<std::byte> records;
+        for (const auto &schema: this->tables()) encodeTable(*schema, records);
+
+        // Swapped in with a rename, a crash leaves either the old or the new CATALOG in place
+        std::filesystem::remove(dir / kTempFileName);
+        const auto temp = this->engine_->openSegment(this->dir_, kTempFileName);
+        const bool written = temp.valid() &&
+                             (records.empty() ||
+                              this->engine_->writeSync(temp, records.data(), records.size()) ==
+                              static_cast<long long>(records.size()));
+        if (temp.valid()) this->engine_->close(temp);
+
+        if (!written) {
+            std::filesystem::remove(dir / kTempFileName);
+            throw std::runtime_error("CATALOG: failed to write " + std::string(kTempFileName));
+        }
+
+        if (this->file_.valid()) this->engine_->close(this->file_);
+        std::filesystem::rename(dir / kTempFileName, dir / kFileName);
+
+        // Until the directory is synced the rename, and with it every table, may not survive a crash
+        if (!io_engine::syncDirectory(this->dir_)) {
+            throw std::runtime_error("CATALOG: failed to sync the directory of " + std::string(kFileName));
+        }
+
+        this->file_ = this->engine_->openSegment(this->dir_, kFileName);
+        if (!this->file_.valid()) throw std::runtime_error("CATALOG: failed to open " + std::string(kFileName));
+    }
+
+    bool SchemaCatalog::append(const TableSchema &schema) const {
+        std::vector<std::byte> record;
+        encodeTable(schema, record);
+
+        return this->engine_->writeSync(this->file_, record.data(), record.size()) ==
+               static_cast<long long>(record.size());
+    }
+
+    std::shared_ptr<const TableSchema> SchemaCatalog::install(std::shared_ptr<const TableSchema> schema) {
+        // A record that could not be registered would fail every later open of the catalog
+        this->schemas_->check(*schema);
+        if (!this->append(*schema)) {
+            throw std::runtime_error("CATALOG: failed to persist table " + schema->tableName());
+        }
+
+        this->schemas_->put(schema);
+
+        this->nextTableId_ = std::max(this->nextTableId_, schema->tableId() + 1);
+        this->byName_[schema->tableName()] = schema;
+        this->byId_[schema->tableId()] = schema;
+        return schema;
+    }
+} // namespace core
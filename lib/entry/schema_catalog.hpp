@@ -0,0 +1,119 @@
+//
+// Created by frostzt on 10/17/2026.
+//
+
+#ifndef ENIGMA_DB_SCHEMA_CATALOG_HPP
+#define ENIGMA_DB_SCHEMA_CATALOG_HPP
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "lib/entry/schema.hpp"
+#include "lib/io/engine.hpp"
+
+namespace core {
+    /**
+     * @class SchemaCatalog
+     * @brief The persisted tables of a database directory, each with a small integer id and its columns.
+     *
+     * Ids are handed out once and never reused, a column's id is its position in the table's schema.
+     * Entries of a table created here refer to it by a varint id instead of its name and pack their
+     * rows against its columns, so the WAL and MemTables no longer repeat either in every record.
+     *
+     * Table ids are only unique within the directory, so the catalog registers its tables in a
+     * SchemaRegistry of its own rather than the global one; the WAL, MemTables and SSTables of the
+     * database read their entries back through schemas().
+     *
+     * Every change is checked against that registry, appended to the CATALOG file of the directory as
+     * a framed record holding the table's full definition, synced, and only then registered and handed
+     * out. Opening the catalog replays the file, ignoring a torn record at its tail, registers every
+     * table and rewrites the file with one record per table.
+     *
+     * Thread-safe.
+     */
+    class SchemaCatalog {
+    public:
+        static constexpr auto kFileName = "CATALOG";
+
+        /**
+         * Opens the catalog of `dir`, creating the directory and an empty catalog if needed.
+         *
+         * @throw std::runtime_error If the CATALOG cannot be rewritten or two of its tables conflict.
+         */
+        SchemaCatalog(std::shared_ptr<io_engine::IoEngine> engine, std::string dir);
+
+        ~SchemaCatalog();
+
+        SchemaCatalog(const SchemaCatalog &) = delete;
+
+        SchemaCatalog &operator=(const SchemaCatalog &) = delete;
+
+        /**
+         * Creates table `name` with `columns` under the next free table id.
+         *
+         * @throw std::invalid_argument If the table exists or the columns are not a valid TableSchema.
+         * @throw std::runtime_error If the table cannot be made durable; the catalog is unchanged.
+         */
+        std::shared_ptr<const TableSchema> createTable(std::string name, std::vector<ColumnSchema> columns);
+
+        /**
+         * Appends `columns` to table `name`, the columns it had keep their ids.
+         *
+         * @throw std::invalid_argument If there is no such table or the result is not a valid TableSchema.
+         * @throw std::runtime_error If the change cannot be made durable; the catalog is unchanged.
+         */
+        std::shared_ptr<const TableSchema> addColumns(std::string_view name, std::vector<ColumnSchema> columns);
+
+        /** The schema of table `name`, nullptr if there is none */
+        [[nodiscard]] std::shared_ptr<const TableSchema> find(std::string_view name) const;
+
+        /** The schema of the table with id `tableId`, nullptr if there is none */
+        [[nodiscard]] std::shared_ptr<const TableSchema> find(uint32_t tableId) const;
+
+        /** Every table, by ascending id */
+        [[nodiscard]] std::vector<std::shared_ptr<const TableSchema> > tables() const;
+
+        /** The registry holding every table, to read the database's entries back with */
+        [[nodiscard]] std::shared_ptr<const SchemaRegistry> schemas() const { return this->schemas_; }
+
+    private:
+        std::shared_ptr<io_engine::IoEngine> engine_;
+        std::string dir_;
+
+        mutable std::mutex mutex_;
+        std::unordered_map<std::string, std::shared_ptr<const TableSchema> > byName_;
+        std::unordered_map<uint32_t, std::shared_ptr<const TableSchema> > byId_;
+        uint32_t nextTableId_{1};
+        std::shared_ptr<SchemaRegistry> schemas_ = std::make_shared<SchemaRegistry>();
+
+        io_engine::SegmentHandle file_;
+
+        /** Replays the CATALOG, if any, into the maps above */
+        void replay();
+
+        /**
+         * Writes every table to a new CATALOG, swapped in with a rename and a sync of the directory, and
+         * opens it for appends.
+         *
+         * @throw std::runtime_error If the new CATALOG cannot be written.
+         */
+        void writeSnapshot();
+
+        /** Appends `schema` to the open CATALOG and syncs it */
+        [[nodiscard]] bool append(const TableSchema &schema) const;
+
+        /**
+         * Checks, persists, registers and installs `schema`, the caller holds mutex_.
+         *
+         * @throw std::invalid_argument If `schema` conflicts with a registered one; nothing is persisted.
+         * @throw std::runtime_error If `schema` cannot be persisted.
+         */
+        std::shared_ptr<const TableSchema> install(std::shared_ptr<const TableSchema> schema);
+    };
+} // namespace core
+
+#endif //ENIGMA_DB_SCHEMA_CATALOG_HPP
@@ -0,0 +1,45 @@
+//
+// Created by frostzt on 10/17/2026.
+//
+
+#include "engine.hpp"
+
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "posix_engine.hpp"
+#include "linux/uring_io_engine.hpp"
+
+namespace io_engine {
+    std::shared_ptr<IoEngine> createIoEngine(const IoEngineType type, const std::size_t preallocateBytes) {
+#ifdef HAS_LIBURING
+        if (type == IoEngineType::Uring) {
+            // The ring can still be refused at runtime, e.g. by an old kernel or a seccomp profile
+            if (auto engine = UringIoEngine::create(preallocateBytes)) return engine;
+        }
+#else
+        (void) type;
+#endif
+
+        return std::make_shared<POSIXEngine>(preallocateBytes);
+    }
+
+    bool syncDirectory(const std::string_view dir) {
+        const std::string path(dir.empty() ? "." : dir);
+
+        int fd;
+        do {
+            fd = ::open(path.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+        } while (fd < 0 && errno == EINTR);
+        if (fd < 0) return false;
+
+        int result;
+        do {
+            result = ::fsync(fd);
+        } while (result != 0 && errno == EINTR);
+
+        ::close(fd);
+        return result == 0;
+    }
+} // namespace io_engine
@@ -6,25 +6,62 @@
 #define ENIGMA_DB_ENGINE_HPP
 
 #include <cstdint>
+#include <memory>
+#include <span>
 #include <string_view>
 #include <string>
 
 namespace io_engine {
     struct SegmentHandle {
         uint64_t id = 0;
+
+        [[nodiscard]] bool valid() const { return this->id != 0; }
+    };
+
+    /**
+     * A positional read submitted through IoEngine::readBatch().
+     */
+    struct ReadRequest {
+        SegmentHandle seg;
+        uint64_t offset = 0;
+        void *buf = nullptr;
+        std::size_t len = 0;
+
+        /** Bytes read (short only at the end of the file), or a negative value on error */
+        long long result = 0;
     };
 
+    /**
+     * Append-oriented file IO used by the storage layer. Segments are files opened for appending,
+     * writes land at the segment's current end and are only durable once flush() returns true.
+     *
+     * Engines may be shared between threads, but a single segment must not be written to from more
+     * than one thread at a time.
+     */
     class IoEngine {
     public:
+        virtual ~IoEngine() = default;
+
         /**
          * Opens a segment file within the specified parent directory and returns a handle to the segment.
          * The segment file is identified by its name, provided in the segmentName parameter.
          *
          * @param parentDir The directory path where the segment resides.
          * @param segmentName The name of the segment to be opened.
-         * @return A handle to the opened segment, encapsulated in a SegmentHandle structure.
+         * @return A handle to the opened segment, encapsulated in a SegmentHandle structure. The handle is
+         *         not valid() if the segment could not be opened.
+         */
+        virtual SegmentHandle openSegment(std::string_view parentDir, std::string_view segmentName) = 0;
+
+        /**
+         * Opens an existing segment for reading only, e.g. an SSTable. Unlike openSegment() the file
+         * is never created.
+         *
+         * @param parentDir The directory path where the segment resides.
+         * @param segmentName The name of the segment to be opened.
+         * @return A handle to the opened segment, not valid() if the segment could not be opened.
          */
-        SegmentHandle openSegment(std::string_view parentDir, std::string_view segmentName);
+        virtual SegmentHandle openReadOnly(std::string_view parentDir, std::string_view segmentName) = 0;
 
         /**
          * Writes data to the specified segment at its current position.
@@ -35,7 +72,37 @@ namespace io_engine {
          * @param len The number of bytes to write from the data buffer.
          * @return The number of bytes actually written, or a negative value if an error occurs.
          */
-        long long write(SegmentHandle seg, const void *data, std::size_t len);
+        virtual long long write(SegmentHandle seg, const void *data, std::size_t len) = 0;
+
+        /**
+         * Writes data like write() and makes it durable like flush(), engines that can submit both at
+         * once do so.
+         *
+         * @return The number of bytes written, or a negative value if either the write or the flush failed.
+         */
+        virtual long long writeSync(const SegmentHandle seg, const void *data, const std::size_t len) {
+            const auto written = this->write(seg, data, len);
+            if (written < 0 || !this->flush(seg)) return -1;
+
+            return written;
+        }
+
+        /**
+         * Reads up to `len` bytes at `offset` of the segment, independent of the write position.
+         *
+         * @return The number of bytes read, short only at the end of the file, or a negative value on error.
+         */
+        virtual long long read(SegmentHandle seg, uint64_t offset, void *buf, std::size_t len) = 0;
+
+        /**
+         * Performs every read in `requests` and stores each outcome in its `result`. Engines with an
+         * asynchronous backend keep all of them in flight at once.
+         */
+        virtual void readBatch(const std::span<ReadRequest> requests) {
+            for (auto &request: requests) {
+                request.result = this->read(request.seg, request.offset, request.buf, request.len);
+            }
+        }
 
         /**
          * Flushes any pending write operations to the specified segment,
@@ -44,7 +111,7 @@ namespace io_engine {
          * @param seg The handle of the segment to be flushed.
          * @return A boolean indicating whether the flush operation was successful (true) or if it failed (false).
          */
-        bool flush(SegmentHandle seg);
+        virtual bool flush(SegmentHandle seg) = 0;
 
         /**
          * Closes the specified segment, releasing any associated resources and ensuring any pending operations are finalized.
@@ -52,8 +119,33 @@ namespace io_engine {
          * @param seg The handle of the segment to be closed.
          * @return A boolean indicating whether the segment was successfully closed (true) or if the operation failed (false).
          */
-        bool close(SegmentHandle seg);
+        virtual bool close(SegmentHandle seg) = 0;
+    };
+
+    enum class IoEngineType : uint8_t {
+        /** Blocking syscalls, available everywhere */
+        POSIX,
+        /** io_uring when built with liburing and the kernel allows it, POSIX otherwise */
+        Uring,
     };
+
+    /**
+     * Creates an engine of the requested type, falling back to the POSIX engine whenever io_uring is
+     * not compiled in or cannot be set up at runtime.
+     *
+     * @param type The preferred engine.
+     * @param preallocateBytes Chunk size files are preallocated in ahead of writes, 0 disables it.
+     */
+    std::shared_ptr<IoEngine> createIoEngine(IoEngineType type, std::size_t preallocateBytes);
+
+    /**
+     * Makes the entries of directory `dir` durable: files created, renamed or removed in it so far.
+     * A file published by a rename is only guaranteed to survive a crash under its new name once its
+     * directory has been synced.
+     *
+     * @return false if the directory cannot be opened or synced.
+     */
+    bool syncDirectory(std::string_view dir);
 } // namespace io_engine
 
 #endif //ENIGMA_DB_ENGINE_HPP
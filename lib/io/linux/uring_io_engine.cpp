@@ -3,3 +3,316 @@
 //
 
 #include "uring_io_engine.hpp"
+
+#ifdef HAS_LIBURING
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+namespace io_engine {
+    std::unique_ptr<UringIoEngine> UringIoEngine::create(const size_t preallocateBytes) {
+        auto engine = std::unique_ptr<UringIoEngine>(new UringIoEngine(preallocateBytes));
+        if (io_uring_queue_init(kQueueDepth, &engine->ring_, 0) < 0) return nullptr;
+        engine->ringReady_ = true;
+
+        // A sparse table; slots are filled in as segments are opened
+        const std::vector<int> files(kMaxFiles, -1);
+        if (io_uring_register_files(&engine->ring_, files.data(), kMaxFiles) == 0) {
+            for (int slot = kMaxFiles - 1; slot >= 0; --slot) engine->freeSlots_.push_back(slot);
+        }
+
+        engine->buffers_ = std::make_unique<std::byte[]>(kBufferCount * kBufferSize);
+        iovec iovecs[kBufferCount];
+        for (size_t i = 0; i < kBufferCount; ++i) {
+            iovecs[i].iov_base = engine->buffer(i);
+            iovecs[i].iov_len = kBufferSize;
+        }
+        if (io_uring_register_buffers(&engine->ring_, iovecs, kBufferCount) != 0) engine->buffers_.reset();
+
+        return engine;
+    }
+
+    UringIoEngine::~UringIoEngine() {
+        for (const auto &[id, segment]: this->segments_) {
+            if (segment.allocated > segment.offset) ::ftruncate(segment.fd, static_cast<off_t>(segment.offset));
+            ::close(segment.fd);
+        }
+
+        if (this->ringReady_) io_uring_queue_exit(&this->ring_);
+    }
+
+    UringIoEngine::Segment *UringIoEngine::find(const SegmentHandle seg) {
+        std::shared_lock lock(this->segmentsMutex_);
+        const auto it = this->segments_.find(seg.id);
+        return it == this->segments_.end() ? nullptr : &it->second;
+    }
+
+    void UringIoEngine::setTarget(io_uring_sqe *sqe, const Segment &segment) {
+        if (segment.slot < 0) return;
+
+        sqe->fd = segment.slot;
+        sqe->flags |= IOSQE_FIXED_FILE;
+    }
+
+    SegmentHandle UringIoEngine::openSegment(const std::string_view parentDir, const std::string_view segmentName) {
+        return this->open(parentDir, segmentName, O_RDWR | O_CREAT);
+    }
+
+    SegmentHandle UringIoEngine::openReadOnly(const std::string_view parentDir, const std::string_view segmentName) {
+        return this->open(parentDir, segmentName, O_RDONLY);
+    }
+
+    SegmentHandle UringIoEngine::open(const std::string_view parentDir, const std::string_view segmentName,
+                                      const int flags) {
+        std::string path;
+        path.reserve(parentDir.size() + segmentName.size() + 1);
+        path.append(parentDir).append("/").append(segmentName);
+
+        const int fd = ::open(path.c_str(), flags | O_CLOEXEC, 0644);
+        if (fd < 0) return {};
+
+        struct stat fileStat{};
+        if (::fstat(fd, &fileStat) < 0) {
+            ::close(fd);
+            return {};
+        }
+
+        const auto size = static_cast<uint64_t>(fileStat.st_size);
+        const SegmentHandle handle{this->nextId_.fetch_add(1, std::memory_order_relaxed)};
+
+        std::unique_lock lock(this->segmentsMutex_);
+
+        int slot = -1;
+        if (!this->freeSlots_.empty()) {
+            slot = this->freeSlots_.back();
+
+            // Older liburing releases take a non-const table
+            int registered = fd;
+            if (io_uring_register_files_update(&this->ring_, slot, &registered, 1) == 1) {
+                this->freeSlots_.pop_back();
+            } else {
+                slot = -1;
+            }
+        }
+
+        this->segments_.emplace(handle.id, Segment{fd, slot, size, size});
+        return handle;
+    }
+
+    void UringIoEngine::reserve(Segment &segment, const std::size_t len) const {
+        if (this->preallocateBytes_ == 0 || segment.offset + len <= segment.allocated) return;
+
+        const uint64_t chunk = std::max<uint64_t>(this->preallocateBytes_, segment.offset + len - segment.allocated);
+        if (::fallocate(segment.fd, FALLOC_FL_KEEP_SIZE, static_cast<off_t>(segment.allocated),
+                        static_cast<off_t>(chunk)) == 0) {
+            segment.allocated += chunk;
+        } else {
+            segment.allocated = UINT64_MAX;
+        }
+    }
+
+    bool UringIoEngine::submitAndReap(const unsigned count, int *results) {
+        if (io_uring_submit_and_wait(&this->ring_, count) < 0) return false;
+
+        unsigned reaped = 0;
+        while (reaped < count) {
+            io_uring_cqe *cqe = nullptr;
+            if (const int ret = io_uring_wait_cqe(&this->ring_, &cqe); ret < 0) {
+                if (ret == -EINTR) continue;
+                return false;
+            }
+
+            results[cqe->user_data] = cqe->res;
+            io_uring_cqe_seen(&this->ring_, cqe);
+            reaped++;
+        }
+
+        return true;
+    }
+
+    long long UringIoEngine::submitWrite(const SegmentHandle seg, const void *data, const std::size_t len,
+                                         const bool sync) {
+        Segment *segment = this->find(seg);
+        if (segment == nullptr) return -1;
+
+        this->reserve(*segment, len);
+
+        const auto *bytes = static_cast<const std::byte *>(data);
+        std::lock_guard lock(this->ringMutex_);
+
+        std::size_t written = 0;
+        bool synced = !sync;
+        while (written < len || !synced) {
+            const std::size_t chunk = len - written;
+            const uint64_t offset = segment->offset + written;
+
+            unsigned count = 0;
+            if (chunk > 0) {
+                io_uring_sqe *sqe = io_uring_get_sqe(&this->ring_);
+                if (this->buffers_ && chunk <= kBufferSize) {
+                    std::memcpy(this->buffer(0), bytes + written, chunk);
+                    io_uring_prep_write_fixed(sqe, segment->fd, this->buffer(0), chunk, offset, 0);
+                } else {
+                    io_uring_prep_write(sqe, segment->fd, bytes + written, chunk, offset);
+                }
+                setTarget(sqe, *segment);
+                sqe->user_data = count++;
+
+                // The sync only runs if the write completed in full, a short write cancels it
+                if (sync) sqe->flags |= IOSQE_IO_LINK;
+            }
+
+            if (sync) {
+                io_uring_sqe *sqe = io_uring_get_sqe(&this->ring_);
+                io_uring_prep_fsync(sqe, segment->fd, IORING_FSYNC_DATASYNC);
+                setTarget(sqe, *segment);
+                sqe->user_data = count++;
+            }
+
+            int results[2] = {0, 0};
+            if (!this->submitAndReap(count, results)) return -1;
+
+            if (chunk > 0) {
+                if (results[0] < 0) {
+                    if (results[0] == -EINTR || results[0] == -EAGAIN) continue;
+                    return -1;
+                }
+
+                // Nothing written for a non-empty chunk would only ever be retried the same way
+                if (results[0] == 0) return -1;
+
+                written += static_cast<std::size_t>(results[0]);
+            }
+
+            if (sync) {
+                const int syncResult = results[count - 1];
+                if (syncResult == 0 && written == len) synced = true;
+                else if (syncResult < 0 && syncResult != -ECANCELED) return -1;
+            }
+        }
+
+        segment->offset += written;
+        return static_cast<long long>(written);
+    }
+
+    long long UringIoEngine::write(const SegmentHandle seg, const void *data, const std::size_t len) {
+        return this->submitWrite(seg, data, len, false);
+    }
+
+    long long UringIoEngine::writeSync(const SegmentHandle seg, const void *data, const std::size_t len) {
+        return this->submitWrite(seg, data, len, true);
+    }
+
+    bool UringIoEngine::flush(const SegmentHandle seg) {
+        return this->submitWrite(seg, nullptr, 0, true) == 0;
+    }
+
+    long long UringIoEngine::read(const SegmentHandle seg, const uint64_t offset, void *buf, const std::size_t len) {
+        ReadRequest request{seg, offset, buf, len};
+        this->readBatch(std::span(&request, 1));
+        return request.result;
+    }
+
+    void UringIoEngine::readBatch(const std::span<ReadRequest> requests) {
+        std::vector<const Segment *> segments(requests.size());
+        std::vector<size_t> pending;
+        pending.reserve(requests.size());
+        for (size_t i = 0; i < requests.size(); ++i) {
+            segments[i] = this->find(requests[i].seg);
+            requests[i].result = segments[i] ? 0 : -1;
+            if (segments[i] != nullptr && requests[i].len > 0) pending.push_back(i);
+        }
+
+        std::lock_guard lock(this->ringMutex_);
+
+        // A short read is resubmitted for the rest, like a pread loop, until it completes or hits the end
+        int results[kQueueDepth];
+        while (!pending.empty()) {
+            const size_t count = std::min<size_t>(pending.size(), kQueueDepth);
+
+            // Small reads land in the registered buffers and are copied out once they complete
+            size_t fixedUsed = 0;
+            int fixedBuffer[kQueueDepth];
+
+            for (size_t slot = 0; slot < count; ++slot) {
+                const auto &request = requests[pending[slot]];
+                const auto done = static_cast<size_t>(request.result);
+                const size_t remaining = request.len - done;
+                const int fd = segments[pending[slot]]->fd;
+
+                fixedBuffer[slot] = -1;
+                io_uring_sqe *sqe = io_uring_get_sqe(&this->ring_);
+                if (this->buffers_ && fixedUsed < kBufferCount && remaining <= kBufferSize) {
+                    fixedBuffer[slot] = static_cast<int>(fixedUsed);
+                    io_uring_prep_read_fixed(sqe, fd, this->buffer(fixedUsed), remaining, request.offset + done,
+                                             static_cast<int>(fixedUsed));
+                    fixedUsed++;
+                } else {
+                    io_uring_prep_read(sqe, fd, static_cast<std::byte *>(request.buf) + done, remaining,
+                                       request.offset + done);
+                }
+                setTarget(sqe, *segments[pending[slot]]);
+                sqe->user_data = slot;
+
+                results[slot] = -1;
+            }
+
+            if (!this->submitAndReap(count, results)) {
+                for (size_t slot = 0; slot < count; ++slot) requests[pending[slot]].result = -1;
+                pending.erase(pending.begin(), pending.begin() + static_cast<std::ptrdiff_t>(count));
+                continue;
+            }
+
+            // Requests still short of their length move to the front, ahead of those not submitted yet
+            size_t kept = 0;
+            for (size_t slot = 0; slot < count; ++slot) {
+                auto &request = requests[pending[slot]];
+                const int result = results[slot];
+                if (result < 0) {
+                    if (result == -EINTR || result == -EAGAIN) pending[kept++] = pending[slot];
+                    else request.result = -1;
+                    continue;
+                }
+
+                if (const int fixed = fixedBuffer[slot]; fixed >= 0 && result > 0) {
+                    std::memcpy(static_cast<std::byte *>(request.buf) + request.result, this->buffer(fixed), result);
+                }
+
+                // End of file
+                request.result += result;
+                if (result > 0 && static_cast<size_t>(request.result) < request.len) pending[kept++] = pending[slot];
+            }
+            pending.erase(pending.begin() + static_cast<std::ptrdiff_t>(kept),
+                          pending.begin() + static_cast<std::ptrdiff_t>(count));
+        }
+    }
+
+    bool UringIoEngine::close(const SegmentHandle seg) {
+        Segment segment{};
+        {
+            std::unique_lock lock(this->segmentsMutex_);
+            const auto it = this->segments_.find(seg.id);
+            if (it == this->segments_.end()) return false;
+
+            segment = it->second;
+            this->segments_.erase(it);
+
+            if (segment.slot >= 0) {
+                int unregistered = -1;
+                io_uring_register_files_update(&this->ring_, segment.slot, &unregistered, 1);
+                this->freeSlots_.push_back(segment.slot);
+            }
+        }
+
+        const bool trimmed = segment.allocated <= segment.offset ||
+                             ::ftruncate(segment.fd, static_cast<off_t>(segment.offset)) == 0;
+        return ::close(segment.fd) == 0 && trimmed;
+    }
+} // namespace io_engine
+
+#endif //HAS_LIBURING
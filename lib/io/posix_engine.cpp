@@ -3,3 +3,141 @@
 //
 
 #include "posix_engine.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <fcntl.h>
+#include <mutex>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace io_engine {
+    POSIXEngine::~POSIXEngine() {
+        for (const auto &[id, segment]: this->segments_) {
+            if (segment.allocated > segment.offset) ::ftruncate(segment.fd, static_cast<off_t>(segment.offset));
+            ::close(segment.fd);
+        }
+    }
+
+    POSIXEngine::Segment *POSIXEngine::find(const SegmentHandle seg) {
+        std::shared_lock lock(this->segmentsMutex_);
+        const auto it = this->segments_.find(seg.id);
+        return it == this->segments_.end() ? nullptr : &it->second;
+    }
+
+    SegmentHandle POSIXEngine::openSegment(const std::string_view parentDir, const std::string_view segmentName) {
+        return this->open(parentDir, segmentName, O_RDWR | O_CREAT);
+    }
+
+    SegmentHandle POSIXEngine::openReadOnly(const std::string_view parentDir, const std::string_view segmentName) {
+        return this->open(parentDir, segmentName, O_RDONLY);
+    }
+
+    SegmentHandle POSIXEngine::open(const std::string_view parentDir, const std::string_view segmentName,
+                                    const int flags) {
+        std::string path;
+        path.reserve(parentDir.size() + segmentName.size() + 1);
+        path.append(parentDir).append("/").append(segmentName);
+
+        const int fd = ::open(path.c_str(), flags | O_CLOEXEC, 0644);
+        if (fd < 0) return {};
+
+        struct stat fileStat{};
+        if (::fstat(fd, &fileStat) < 0) {
+            ::close(fd);
+            return {};
+        }
+
+        const auto size = static_cast<uint64_t>(fileStat.st_size);
+        const SegmentHandle handle{this->nextId_.fetch_add(1, std::memory_order_relaxed)};
+
+        std::unique_lock lock(this->segmentsMutex_);
+        this->segments_.emplace(handle.id, Segment{fd, size, size});
+        return handle;
+    }
+
+    void POSIXEngine::reserve(Segment &segment, const std::size_t len) const {
+        if (this->preallocateBytes_ == 0 || segment.offset + len <= segment.allocated) return;
+
+        const uint64_t chunk = std::max<uint64_t>(this->preallocateBytes_, segment.offset + len - segment.allocated);
+
+        // KEEP_SIZE leaves st_size at the written length so readers never see the reserved zeroes
+        if (::fallocate(segment.fd, FALLOC_FL_KEEP_SIZE, static_cast<off_t>(segment.allocated),
+                        static_cast<off_t>(chunk)) == 0) {
+            segment.allocated += chunk;
+        } else {
+            // Not supported by the filesystem (or out of space, which the write will report); stop trying
+            segment.allocated = UINT64_MAX;
+        }
+    }
+
+    long long POSIXEngine::write(const SegmentHandle seg, const void *data, const std::size_t len) {
+        Segment *segment = this->find(seg);
+        if (segment == nullptr) return -1;
+
+        this->reserve(*segment, len);
+
+        const auto *bytes = static_cast<const char *>(data);
+        std::size_t written = 0;
+        while (written < len) {
+            const ssize_t n = ::pwrite(segment->fd, bytes + written, len - written,
+                                       static_cast<off_t>(segment->offset + written));
+            if (n < 0) {
+                if (errno == EINTR) continue;
+                return -1;
+            }
+            // No progress, retrying would spin forever
+            if (n == 0) return -1;
+
+            written += static_cast<std::size_t>(n);
+        }
+
+        segment->offset += written;
+        return static_cast<long long>(written);
+    }
+
+    long long POSIXEngine::read(const SegmentHandle seg, const uint64_t offset, void *buf, const std::size_t len) {
+        const Segment *segment = this->find(seg);
+        if (segment == nullptr) return -1;
+
+        auto *bytes = static_cast<char *>(buf);
+        std::size_t done = 0;
+        while (done < len) {
+            const ssize_t n = ::pread(segment->fd, bytes + done, len - done, static_cast<off_t>(offset + done));
+            if (n < 0) {
+                if (errno == EINTR) continue;
+                return -1;
+            }
+
+            // End of file
+            if (n == 0) break;
+            done += static_cast<std::size_t>(n);
+        }
+
+        return static_cast<long long>(done);
+    }
+
+    bool POSIXEngine::flush(const SegmentHandle seg) {
+        const Segment *segment = this->find(seg);
+        if (segment == nullptr) return false;
+
+        return ::fdatasync(segment->fd) == 0;
+    }
+
+    bool POSIXEngine::close(const SegmentHandle seg) {
+        Segment segment{};
+        {
+            std::unique_lock lock(this->segmentsMutex_);
+            const auto it = this->segments_.find(seg.id);
+            if (it == this->segments_.end()) return false;
+
+            segment = it->second;
+            this->segments_.erase(it);
+        }
+
+        // Hand back whatever was preallocated but never written
+        const bool trimmed = segment.allocated <= segment.offset ||
+                             ::ftruncate(segment.fd, static_cast<off_t>(segment.offset)) == 0;
+        return ::close(segment.fd) == 0 && trimmed;
+    }
+} // namespace io_engine
@@ -7,10 +7,74 @@
 #ifndef ENIGMA_DB_POSIX_ENGINE_HPP
 #define ENIGMA_DB_POSIX_ENGINE_HPP
 
+#include <atomic>
+#include <shared_mutex>
+#include <unordered_map>
+
 #include "engine.hpp"
+#include "lib/utils/constants.hpp"
 
 namespace io_engine {
-    class POSIXEngine final : IoEngine {
+    /**
+     * Blocking engine on raw file descriptors: pwrite at a tracked offset, fallocate ahead of the
+     * write position, fdatasync for durability and pread for reads. No user-space buffering happens here, callers
+     * batch before calling write().
+     */
+    class POSIXEngine final : public IoEngine {
+    public:
+        static constexpr size_t kDefaultPreallocateBytes = 4_MB;
+
+        /**
+         * @param preallocateBytes Size of the chunks reserved ahead of the write position, 0 disables
+         *                         preallocation.
+         */
+        explicit POSIXEngine(const size_t preallocateBytes = kDefaultPreallocateBytes)
+            : preallocateBytes_(preallocateBytes) {
+        }
+
+        ~POSIXEngine() override;
+
+        SegmentHandle openSegment(std::string_view parentDir, std::string_view segmentName) override;
+
+        SegmentHandle openReadOnly(std::string_view parentDir, std::string_view segmentName) override;
+
+        long long write(SegmentHandle seg, const void *data, std::size_t len) override;
+
+        long long read(SegmentHandle seg, uint64_t offset, void *buf, std::size_t len) override;
+
+        bool flush(SegmentHandle seg) override;
+
+        /**
+         * Closes the segment and trims any preallocated space past the last write.
+         */
+        bool close(SegmentHandle seg) override;
+
+    private:
+        struct Segment {
+            int fd;
+
+            /** Where the next write lands, the file is opened at its current end */
+            uint64_t offset;
+
+            /** Bytes reserved with fallocate, may run ahead of offset */
+            uint64_t allocated;
+        };
+
+        size_t preallocateBytes_;
+
+        /** Handles are never reused so a stale handle cannot reach another segment */
+        std::atomic<uint64_t> nextId_{1};
+
+        /** Segment table, writers take it shared and only open/close take it exclusively */
+        std::shared_mutex segmentsMutex_;
+        std::unordered_map<uint64_t, Segment> segments_;
+
+        Segment *find(SegmentHandle seg);
+
+        SegmentHandle open(std::string_view parentDir, std::string_view segmentName, int flags);
+
+        /** Makes sure [offset, offset + len) is backed by preallocated blocks */
+        void reserve(Segment &segment, std::size_t len) const;
     };
 } // namespace io_engine
 
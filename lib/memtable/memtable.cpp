@@ -4,40 +4,91 @@
 
 #include "memtable.hpp"
 
+#include <limits>
 #include <mutex>
 
 namespace memtable {
-    void MemTable::put(const core::Entry &entry) const {
+    void MemTable::insertLocked(const Record record) const {
+        if (this->backend_ == MemTableBackend::SkipList) {
+            const auto node = this->skipList_->insert(record);
+
+            // Older versions of a key sort right after the newer one, anything else means a new key
+            if (const auto next = node->next(0); next == nullptr || next->key.compareKey(record) != 0) {
+                this->entryCount_.fetch_add(1, std::memory_order_relaxed);
+            }
+        } else {
+            this->tree_->insert(record);
+            this->entryCount_.store(this->tree_->size(), std::memory_order_relaxed);
+        }
+    }
+
+    std::optional<core::Entry> MemTable::findLocked(const core::Key &key) const {
+        std::vector<std::byte> scratch;
+
+        if (this->backend_ == MemTableBackend::SkipList) {
+            // Newest version sorts first, so probe with the highest possible timestamp
+            const Record probe = Record::probe(key, std::numeric_limits<uint64_t>::max(), scratch);
+            const auto node = this->skipList_->findGreaterOrEqual(probe);
+            if (!node || node->key.compareKey(probe) != 0) return std::nullopt;
+
+            return node->key.toEntry(this->schemas());
+        }
+
+        const Record probe = Record::probe(key, 0, scratch);
+        const auto node = this->tree_->search(probe);
+        if (!node) return std::nullopt;
+
+        return node->key.toEntry(this->schemas());
+    }
+
+    template<typename E>
+    void MemTable::putEntry(const E &entry) const {
+        if (this->backend_ == MemTableBackend::SkipList) {
+            if (this->frozen_) throw std::runtime_error("cannot insert into a frozen MemTable");
+            this->insertLocked(Record::encode(*this->arena_, entry));
+            return;
+        }
+
         std::unique_lock lock(this->rwMutex_);
         if (this->frozen_) throw std::runtime_error("cannot insert into a frozen MemTable");
-        this->tree_->insert(entry);
+        this->insertLocked(Record::encode(*this->arena_, entry));
+    }
+
+    void MemTable::put(const core::Entry &entry) const {
+        this->putEntry(entry);
+    }
+
+    void MemTable::put(const core::EntryView &entry) const {
+        this->putEntry(entry);
     }
 
     void MemTable::applyEntry(const core::Entry &entry) const {
-        std::unique_lock lock(this->rwMutex_);
-        if (this->frozen_) throw std::runtime_error("cannot insert into a frozen MemTable");
-        this->tree_->insert(entry);
+        this->put(entry);
     }
 
+    void MemTable::applyEntry(const core::EntryView &entry) const {
+        this->put(entry);
+    }
 
     std::optional<core::Entry> MemTable::get(const core::Key &key) const {
-        std::shared_lock lock(this->rwMutex_);
-
-        const core::Entry dummy{this->tableName_, key, {}, false};
-        const auto node = this->tree_->search(dummy);
-        if (!node) return std::nullopt;
+        if (this->backend_ == MemTableBackend::SkipList) return this->findLocked(key);
 
-        return node->key;
+        std::shared_lock lock(this->rwMutex_);
+        return this->findLocked(key);
     }
 
     void MemTable::del(const core::Key &key, const uint64_t timestamp) const {
-        std::unique_lock lock(this->rwMutex_);
+        std::unique_lock lock(this->rwMutex_, std::defer_lock);
+        if (this->backend_ == MemTableBackend::AVL) lock.lock();
+
         if (this->frozen_) throw std::runtime_error("cannot delete from a frozen MemTable");
 
-        if (const auto entryFound = this->get(key); !entryFound) return;
+        if (const auto entryFound = this->findLocked(key); !entryFound) return;
 
-        const core::Entry tombstone{this->tableName_, key, {}, true, timestamp};
-        this->tree_->insert(tombstone);
+        const core::Entry tombstone = this->schema_
+                                          ? core::Entry{this->schema_, key, {}, true, timestamp}
+                                          : core::Entry{this->tableName_, key, {}, true, timestamp};
+        this->insertLocked(Record::encode(*this->arena_, tombstone));
     }
 
     void MemTable::freeze() {
@@ -50,12 +101,16 @@ namespace memtable {
     }
 
     std::vector<core::Entry> MemTable::orderedEntries() const {
-        std::shared_lock lock(this->rwMutex_);
-        return this->tree_->toSortedVector();
+        std::vector<core::Entry> entries;
+        entries.reserve(this->size());
+
+        auto it = this->newIterator();
+        for (it.seekToFirst(); it.valid(); it.next()) entries.push_back(it.entry());
+
+        return entries;
     }
 
     size_t MemTable::size() const {
-        std::shared_lock lock(this->rwMutex_);
-        return this->tree_->toSortedVector().size();
+        return this->entryCount_.load(std::memory_order_relaxed);
     }
 } // namespace MemTable
@@ -7,10 +7,32 @@
 
 #include <shared_mutex>
 
+#include "lib/abstract/arena.hpp"
 #include "lib/abstract/avl.hpp"
+#include "lib/abstract/skiplist.hpp"
 #include "lib/entry/entry.hpp"
+#include "lib/memtable/memtable_iterator.hpp"
+#include "lib/memtable/memtable_record.hpp"
 
 namespace memtable {
+    /**
+     * @enum MemTableBackend
+     * @brief Selects the ordered structure backing a MemTable.
+     *
+     * `AVL` keeps a single version per key behind a reader/writer lock. `SkipList` is a lock-free
+     * multi-version list: concurrent writers never block each other and readers never block at all.
+     */
+    enum class MemTableBackend : uint8_t {
+        AVL,
+        SkipList,
+    };
+
+    /**
+     * Per WAL writer, the number of the first segment holding none of a MemTable's entries. Empty
+     * when the MemTable was frozen without a log attached, which covers no segment at all.
+     */
+    using LogPosition = std::vector<uint32_t>;
+
     /**
      * @class MemTable
      * @brief Manages an in-memory data structure for storing and manipulating entries.
@@ -19,36 +41,76 @@ namespace memtable {
      * entries, providing efficient insertion, deletion, retrieval, and ordering
      * operations using an AVL tree. It is suitable for applications that need
      * fast in-memory manipulations and can be "frozen" to prevent further modifications.
+     *
+     * Entries are stored serialized inside a per-MemTable arena together with the
+     * tree/list nodes pointing at them, so dropping a MemTable releases a handful of
+     * blocks instead of every entry one by one.
      */
     class MemTable {
     private:
+        friend class MemTableIterator;
+
         /** The name of the table this MemTable maintains */
         std::string tableName_;
 
-        /** Core AVL Tree for this MemTable */
-        std::unique_ptr<AVLTree<core::Entry> > tree_;
+        /** Schema of the table, if any; tombstones written by del() are serialized against it */
+        std::shared_ptr<const core::TableSchema> schema_;
+
+        /** Registry stored entries are decoded through, SchemaRegistry::global() when null */
+        std::shared_ptr<const core::SchemaRegistry> schemas_;
+
+        /** Which structure this MemTable stores its entries in */
+        MemTableBackend backend_;
+
+        /** Owns the nodes and encoded entries; declared first so it outlives the structures below */
+        std::unique_ptr<Arena> arena_;
 
-        /** Read/Write mutex for this MemTable */
+        /** Core AVL Tree for this MemTable, only set for the AVL backend */
+        std::unique_ptr<AVLTree<Record> > tree_;
+
+        /** Lock-free skiplist for this MemTable, only set for the SkipList backend */
+        std::unique_ptr<ConcurrentSkipList<Record, VersionedRecordComparator> > skipList_;
+
+        /** Read/Write mutex for this MemTable; the skiplist backend never takes it */
         mutable std::shared_mutex rwMutex_;
 
         /** Represents if this MemTable is frozen or not */
         std::atomic<bool> frozen_;
 
+        /** Number of distinct keys, maintained on insert so size() never walks the structure */
+        mutable std::atomic<size_t> entryCount_{0};
+
+        /** WAL segments this MemTable's entries were logged to, set once as it is frozen */
+        LogPosition logPosition_;
+
     public:
         using KeyType = std::string;
 
         /**
          * @brief Constructs a MemTable with the specified name.
          *
-         * Initializes the MemTable with a given name and sets up its internal AVL tree
-         * for storing entries. The table is set to a non-frozen state initially, allowing
-         * for modifications.
+         * Initializes the MemTable with a given name and sets up the internal structure selected
+         * by `backend` for storing entries. The table is set to a non-frozen state initially,
+         * allowing for modifications.
          *
          * @param tableName The name of the table used to identify this MemTable instance.
+         * @param backend The ordered structure to store entries in, defaults to the AVL tree.
+         * @param schema The table's schema, if it has one.
+         * @param schemas The registry of the database the table belongs to, e.g. its SchemaCatalog's;
+         *                entries are decoded through SchemaRegistry::global() when null.
          */
-        explicit MemTable(std::string tableName): tableName_(std::move(tableName)),
-                                                  tree_(std::make_unique<AVLTree<core::Entry> >()),
-                                                  frozen_(false) {
+        explicit MemTable(std::string tableName, const MemTableBackend backend = MemTableBackend::AVL,
+                          std::shared_ptr<const core::TableSchema> schema = nullptr,
+                          std::shared_ptr<const core::SchemaRegistry> schemas = nullptr)
+            : tableName_(std::move(tableName)), schema_(std::move(schema)), schemas_(std::move(schemas)),
+              backend_(backend),
+              arena_(std::make_unique<Arena>()), frozen_(false) {
+            if (backend == MemTableBackend::SkipList) {
+                this->skipList_ = std::make_unique<ConcurrentSkipList<Record, VersionedRecordComparator> >(
+                    *this->arena_);
+            } else {
+                this->tree_ = std::make_unique<AVLTree<Record> >(this->arena_.get());
+            }
         }
 
         /**
@@ -63,6 +125,14 @@ namespace memtable {
          */
         void put(const core::Entry &entry) const;
 
+        /**
+         * @brief Inserts an entry that is already serialized, e.g. one replayed from the WAL; its bytes
+         * are copied into the MemTable as they are.
+         *
+         * @throw std::runtime_error Thrown if the MemTable is frozen and insertion is attempted.
+         */
+        void put(const core::EntryView &entry) const;
+
         /**
          * @brief Retrieves an entry associated with the given key from the MemTable.
          *
@@ -95,6 +165,9 @@ namespace memtable {
          * Sets the MemTable to a frozen state, ensuring that no further insertions,
          * deletions, or updates can be performed. This method acquires a write lock
          * to guarantee thread safety. Once frozen, the state cannot be reverted.
+         *
+         * The skiplist backend does not lock, so a write that passed its frozen check
+         * right before this call may still land; callers rotate before flushing anyway.
          */
         void freeze();
 
@@ -113,14 +186,24 @@ namespace memtable {
          * @brief Retrieves all entries in the MemTable in sorted order.
          *
          * Returns a vector containing all entries stored in the MemTable, sorted in
-         * ascending order based on their natural comparison criteria. The method
-         * leverages the internal AVL tree structure to ensure the entries are
-         * efficiently sorted. This operation is thread-safe.
+         * ascending order based on their natural comparison criteria. Only the newest
+         * version of every key is returned. This operation is thread-safe.
          *
          * @return A vector of entries sorted in ascending order.
          */
         std::vector<core::Entry> orderedEntries() const;
 
+        /**
+         * @brief Returns an unpositioned cursor over the newest version of every key.
+         *
+         * Call one of the seek methods before reading from it. On the AVL backend the
+         * cursor holds this MemTable's read lock until it is destroyed, so do not write
+         * to the same MemTable while holding one.
+         *
+         * @return A cursor that must not outlive this MemTable.
+         */
+        [[nodiscard]] MemTableIterator newIterator() const { return MemTableIterator(*this); }
+
         /**
          * @brief Applies a new entry to the MemTable by inserting it into the internal data structure.
          *
@@ -133,15 +216,64 @@ namespace memtable {
          */
         void applyEntry(const core::Entry &entry) const;
 
+        /** @brief Same as the `core::Entry` overload, for an entry that is already serialized. */
+        void applyEntry(const core::EntryView &entry) const;
+
         /**
          * @brief Retrieves the number of entries currently stored in the MemTable.
          *
          * This method provides a thread-safe way to determine the total count of
-         * key-value entries present in the MemTable.
+         * key-value entries present in the MemTable. The count is maintained on
+         * insert, so this is O(1). On the skiplist backend an older version that
+         * arrives after a newer one for the same key is counted twice.
          *
          * @return The current number of entries in the MemTable.
          */
         size_t size() const;
+
+        /**
+         * @brief Returns the approximate number of bytes held by this MemTable.
+         *
+         * Covers the nodes and encoded entries, including versions that have been
+         * overwritten since they stay in the arena until the MemTable is dropped.
+         *
+         * @return Bytes reserved by this MemTable's arena.
+         */
+        [[nodiscard]] size_t approximateMemoryUsage() const { return this->arena_->memoryUsage(); }
+
+        /**
+         * @brief Returns the structure this MemTable stores its entries in.
+         */
+        [[nodiscard]] MemTableBackend backend() const { return this->backend_; }
+
+        /**
+         * @brief Returns the registry this MemTable's entries are decoded through.
+         */
+        [[nodiscard]] const core::SchemaRegistry &schemas() const {
+            return this->schemas_ ? *this->schemas_ : core::SchemaRegistry::global();
+        }
+
+        /**
+         * @brief Returns the WAL position this MemTable covers.
+         *
+         * Every WAL segment before it only holds entries of this MemTable or older ones, so once
+         * this MemTable and every older one are durable in SSTables those segments can go.
+         */
+        [[nodiscard]] const LogPosition &logPosition() const { return this->logPosition_; }
+
+        /** Records the WAL position this MemTable covers; only valid while it is not yet shared */
+        void setLogPosition(LogPosition position) { this->logPosition_ = std::move(position); }
+
+    private:
+        /** Inserts into the active backend; callers must have checked the frozen state */
+        void insertLocked(Record record) const;
+
+        /** Encodes `entry`, a core::Entry or core::EntryView, and inserts it, see put() */
+        template<typename E>
+        void putEntry(const E &entry) const;
+
+        /** Looks a key up in the active backend; callers must hold the read lock for AVL */
+        std::optional<core::Entry> findLocked(const core::Key &key) const;
     };
 } // namespace memtable
 
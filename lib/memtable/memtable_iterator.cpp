@@ -0,0 +1,121 @@
+//
+// Created by frostzt on 10/17/2026.
+//
+
+#include "memtable_iterator.hpp"
+
+#include <limits>
+
+#include "memtable.hpp"
+
+namespace memtable {
+    namespace {
+        constexpr uint64_t kNewest = std::numeric_limits<uint64_t>::max();
+    } // namespace
+
+    MemTableIterator::MemTableIterator(const MemTable &table) : schemas_(&table.schemas()) {
+        if (table.backend_ == MemTableBackend::SkipList) {
+            this->skipIt_.emplace(table.skipList_->iterator());
+            return;
+        }
+
+        this->lock_ = std::shared_lock(table.rwMutex_);
+        this->treeIt_.emplace(table.tree_->iterator());
+    }
+
+    bool MemTableIterator::valid() const {
+        return this->skipIt_ ? this->skipIt_->valid() : this->treeIt_->valid();
+    }
+
+    Record MemTableIterator::record() const {
+        return this->skipIt_ ? this->skipIt_->key() : this->treeIt_->key();
+    }
+
+    void MemTableIterator::toNewestVersion() {
+        if (!this->skipIt_->valid()) return;
+
+        const Record current = this->skipIt_->key();
+        this->skipIt_->seek(Record::probe(current.keyData(), current.keyLength(), kNewest, this->scratch_));
+    }
+
+    void MemTableIterator::seekToFirst() {
+        if (this->treeIt_) {
+            this->treeIt_->seekToFirst();
+            return;
+        }
+
+        // The first node is always the newest version of the smallest key
+        this->skipIt_->seekToFirst();
+    }
+
+    void MemTableIterator::seekToLast() {
+        if (this->treeIt_) {
+            this->treeIt_->seekToLast();
+            return;
+        }
+
+        this->skipIt_->seekToLast();
+        this->toNewestVersion();
+    }
+
+    void MemTableIterator::seekEncoded(const std::byte *keyData, const size_t keyLength) {
+        if (this->treeIt_) {
+            this->treeIt_->seek(Record::probe(keyData, keyLength, 0, this->scratch_));
+            return;
+        }
+
+        this->skipIt_->seek(Record::probe(keyData, keyLength, kNewest, this->scratch_));
+    }
+
+    void MemTableIterator::seek(const core::Key &target) {
+        if (this->treeIt_) {
+            this->treeIt_->seek(Record::probe(target, 0, this->scratch_));
+            return;
+        }
+
+        this->skipIt_->seek(Record::probe(target, kNewest, this->scratch_));
+    }
+
+    void MemTableIterator::seek(const Record &target) {
+        this->seekEncoded(target.keyData(), target.keyLength());
+    }
+
+    void MemTableIterator::seekForPrev(const core::Key &target) {
+        if (this->treeIt_) {
+            this->treeIt_->seekForPrev(Record::probe(target, 0, this->scratch_));
+            return;
+        }
+
+        const Record probe = Record::probe(target, kNewest, this->scratch_);
+        this->skipIt_->seek(probe);
+        if (this->skipIt_->valid() && this->skipIt_->key().compareKey(probe) == 0) return;
+
+        this->skipIt_->seekBefore(probe);
+        this->toNewestVersion();
+    }
+
+    void MemTableIterator::next() {
+        if (this->treeIt_) {
+            this->treeIt_->next();
+            return;
+        }
+
+        // Step over the older versions of the current key
+        const Record current = this->skipIt_->key();
+        do {
+            this->skipIt_->next();
+        } while (this->skipIt_->valid() && this->skipIt_->key().compareKey(current) == 0);
+    }
+
+    void MemTableIterator::prev() {
+        if (this->treeIt_) {
+            this->treeIt_->prev();
+            return;
+        }
+
+        // Lands on the oldest version of the previous key
+        const Record current = this->skipIt_->key();
+        this->skipIt_->seekBefore(Record::probe(current.keyData(), current.keyLength(), kNewest, this->scratch_));
+        this->toNewestVersion();
+    }
+} // namespace memtable
@@ -0,0 +1,90 @@
+//
+// Created by frostzt on 10/17/2026.
+//
+
+#ifndef ENIGMA_DB_MEMTABLE_ITERATOR_HPP
+#define ENIGMA_DB_MEMTABLE_ITERATOR_HPP
+
+#include <optional>
+#include <shared_mutex>
+#include <vector>
+
+#include "lib/abstract/avl.hpp"
+#include "lib/abstract/skiplist.hpp"
+#include "lib/memtable/memtable_record.hpp"
+
+namespace memtable {
+    class MemTable;
+
+    /**
+     * @class MemTableIterator
+     * @brief Ordered, zero-copy cursor over the newest version of every key in a single MemTable.
+     *
+     * The iterator hands out `Record` handles that point straight into the MemTable's arena; nothing
+     * is decoded unless `entry()` is called. Tombstones are surfaced like any other record.
+     *
+     * On the skiplist backend the iterator takes no locks and may or may not observe writes racing
+     * with it. On the AVL backend it holds the table's read lock for its whole lifetime, so writes to
+     * that table (from any thread, including the one holding the iterator) wait until it is destroyed.
+     */
+    class MemTableIterator {
+    private:
+        using SkipListIterator = ConcurrentSkipList<Record, VersionedRecordComparator>::Iterator;
+        using TreeIterator = AVLTree<Record>::Iterator;
+
+        std::shared_lock<std::shared_mutex> lock_;
+        std::optional<SkipListIterator> skipIt_;
+        std::optional<TreeIterator> treeIt_;
+
+        /** The table's registry, entries are decoded through it */
+        const core::SchemaRegistry *schemas_;
+
+        /** Backing storage for search probes */
+        std::vector<std::byte> scratch_;
+
+        /** Moves a skiplist cursor sitting on any version of a key to that key's newest version */
+        void toNewestVersion();
+
+        void seekEncoded(const std::byte *keyData, size_t keyLength);
+
+    public:
+        explicit MemTableIterator(const MemTable &table);
+
+        [[nodiscard]] bool valid() const;
+
+        void seekToFirst();
+
+        void seekToLast();
+
+        /**
+         * @brief Positions the cursor at the first key that is not less than `target`.
+         */
+        void seek(const core::Key &target);
+
+        /**
+         * @brief Positions the cursor at the first key that is not less than the key of `target`.
+         */
+        void seek(const Record &target);
+
+        /**
+         * @brief Positions the cursor at the last key that is not greater than `target`.
+         */
+        void seekForPrev(const core::Key &target);
+
+        void next();
+
+        void prev();
+
+        /**
+         * @brief The record under the cursor; stays valid for as long as the MemTable is alive.
+         */
+        [[nodiscard]] Record record() const;
+
+        /**
+         * @brief Decodes the entry under the cursor.
+         */
+        [[nodiscard]] core::Entry entry() const { return this->record().toEntry(*this->schemas_); }
+    };
+} // namespace memtable
+
+#endif //ENIGMA_DB_MEMTABLE_ITERATOR_HPP
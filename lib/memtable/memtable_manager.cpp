@@ -9,22 +9,57 @@
 namespace memtable {
     void MemTableManager::apply(const core::Entry &entry) {
         this->maybeRotate();
+
+        std::shared_lock lock(this->activeMutex_);
+        this->active_->applyEntry(entry);
+    }
+
+    void MemTableManager::apply(const core::EntryView &entry) {
+        this->maybeRotate();
+
+        std::shared_lock lock(this->activeMutex_);
+        this->active_->applyEntry(entry);
+    }
+
+    bool MemTableManager::apply(const core::Entry &entry, const std::function<bool(const core::Entry &)> &log) {
+        this->maybeRotate();
+
+        std::shared_lock lock(this->activeMutex_);
+        if (!log(entry)) return false;
+
         this->active_->applyEntry(entry);
+        return true;
     }
 
     void MemTableManager::maybeRotate() {
-        if (this->active_->size() < kMaxEntries) return;
+        {
+            std::shared_lock lock(this->activeMutex_);
+            if (this->active_->approximateMemoryUsage() < this->maxMemTableBytes_) return;
+        }
+
+        std::unique_lock lock(this->activeMutex_);
+
+        // Another writer may have rotated while we waited for the exclusive lock
+        if (this->active_->approximateMemoryUsage() < this->maxMemTableBytes_) return;
+
+        // No write is between the log and the MemTable while the lock is held; sealed first so a
+        // failure leaves the active MemTable as it was
+        if (this->logSealer_) this->active_->setLogPosition(this->logSealer_());
 
         this->active_->freeze();
 
-        std::lock_guard lock(this->frozenMutex_);
+        std::lock_guard frozenLock(this->frozenMutex_);
 
         this->frozen_.push_back(this->active_);
-        this->active_ = std::make_shared<MemTable>(this->tableName_);
+        this->active_ = std::make_shared<MemTable>(this->tableName_, this->backend_, this->schema_,
+                                                   this->schemas_);
     }
 
     std::optional<core::Entry> MemTableManager::get(const core::Key &key) const {
-        if (auto found = this->active_->get(key); found) return found;
+        {
+            std::shared_lock lock(this->activeMutex_);
+            if (auto found = this->active_->get(key); found) return found;
+        }
 
         std::lock_guard lock(this->frozenMutex_);
         for (const auto & it : std::ranges::reverse_view(this->frozen_)) {
@@ -34,6 +69,33 @@ namespace memtable {
         return std::nullopt;
     }
 
+    MergingIterator MemTableManager::newIterator() const {
+        std::vector<std::shared_ptr<MemTable> > tables;
+        {
+            std::shared_lock lock(this->activeMutex_);
+            tables.push_back(this->active_);
+        }
+
+        std::lock_guard lock(this->frozenMutex_);
+        tables.insert(tables.end(), this->frozen_.rbegin(), this->frozen_.rend());
+
+        return MergingIterator(std::move(tables));
+    }
+
+    void MemTableManager::scan(const core::Key &start, const core::Key &end,
+                               const std::function<bool(const Record &)> &visitor) const {
+        std::vector<std::byte> scratch;
+        const Record upper = Record::probe(end, 0, scratch);
+
+        auto it = this->newIterator();
+        for (it.seek(start); it.valid(); it.next()) {
+            const Record record = it.record();
+            if (record.compareKey(upper) >= 0) break;
+            if (record.isTombstone()) continue;
+            if (!visitor(record)) break;
+        }
+    }
+
     std::shared_ptr<MemTable> MemTableManager::flushOldestFrozen() {
         std::lock_guard lock(this->frozenMutex_);
         if (this->frozen_.empty()) return nullptr;
@@ -42,4 +104,9 @@ namespace memtable {
         this->frozen_.pop_front();
         return oldest;
     }
+
+    std::shared_ptr<MemTable> MemTableManager::oldestFrozen() const {
+        std::lock_guard lock(this->frozenMutex_);
+        return this->frozen_.empty() ? nullptr : this->frozen_.front();
+    }
 } // namespace memtable
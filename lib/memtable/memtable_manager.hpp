@@ -7,27 +7,124 @@
 
 #include <memory>
 #include <deque>
+#include <functional>
+#include <shared_mutex>
 
 #include "memtable.hpp"
+#include "merging_iterator.hpp"
+#include "lib/utils/constants.hpp"
 
 namespace memtable {
     class MemTableManager {
     private:
         std::string tableName_;
+
+        /** Schema handed to every MemTable of the table, nullptr if it has none */
+        std::shared_ptr<const core::TableSchema> schema_;
+
+        /** Registry handed to every MemTable of the table, nullptr for SchemaRegistry::global() */
+        std::shared_ptr<const core::SchemaRegistry> schemas_;
+
+        MemTableBackend backend_;
         std::shared_ptr<MemTable> active_;
         std::deque<std::shared_ptr<MemTable> > frozen_;
 
+        /** Rotation swaps active_ under the exclusive lock, writers and readers share it */
+        mutable std::shared_mutex activeMutex_;
+
         mutable std::mutex frozenMutex_;
-        static constexpr size_t kMaxEntries = 5000;
+
+        /** Approximate bytes the active MemTable may hold before it is frozen */
+        size_t maxMemTableBytes_;
+
+        /** Seals the log as the active MemTable is frozen, unset until a log is attached */
+        std::function<LogPosition()> logSealer_;
 
     public:
+        static constexpr size_t kDefaultMaxMemTableBytes = 64_MB;
+
+        explicit MemTableManager(std::string tableName, const MemTableBackend backend = MemTableBackend::AVL,
+                                 const size_t maxMemTableBytes = kDefaultMaxMemTableBytes)
+            : tableName_(std::move(tableName)), backend_(backend),
+              active_(std::make_shared<MemTable>(this->tableName_, backend)),
+              maxMemTableBytes_(maxMemTableBytes) {
+        }
+
+        /**
+         * Manages the MemTables of a table with a schema, e.g. one of a SchemaCatalog; the tombstones they
+         * write then refer to the table by its id. `schemas` is the registry the entries are decoded
+         * through, that of the catalog, SchemaRegistry::global() when null.
+         */
+        explicit MemTableManager(std::shared_ptr<const core::TableSchema> schema,
+                                 const MemTableBackend backend = MemTableBackend::AVL,
+                                 const size_t maxMemTableBytes = kDefaultMaxMemTableBytes,
+                                 std::shared_ptr<const core::SchemaRegistry> schemas = nullptr)
+            : tableName_(schema->tableName()), schema_(std::move(schema)), schemas_(std::move(schemas)),
+              backend_(backend),
+              active_(std::make_shared<MemTable>(this->tableName_, backend, this->schema_, this->schemas_)),
+              maxMemTableBytes_(maxMemTableBytes) {
+        }
+
+        /**
+         * Freezes the active MemTable and starts a new one once the active table's
+         * approximate memory usage reaches the configured byte budget. Cheap enough
+         * to call on every write.
+         */
         void maybeRotate();
 
         void apply(const core::Entry &);
 
+        /** Applies an entry that is already serialized, e.g. while replaying the WAL, without decoding it */
+        void apply(const core::EntryView &entry);
+
+        /**
+         * Logs `entry` with `log` and, if that succeeds, applies it. Both happen under the same shared
+         * lock the rotation takes exclusively, so an entry is never logged before a freeze and applied
+         * after it; every write of a MemTableManager with a log sealer attached must come through here.
+         *
+         * @return false if `log` failed, the entry is then not applied.
+         */
+        bool apply(const core::Entry &entry, const std::function<bool(const core::Entry &)> &log);
+
+        /**
+         * Attaches the log every write is recorded in. `sealer` is called with writes excluded whenever
+         * the active MemTable is frozen and must return the position from which on the log holds none
+         * of its entries, see MemTable::logPosition(). Attach it once WAL recovery has been replayed,
+         * tables frozen while replaying are not ordered against the recovered segments.
+         */
+        void setLogSealer(std::function<LogPosition()> sealer) { this->logSealer_ = std::move(sealer); }
+
         std::optional<core::Entry> get(const core::Key &) const;
 
+        /**
+         * Returns a merged cursor over the active and frozen MemTables as they are right now, newest
+         * version of every key first. Tables rotated or flushed afterwards stay alive until the cursor
+         * is destroyed. With the AVL backend the cursor holds the active table's read lock, so do not
+         * call apply() on the thread that holds one.
+         */
+        [[nodiscard]] MergingIterator newIterator() const;
+
+        /**
+         * Visits the live records with keys in [start, end) in key order, tombstoned keys are skipped.
+         * Stops early once `visitor` returns false. Same locking caveat as newIterator().
+         */
+        void scan(const core::Key &start, const core::Key &end,
+                  const std::function<bool(const Record &)> &visitor) const;
+
         std::shared_ptr<MemTable> flushOldestFrozen();
+
+        /**
+         * Returns the oldest frozen MemTable without removing it, nullptr when none is frozen. A flush
+         * writes it out first and only then drops it with flushOldestFrozen(), so it stays readable.
+         */
+        [[nodiscard]] std::shared_ptr<MemTable> oldestFrozen() const;
+
+        [[nodiscard]] size_t frozenCount() const {
+            std::lock_guard lock(this->frozenMutex_);
+            return this->frozen_.size();
+        }
+
+        [[nodiscard]] size_t maxMemTableBytes() const { return this->maxMemTableBytes_; }
     };
 } // namespace memtable
 
@@ -0,0 +1,84 @@
+//
+// Created by frostzt on 10/17/2026.
+//
+
+#include "memtable_record.hpp"
+
+#include <cstring>
+
+
+namespace memtable {
+    Record Record::encode(Arena &arena, const core::Entry &entry) {
+        // Reused per thread so that encoding does not hit the allocator once it has warmed up
+        thread_local std::vector<std::byte> orderedKey;
+        orderedKey.clear();
+        entry.primaryKey_.encodeOrdered(orderedKey);
+
+        // The entry is serialized straight into the arena, the ordered key follows it
+        const size_t entryLength = entry.serializedSize();
+        std::byte *mem = arena.allocate(sizeof(RecordHeader) + entryLength + orderedKey.size());
+
+        const auto header = new(mem) RecordHeader{
+            entry.timestamp_,
+            static_cast<uint32_t>(entryLength),
+            static_cast<uint32_t>(entryLength),
+            static_cast<uint32_t>(orderedKey.size()),
+            entry.isTombstone_,
+        };
+        entry.serializeInto({mem + sizeof(RecordHeader), entryLength});
+        std::memcpy(mem + sizeof(RecordHeader) + entryLength, orderedKey.data(), orderedKey.size());
+
+        return Record{header};
+    }
+
+    Record Record::encode(Arena &arena, const core::EntryView &entry) {
+        thread_local std::vector<std::byte> orderedKey;
+        orderedKey.clear();
+        entry.key().encodeOrdered(orderedKey);
+
+        const auto bytes = entry.bytes();
+        std::byte *mem = arena.allocate(sizeof(RecordHeader) + bytes.size() + orderedKey.size());
+
+        const auto header = new(mem) RecordHeader{
+            entry.timestamp(),
+            static_cast<uint32_t>(bytes.size()),
+            static_cast<uint32_t>(bytes.size()),
+            static_cast<uint32_t>(orderedKey.size()),
+            entry.isTombstone(),
+        };
+        std::memcpy(mem + sizeof(RecordHeader), bytes.data(), bytes.size());
+        std::memcpy(mem + sizeof(RecordHeader) + bytes.size(), orderedKey.data(), orderedKey.size());
+
+        return Record{header};
+    }
+
+    Record Record::probe(const core::Key &key, const uint64_t timestamp, std::vector<std::byte> &scratch) {
+        scratch.assign(sizeof(RecordHeader), std::byte{0});
+        key.encodeOrdered(scratch);
+
+        const RecordHeader header{
+            timestamp, 0, 0, static_cast<uint32_t>(scratch.size() - sizeof(RecordHeader)), false
+        };
+        std::memcpy(scratch.data(), &header, sizeof(RecordHeader));
+
+        return Record{reinterpret_cast<const RecordHeader *>(scratch.data())};
+    }
+
+    Record Record::probe(const std::byte *keyData, const size_t keyLength, const uint64_t timestamp,
+                         std::vector<std::byte> &scratch) {
+        scratch.resize(sizeof(RecordHeader) + keyLength);
+
+        const RecordHeader header{timestamp, 0, 0, static_cast<uint32_t>(keyLength), false};
+        std::memcpy(scratch.data(), &header, sizeof(RecordHeader));
+        std::memcpy(scratch.data() + sizeof(RecordHeader), keyData, keyLength);
+
+        return Record{reinterpret_cast<const RecordHeader *>(scratch.data())};
+    }
+
+    core::Entry Record::toEntry(const core::SchemaRegistry &schemas) const {
+        auto entry = core::Entry::deserialize(this->entryData(), this->entryLength(), schemas);
+        if (!entry.has_value()) throw std::runtime_error("MemTable: failed to decode stored entry");
+
+        return std::move(*entry);
+    }
+} // namespace memtable
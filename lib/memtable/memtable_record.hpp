@@ -0,0 +1,142 @@
+//
+// Created by frostzt on 10/17/2026.
+//
+
+#ifndef ENIGMA_DB_MEMTABLE_RECORD_HPP
+#define ENIGMA_DB_MEMTABLE_RECORD_HPP
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#include "lib/abstract/arena.hpp"
+#include "lib/entry/entry.hpp"
+#include "lib/entry/entry_view.hpp"
+
+namespace memtable {
+    /**
+     * @struct RecordHeader
+     * @brief Fixed-size prefix of every entry a MemTable keeps in its arena.
+     *
+     * The serialized entry (`core::Entry::serialize`) follows the header directly and the primary key
+     * in its `core::Key::encodeOrdered` form follows the entry, the header only caches what ordering
+     * needs so comparisons never decode the entry.
+     */
+    struct RecordHeader {
+        uint64_t timestamp;
+        uint32_t entryLength;
+        uint32_t keyOffset;
+        uint32_t keyLength;
+        bool tombstone;
+    };
+
+    /**
+     * @class Record
+     * @brief Non-owning handle to an encoded entry stored in a MemTable arena.
+     *
+     * Records are what the MemTable structures store: a single pointer, trivially copyable, ordered by
+     * the memcmp of their ordered primary keys. The bytes are owned by the arena the record was
+     * encoded into.
+     */
+    class Record {
+    private:
+        const RecordHeader *header_{nullptr};
+
+    public:
+        Record() = default;
+
+        explicit Record(const RecordHeader *header): header_(header) {
+        }
+
+        /**
+         * @brief Serializes `entry` into `arena` and returns a handle to it.
+         *
+         * @param arena Arena that owns the encoded bytes.
+         * @param entry The entry to encode.
+         * @return A record pointing at the arena copy.
+         */
+        static Record encode(Arena &arena, const core::Entry &entry);
+
+        /**
+         * @brief Copies the bytes of an already serialized entry into `arena`, e.g. one replayed from
+         * the WAL, so it is stored without being decoded and serialized again.
+         */
+        static Record encode(Arena &arena, const core::EntryView &entry);
+
+        /**
+         * @brief Builds a key-only record in `scratch` to search with.
+         *
+         * The returned record is only valid while `scratch` is alive and unmodified; its entry bytes
+         * are empty so it can only be compared, never decoded.
+         *
+         * @param key The primary key to search for.
+         * @param timestamp Version to position the probe at.
+         * @param scratch Buffer the probe is written into.
+         */
+        static Record probe(const core::Key &key, uint64_t timestamp, std::vector<std::byte> &scratch);
+
+        /**
+         * @brief Same as the `core::Key` overload for a key that is already in its ordered form, e.g.
+         * another record's `keyData()`.
+         */
+        static Record probe(const std::byte *keyData, size_t keyLength, uint64_t timestamp,
+                            std::vector<std::byte> &scratch);
+
+        [[nodiscard]] bool isNull() const { return this->header_ == nullptr; }
+
+        [[nodiscard]] uint64_t timestamp() const { return this->header_->timestamp; }
+
+        [[nodiscard]] bool isTombstone() const { return this->header_->tombstone; }
+
+        [[nodiscard]] const std::byte *entryData() const {
+            return reinterpret_cast<const std::byte *>(this->header_ + 1);
+        }
+
+        [[nodiscard]] size_t entryLength() const { return this->header_->entryLength; }
+
+        /** The primary key in its `core::Key::encodeOrdered` form */
+        [[nodiscard]] const std::byte *keyData() const { return this->entryData() + this->header_->keyOffset; }
+
+        [[nodiscard]] size_t keyLength() const { return this->header_->keyLength; }
+
+        /**
+         * @brief Decodes the full entry out of the arena.
+         *
+         * @param schemas Registry of the MemTable the record belongs to, see MemTable::schemas().
+         * @throw std::runtime_error If the stored bytes fail to deserialize.
+         */
+        [[nodiscard]] core::Entry toEntry(const core::SchemaRegistry &schemas = core::SchemaRegistry::global()) const;
+
+        /**
+         * @brief Three-way comparison of the primary keys of two records.
+         */
+        [[nodiscard]] int compareKey(const Record &other) const {
+            return core::Key::compareOrdered(this->keyView(), other.keyView());
+        }
+
+        [[nodiscard]] std::string_view keyView() const {
+            return {reinterpret_cast<const char *>(this->keyData()), this->keyLength()};
+        }
+
+        // AVL Tree orders and de-duplicates records by primary key
+        bool operator<(const Record &other) const { return this->compareKey(other) < 0; }
+
+        bool operator==(const Record &other) const { return this->compareKey(other) == 0; }
+    };
+
+    /**
+     * @struct VersionedRecordComparator
+     * @brief Orders records by primary key ascending and then by timestamp descending.
+     *
+     * Used by the skiplist backend which keeps every version of a key; the newest version of a key
+     * is always the first one a forward seek lands on.
+     */
+    struct VersionedRecordComparator {
+        bool operator()(const Record &lhs, const Record &rhs) const {
+            if (const int cmp = lhs.compareKey(rhs); cmp != 0) return cmp < 0;
+            return lhs.timestamp() > rhs.timestamp();
+        }
+    };
+} // namespace memtable
+
+#endif //ENIGMA_DB_MEMTABLE_RECORD_HPP
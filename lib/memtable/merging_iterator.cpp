@@ -0,0 +1,118 @@
+//
+// Created by frostzt on 10/17/2026.
+//
+
+#include "merging_iterator.hpp"
+
+#include <cassert>
+
+namespace memtable {
+    MergingIterator::MergingIterator(std::vector<std::shared_ptr<MemTable> > tables): tables_(std::move(tables)) {
+        this->children_.reserve(this->tables_.size());
+        for (const auto &table: this->tables_) this->children_.push_back(table->newIterator());
+    }
+
+    bool MergingIterator::newer(const int candidate, const int best) const {
+        // Children are ordered newest table first, so an index tie already favours `best`
+        return this->children_[candidate].record().timestamp() > this->children_[best].record().timestamp();
+    }
+
+    void MergingIterator::findSmallest() {
+        this->current_ = -1;
+        for (int i = 0; i < static_cast<int>(this->children_.size()); ++i) {
+            if (!this->children_[i].valid()) continue;
+            if (this->current_ < 0) {
+                this->current_ = i;
+                continue;
+            }
+
+            const int cmp = this->children_[i].record().compareKey(this->children_[this->current_].record());
+            if (cmp < 0 || (cmp == 0 && this->newer(i, this->current_))) this->current_ = i;
+        }
+    }
+
+    void MergingIterator::findLargest() {
+        this->current_ = -1;
+        for (int i = 0; i < static_cast<int>(this->children_.size()); ++i) {
+            if (!this->children_[i].valid()) continue;
+            if (this->current_ < 0) {
+                this->current_ = i;
+                continue;
+            }
+
+            const int cmp = this->children_[i].record().compareKey(this->children_[this->current_].record());
+            if (cmp > 0 || (cmp == 0 && this->newer(i, this->current_))) this->current_ = i;
+        }
+    }
+
+    void MergingIterator::seekToFirst() {
+        for (auto &child: this->children_) child.seekToFirst();
+        this->direction_ = Direction::Forward;
+        this->findSmallest();
+    }
+
+    void MergingIterator::seekToLast() {
+        for (auto &child: this->children_) child.seekToLast();
+        this->direction_ = Direction::Backward;
+        this->findLargest();
+    }
+
+    void MergingIterator::seek(const core::Key &target) {
+        for (auto &child: this->children_) child.seek(target);
+        this->direction_ = Direction::Forward;
+        this->findSmallest();
+    }
+
+    void MergingIterator::seekForPrev(const core::Key &target) {
+        for (auto &child: this->children_) child.seekForPrev(target);
+        this->direction_ = Direction::Backward;
+        this->findLargest();
+    }
+
+    void MergingIterator::next() {
+        assert(this->valid());
+        const Record current = this->record();
+
+        if (this->direction_ == Direction::Backward) {
+            // Children other than the current one sit before the current key, move them past it
+            for (auto &child: this->children_) {
+                child.seek(current);
+                if (child.valid() && child.record().compareKey(current) == 0) child.next();
+            }
+
+            this->direction_ = Direction::Forward;
+        } else {
+            // Step every child holding the current key, older versions of it included
+            for (auto &child: this->children_) {
+                if (child.valid() && child.record().compareKey(current) == 0) child.next();
+            }
+        }
+
+        this->findSmallest();
+    }
+
+    void MergingIterator::prev() {
+        assert(this->valid());
+        const Record current = this->record();
+
+        if (this->direction_ == Direction::Forward) {
+            // Children sit at or after the current key, move all of them right before it
+            for (auto &child: this->children_) {
+                child.seek(current);
+                if (child.valid()) {
+                    child.prev();
+                } else {
+                    child.seekToLast();
+                }
+            }
+
+            this->direction_ = Direction::Backward;
+        } else {
+            for (auto &child: this->children_) {
+                if (child.valid() && child.record().compareKey(current) == 0) child.prev();
+            }
+        }
+
+        this->findLargest();
+    }
+} // namespace memtable
@@ -0,0 +1,72 @@
+//
+// Created by frostzt on 10/17/2026.
+//
+
+#ifndef ENIGMA_DB_MERGING_ITERATOR_HPP
+#define ENIGMA_DB_MERGING_ITERATOR_HPP
+
+#include <memory>
+#include <vector>
+
+#include "lib/memtable/memtable.hpp"
+
+namespace memtable {
+    /**
+     * @class MergingIterator
+     * @brief Ordered cursor over several MemTables that yields every key once, newest version first.
+     *
+     * When more than one table holds a key, the version with the highest timestamp wins and ties go to
+     * the table that was passed first. The iterator shares ownership of the tables it walks so a
+     * concurrent flush cannot release their arenas from underneath it.
+     */
+    class MergingIterator {
+    private:
+        enum class Direction : uint8_t {
+            Forward,
+            Backward,
+        };
+
+        /** Declared before children_ so the cursors are destroyed (and their locks released) first */
+        std::vector<std::shared_ptr<MemTable> > tables_;
+
+        std::vector<MemTableIterator> children_;
+
+        /** Index of the child the cursor is on, -1 when invalid */
+        int current_{-1};
+
+        Direction direction_{Direction::Forward};
+
+        /** Whether the child at `candidate` should be preferred over `best` at the same key */
+        [[nodiscard]] bool newer(int candidate, int best) const;
+
+        void findSmallest();
+
+        void findLargest();
+
+    public:
+        /**
+         * @param tables The tables to merge, ordered newest first.
+         */
+        explicit MergingIterator(std::vector<std::shared_ptr<MemTable> > tables);
+
+        [[nodiscard]] bool valid() const { return this->current_ >= 0; }
+
+        void seekToFirst();
+
+        void seekToLast();
+
+        void seek(const core::Key &target);
+
+        void seekForPrev(const core::Key &target);
+
+        void next();
+
+        void prev();
+
+        [[nodiscard]] Record record() const { return this->children_[this->current_].record(); }
+
+        [[nodiscard]] core::Entry entry() const { return this->children_[this->current_].entry(); }
+    };
+} // namespace memtable
+
+#endif //ENIGMA_DB_MERGING_ITERATOR_HPP
@@ -0,0 +1,94 @@
+//
+// Created by frostzt on 10/17/2026.
+//
+
+#include "block_cache.hpp"
+
+namespace sstable {
+    BlockCache::BlockCache(const size_t capacityBytes, const size_t shardBits)
+        : capacity_(capacityBytes), shardCapacity_(capacityBytes >> shardBits) {
+        this->shards_.reserve(size_t{1} << shardBits);
+        for (size_t i = 0; i < size_t{1} << shardBits; ++i) {
+            this->shards_.push_back(std::make_unique<Shard>());
+        }
+    }
+
+    BlockCache::Block BlockCache::lookup(const uint64_t fileNumber, const uint64_t offset) {
+        const CacheKey key{fileNumber, offset};
+        Shard &shard = this->shardFor(key);
+
+        std::lock_guard lock(shard.mutex);
+        const auto it = shard.index.find(key);
+        if (it == shard.index.end()) {
+            this->misses_.fetch_add(1, std::memory_order_relaxed);
+            return nullptr;
+        }
+
+        shard.lru.splice(shard.lru.begin(), shard.lru, it->second);
+        this->hits_.fetch_add(1, std::memory_order_relaxed);
+        return it->second->second;
+    }
+
+    void BlockCache::insert(const uint64_t fileNumber, const uint64_t offset, Block block) {
+        const size_t charge = block->size();
+        if (charge > this->shardCapacity_) return;
+
+        const CacheKey key{fileNumber, offset};
+        Shard &shard = this->shardFor(key);
+
+        std::lock_guard lock(shard.mutex);
+        if (const auto it = shard.index.find(key); it != shard.index.end()) {
+            shard.usage -= it->second->second->size();
+            shard.lru.erase(it->second);
+            shard.index.erase(it);
+        }
+
+        while (shard.usage + charge > this->shardCapacity_ && !shard.lru.empty()) {
+            auto &[victimKey, victim] = shard.lru.back();
+            shard.usage -= victim->size();
+            shard.index.erase(victimKey);
+            shard.lru.pop_back();
+            this->evictions_.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        shard.lru.emplace_front(key, std::move(block));
+        shard.index.emplace(key, shard.lru.begin());
+        shard.usage += charge;
+        this->inserts_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void BlockCache::eraseFile(const uint64_t fileNumber) {
+        for (const auto &shard: this->shards_) {
+            std::lock_guard lock(shard->mutex);
+            for (auto it = shard->lru.begin(); it != shard->lru.end();) {
+                if (it->first.fileNumber != fileNumber) {
+                    ++it;
+                    continue;
+                }
+
+                shard->usage -= it->second->size();
+                shard->index.erase(it->first);
+                it = shard->lru.erase(it);
+            }
+        }
+    }
+
+    size_t BlockCache::usage() const {
+        size_t total = 0;
+        for (const auto &shard: this->shards_) {
+            std::lock_guard lock(shard->mutex);
+            total += shard->usage;
+        }
+
+        return total;
+    }
+
+    BlockCache::Stats BlockCache::stats() const {
+        return Stats{
+            this->hits_.load(std::memory_order_relaxed),
+            this->misses_.load(std::memory_order_relaxed),
+            this->inserts_.load(std::memory_order_relaxed),
+            this->evictions_.load(std::memory_order_relaxed),
+        };
+    }
+} // namespace sstable
@@ -0,0 +1,116 @@
+//
+// Created by frostzt on 10/17/2026.
+//
+
+#ifndef ENIGMA_DB_BLOCK_CACHE_HPP
+#define ENIGMA_DB_BLOCK_CACHE_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "lib/utils/constants.hpp"
+
+namespace sstable {
+    /**
+     * @class BlockCache
+     * @brief Sharded LRU cache of uncompressed SSTable blocks, shared by every reader of a database.
+     *
+     * Blocks are keyed by (file number, block offset) and charged by their uncompressed size. The
+     * capacity is split evenly over 2^shardBits shards, each guarded by its own mutex, so readers of
+     * different blocks rarely contend. Cached blocks are handed out as shared pointers and stay valid
+     * after eviction for as long as someone holds them.
+     */
+    class BlockCache {
+    public:
+        using Block = std::shared_ptr<const std::vector<uint8_t> >;
+
+        struct Stats {
+            uint64_t hits = 0;
+            uint64_t misses = 0;
+            uint64_t inserts = 0;
+            uint64_t evictions = 0;
+
+            [[nodiscard]] double hitRate() const {
+                const uint64_t lookups = this->hits + this->misses;
+                return lookups == 0 ? 0.0 : static_cast<double>(this->hits) / static_cast<double>(lookups);
+            }
+        };
+
+        static constexpr size_t kDefaultCapacity = 8_MB;
+        static constexpr size_t kDefaultShardBits = 4;
+
+        explicit BlockCache(size_t capacityBytes = kDefaultCapacity, size_t shardBits = kDefaultShardBits);
+
+        BlockCache(const BlockCache &) = delete;
+
+        BlockCache &operator=(const BlockCache &) = delete;
+
+        /**
+         * Returns the cached block and marks it most recently used, or nullptr on a miss.
+         */
+        Block lookup(uint64_t fileNumber, uint64_t offset);
+
+        /**
+         * Caches `block`, replacing any block already cached under the same key and evicting the
+         * least recently used blocks of the shard until it fits. Blocks larger than a shard are not cached.
+         */
+        void insert(uint64_t fileNumber, uint64_t offset, Block block);
+
+        /**
+         * Drops every cached block of a file, e.g. once compaction deleted it.
+         */
+        void eraseFile(uint64_t fileNumber);
+
+        [[nodiscard]] size_t capacity() const { return this->capacity_; }
+
+        /** Bytes currently charged across all shards */
+        [[nodiscard]] size_t usage() const;
+
+        [[nodiscard]] Stats stats() const;
+
+    private:
+        struct CacheKey {
+            uint64_t fileNumber;
+            uint64_t offset;
+
+            bool operator==(const CacheKey &) const = default;
+        };
+
+        struct CacheKeyHash {
+            size_t operator()(const CacheKey &key) const {
+                // Offsets of one file are distinct, mix the file number in so files do not collide
+                return std::hash<uint64_t>{}(key.offset ^ key.fileNumber * 0x9E3779B97F4A7C15ULL);
+            }
+        };
+
+        struct Shard {
+            std::mutex mutex;
+
+            /** Most recently used block at the front */
+            std::list<std::pair<CacheKey, Block> > lru;
+            std::unordered_map<CacheKey, std::list<std::pair<CacheKey, Block> >::iterator, CacheKeyHash> index;
+
+            size_t usage = 0;
+        };
+
+        size_t capacity_;
+        size_t shardCapacity_;
+        std::vector<std::unique_ptr<Shard> > shards_;
+
+        std::atomic<uint64_t> hits_{0};
+        std::atomic<uint64_t> misses_{0};
+        std::atomic<uint64_t> inserts_{0};
+        std::atomic<uint64_t> evictions_{0};
+
+        Shard &shardFor(const CacheKey &key) {
+            return *this->shards_[CacheKeyHash{}(key) & (this->shards_.size() - 1)];
+        }
+    };
+} // namespace sstable
+
+#endif //ENIGMA_DB_BLOCK_CACHE_HPP
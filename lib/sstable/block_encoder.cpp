@@ -3,3 +3,37 @@
 //
 
 #include "block_encoder.hpp"
+
+#include "format.hpp"
+#include "lib/utils/vint/vint.hpp"
+
+namespace sstable {
+    void BasicBlockEncoder::add(const std::string &key, const std::string &value) {
+        if (this->counter_ == this->restartInterval_ || this->buffer_.empty()) {
+            this->restarts_.push_back(static_cast<uint32_t>(this->buffer_.size()));
+            this->lastKey_.clear();
+            this->counter_ = 0;
+        }
+
+        this->keyEncoder_->encode(this->lastKey_, key, this->buffer_);
+        utility::putVarint32(this->buffer_, static_cast<uint32_t>(value.size()));
+        this->buffer_.insert(this->buffer_.end(), value.begin(), value.end());
+        this->lastKey_ = key;
+        this->counter_++;
+    }
+
+    std::vector<uint8_t> BasicBlockEncoder::finish() {
+        if (!this->buffer_.empty()) {
+            for (const uint32_t restart: this->restarts_) putFixed32(this->buffer_, restart);
+            putFixed32(this->buffer_, static_cast<uint32_t>(this->restarts_.size()));
+        }
+
+        std::vector<uint8_t> block;
+        block.swap(this->buffer_);
+        this->buffer_.reserve(this->blockSize_ + this->blockSize_ / 4);
+        this->restarts_.clear();
+        this->counter_ = 0;
+        this->lastKey_.clear();
+        return block;
+    }
+} // namespace sstable
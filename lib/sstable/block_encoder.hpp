@@ -6,9 +6,13 @@
 #define BLOCK_ENCODER_HPP
 
 #include <cstdint>
+#include <memory>
 #include <string>
 #include <vector>
 
+#include "key_encoder.hpp"
+#include "lib/utils/constants.hpp"
+
 namespace sstable {
     class BlockEncoder {
     public:
@@ -22,6 +26,53 @@ namespace sstable {
 
         [[nodiscard]] virtual size_t estimatedSize() const = 0;
     };
+
+    /**
+     * Packs sorted key/value pairs back to back as `[encoded key][varint32 value length][value]`,
+     * keys going through the given KeyEncoder. Every `restartInterval`th key is a restart point encoded
+     * against an empty previous key; the block ends with the restart offsets (fixed32 each) and their
+     * count (fixed32) so readers can binary search the restart points and only scan between two of them.
+     * Compression and framing are left to the table writer.
+     */
+    class BasicBlockEncoder final : public BlockEncoder {
+    private:
+        std::shared_ptr<KeyEncoder> keyEncoder_;
+        size_t blockSize_;
+        size_t restartInterval_;
+        std::vector<uint8_t> buffer_;
+        std::vector<uint32_t> restarts_;
+
+        /** Keys added since the last restart point */
+        size_t counter_{0};
+        std::string lastKey_;
+
+    public:
+        static constexpr size_t kDefaultBlockSize = 4_KB;
+        static constexpr size_t kDefaultRestartInterval = 16;
+
+        explicit BasicBlockEncoder(std::shared_ptr<KeyEncoder> keyEncoder,
+                                   const size_t blockSize = kDefaultBlockSize,
+                                   const size_t restartInterval = kDefaultRestartInterval)
+            : keyEncoder_(std::move(keyEncoder)), blockSize_(blockSize),
+              restartInterval_(restartInterval == 0 ? 1 : restartInterval) {
+        }
+
+        /**
+         * Appends a pair; keys must arrive in ascending order.
+         */
+        void add(const std::string &key, const std::string &value) override;
+
+        /**
+         * Returns the encoded block, restart trailer included, and resets the encoder for the next one.
+         */
+        std::vector<uint8_t> finish() override;
+
+        [[nodiscard]] bool shouldFlush() const override { return this->estimatedSize() >= this->blockSize_; }
+
+        [[nodiscard]] size_t estimatedSize() const override {
+            return this->buffer_.empty() ? 0 : this->buffer_.size() + (this->restarts_.size() + 1) * sizeof(uint32_t);
+        }
+    };
 } // namespace sstable
 
 #endif //BLOCK_ENCODER_HPP
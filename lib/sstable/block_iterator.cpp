@@ -0,0 +1,102 @@
+//
+// Created by frostzt on 10/17/2026.
+//
+
+#include "block_iterator.hpp"
+
+#include "format.hpp"
+#include "lib/entry/key.hpp"
+#include "lib/utils/vint/vint.hpp"
+
+namespace sstable {
+    BlockIterator::BlockIterator(BlockCache::Block block, KeyEncoder *keyEncoder)
+        : block_(std::move(block)), keyEncoder_(keyEncoder) {
+        // An empty or malformed trailer leaves the block without pairs
+        const size_t size = this->block_->size();
+        if (size < sizeof(uint32_t)) return;
+
+        const uint32_t numRestarts = decodeFixed32(this->block_->data() + size - sizeof(uint32_t));
+        if (numRestarts == 0 || numRestarts > (size - sizeof(uint32_t)) / sizeof(uint32_t)) return;
+
+        this->numRestarts_ = numRestarts;
+        this->dataEnd_ = size - (numRestarts + 1) * sizeof(uint32_t);
+    }
+
+    uint32_t BlockIterator::restartOffset(const uint32_t index) const {
+        return decodeFixed32(this->block_->data() + this->dataEnd_ + index * sizeof(uint32_t));
+    }
+
+    void BlockIterator::seekToRestart(const uint32_t index) {
+        this->next_ = this->restartOffset(index);
+        this->key_.clear();
+        this->parseNext();
+    }
+
+    void BlockIterator::parseNext() {
+        const uint8_t *data = this->block_->data();
+        const uint8_t *limit = data + this->dataEnd_;
+
+        this->current_ = this->next_;
+        if (this->current_ >= this->dataEnd_) {
+            this->valid_ = false;
+            return;
+        }
+
+        size_t read = 0;
+        this->key_ = this->keyEncoder_->decode(this->key_, data + this->current_, read);
+
+        utility::StatusCode status;
+        uint32_t valueLength = 0;
+        const uint8_t *value = utility::getVarint32(status, data + this->current_ + read, limit, valueLength);
+        if (value == nullptr || static_cast<size_t>(limit - value) < valueLength) {
+            this->valid_ = false;
+            return;
+        }
+
+        this->value_ = std::string_view(reinterpret_cast<const char *>(value), valueLength);
+        this->next_ = static_cast<size_t>(value - data) + valueLength;
+        this->valid_ = true;
+    }
+
+    void BlockIterator::seekToFirst() {
+        if (this->numRestarts_ == 0) {
+            this->valid_ = false;
+            return;
+        }
+
+        this->seekToRestart(0);
+    }
+
+    void BlockIterator::seek(const std::string_view target) {
+        if (this->numRestarts_ == 0) {
+            this->valid_ = false;
+            return;
+        }
+
+        // Find the last restart point whose key is less than the target, the target can only sit
+        // between it and the next one
+        uint32_t left = 0;
+        uint32_t right = this->numRestarts_ - 1;
+        const std::string empty;
+        while (left < right) {
+            const uint32_t mid = left + (right - left + 1) / 2;
+
+            size_t read = 0;
+            const std::string key = this->keyEncoder_->decode(empty, this->block_->data() + this->restartOffset(mid),
+                                                              read);
+            if (core::Key::compareOrdered(key, target) < 0) {
+                left = mid;
+            } else {
+                right = mid - 1;
+            }
+        }
+
+        for (this->seekToRestart(left); this->valid_; this->next()) {
+            if (core::Key::compareOrdered(this->key_, target) >= 0) return;
+        }
+    }
+
+    void BlockIterator::next() {
+        this->parseNext();
+    }
+} // namespace sstable
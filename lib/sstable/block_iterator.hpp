@@ -0,0 +1,72 @@
+//
+// Created by frostzt on 10/17/2026.
+//
+
+#ifndef ENIGMA_DB_BLOCK_ITERATOR_HPP
+#define ENIGMA_DB_BLOCK_ITERATOR_HPP
+
+#include <string>
+#include <string_view>
+
+#include "block_cache.hpp"
+#include "key_encoder.hpp"
+
+namespace sstable {
+    /**
+     * @class BlockIterator
+     * @brief Forward cursor over the pairs of one uncompressed block written by BasicBlockEncoder.
+     *
+     * Keys are ordered by `core::Key::compareOrdered`. seek() binary searches the block's restart
+     * points, whose keys are stored in full, and only decodes the pairs following the closest one.
+     * The iterator shares ownership of the block, so values handed out by value() stay valid for as
+     * long as the iterator is alive.
+     */
+    class BlockIterator {
+    private:
+        BlockCache::Block block_;
+        KeyEncoder *keyEncoder_;
+
+        /** End of the pairs, where the restart array begins */
+        size_t dataEnd_{0};
+        uint32_t numRestarts_{0};
+
+        /** Start of the pair under the cursor and of the one after it */
+        size_t current_{0};
+        size_t next_{0};
+
+        std::string key_;
+        std::string_view value_;
+
+        bool valid_{false};
+
+        /** Decodes the pair starting at next_, invalidates the cursor at the end of the block */
+        void parseNext();
+
+        [[nodiscard]] uint32_t restartOffset(uint32_t index) const;
+
+        /** Positions the cursor at restart point `index` */
+        void seekToRestart(uint32_t index);
+
+    public:
+        BlockIterator(BlockCache::Block block, KeyEncoder *keyEncoder);
+
+        [[nodiscard]] bool valid() const { return this->valid_; }
+
+        void seekToFirst();
+
+        /**
+         * Positions the cursor at the first key that is not less than `target` (a serialized primary key).
+         */
+        void seek(std::string_view target);
+
+        void next();
+
+        /** Serialized primary key under the cursor */
+        [[nodiscard]] const std::string &key() const { return this->key_; }
+
+        /** Serialized entry under the cursor */
+        [[nodiscard]] std::string_view value() const { return this->value_; }
+    };
+} // namespace sstable
+
+#endif //ENIGMA_DB_BLOCK_ITERATOR_HPP
@@ -0,0 +1,175 @@
+//
+// Created by frostzt on 10/17/2026.
+//
+
+#include "bloom_filter_policy.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define ENIGMA_BLOOM_X86 1
+#include <immintrin.h>
+#endif
+
+namespace sstable {
+    namespace {
+        using Block = BlockedBloomFilterPolicy::Block;
+
+        // Odd multipliers spreading one 32-bit hash over eight independent bit positions
+        alignas(32) constexpr uint32_t kSalts[BlockedBloomFilterPolicy::kProbes] = {
+            0x47B6137BU, 0x44974D91U, 0x8824AD5BU, 0xA2B7289DU,
+            0x705495C7U, 0x2DF1424BU, 0x9EFC4947U, 0x5C6BFB31U,
+        };
+
+        /** Top 9 bits of the salted hash address a bit within the 512-bit block */
+        constexpr int kPositionShift = 32 - 9;
+
+        size_t blockIndex(const uint64_t hash, const size_t blocks) {
+            return static_cast<size_t>(((hash >> 32) * blocks) >> 32);
+        }
+
+        void insert(Block &block, const uint32_t hash) {
+            for (const uint32_t salt: kSalts) {
+                const uint32_t position = (hash * salt) >> kPositionShift;
+                block.words[position >> 5] |= 1U << (position & 31);
+            }
+        }
+
+        bool probePortable(const Block &block, const uint32_t hash) {
+            for (const uint32_t salt: kSalts) {
+                const uint32_t position = (hash * salt) >> kPositionShift;
+                if ((block.words[position >> 5] & (1U << (position & 31))) == 0) return false;
+            }
+
+            return true;
+        }
+
+#ifdef ENIGMA_BLOOM_X86
+#ifndef _MSC_VER
+        __attribute__((target("avx2")))
+#endif
+        bool probeAVX2(const Block &block, const uint32_t hash) {
+            const __m256i salts = _mm256_load_si256(reinterpret_cast<const __m256i *>(kSalts));
+            const __m256i positions = _mm256_srli_epi32(_mm256_mullo_epi32(_mm256_set1_epi32(static_cast<int>(hash)),
+                                                                           salts), kPositionShift);
+
+            const __m256i wordIndexes = _mm256_srli_epi32(positions, 5);
+            const __m256i masks = _mm256_sllv_epi32(_mm256_set1_epi32(1),
+                                                    _mm256_and_si256(positions, _mm256_set1_epi32(31)));
+            const __m256i words = _mm256_i32gather_epi32(reinterpret_cast<const int *>(block.words), wordIndexes, 4);
+
+            // Every probed bit is set iff (~words & masks) == 0
+            return _mm256_testc_si256(words, masks) != 0;
+        }
+
+        bool cpuHasAVX2() {
+#ifdef _MSC_VER
+            int info[4];
+            __cpuidex(info, 7, 0);
+            return (info[1] & (1 << 5)) != 0;
+#else
+            return __builtin_cpu_supports("avx2");
+#endif
+        }
+#endif
+
+        using ProbeFunction = bool (*)(const Block &, uint32_t);
+
+        ProbeFunction selectProbe() {
+#ifdef ENIGMA_BLOOM_X86
+            if (cpuHasAVX2()) return probeAVX2;
+#endif
+            return probePortable;
+        }
+    } // namespace
+
+    BlockedBloomFilterPolicy::BlockedBloomFilterPolicy(const size_t bitsPerKey)
+        : bitsPerKey_(std::max<size_t>(bitsPerKey, 1)) {
+    }
+
+    bool BlockedBloomFilterPolicy::hasAVX2Probe() {
+#ifdef ENIGMA_BLOOM_X86
+        return cpuHasAVX2();
+#else
+        return false;
+#endif
+    }
+
+    void BlockedBloomFilterPolicy::add(const std::string_view key) {
+        this->hashes_.push_back(filterHash(key));
+    }
+
+    const Block &BlockedBloomFilterPolicy::blockFor(const uint64_t hash) const {
+        return this->blocks_[blockIndex(hash, this->blocks_.size())];
+    }
+
+    bool BlockedBloomFilterPolicy::mayContain(const std::string_view key) const {
+        static const ProbeFunction probe = selectProbe();
+
+        const uint64_t hash = filterHash(key);
+        if (this->blocks_.empty()) {
+            return std::find(this->hashes_.begin(), this->hashes_.end(), hash) != this->hashes_.end();
+        }
+
+        return probe(this->blockFor(hash), static_cast<uint32_t>(hash));
+    }
+
+    bool BlockedBloomFilterPolicy::mayContainPortable(const std::string_view key) const {
+        const uint64_t hash = filterHash(key);
+        if (this->blocks_.empty()) {
+            return std::find(this->hashes_.begin(), this->hashes_.end(), hash) != this->hashes_.end();
+        }
+
+        return probePortable(this->blockFor(hash), static_cast<uint32_t>(hash));
+    }
+
+    void BlockedBloomFilterPolicy::serialize(std::vector<uint8_t> *out) const {
+        const size_t bits = std::max<size_t>(this->hashes_.size() * this->bitsPerKey_, 1);
+        const size_t count = (bits + kBlockBits - 1) / kBlockBits;
+
+        std::vector<Block> blocks(count, Block{});
+        for (const uint64_t hash: this->hashes_) {
+            insert(blocks[blockIndex(hash, count)], static_cast<uint32_t>(hash));
+        }
+
+        const size_t start = out->size();
+        out->resize(start + count * kBlockBytes + sizeof(uint32_t));
+
+        uint8_t *p = out->data() + start;
+        for (const auto &block: blocks) {
+            for (const uint32_t word: block.words) {
+                for (int i = 0; i < 4; ++i) *p++ = static_cast<uint8_t>(word >> (8 * i));
+            }
+        }
+
+        const auto blockCount = static_cast<uint32_t>(count);
+        for (int i = 0; i < 4; ++i) *p++ = static_cast<uint8_t>(blockCount >> (8 * i));
+    }
+
+    void BlockedBloomFilterPolicy::deserialize(const uint8_t *data, const size_t len) {
+        this->hashes_.clear();
+
+        uint32_t count = 0;
+        if (len >= sizeof(uint32_t)) {
+            for (int i = 0; i < 4; ++i) count |= static_cast<uint32_t>(data[len - 4 + i]) << (8 * i);
+        }
+
+        // A filter that cannot be read must never rule a key out, fall back to one that matches everything
+        if (count == 0 || static_cast<size_t>(count) * kBlockBytes != len - sizeof(uint32_t)) {
+            Block all;
+            std::memset(all.words, 0xFF, sizeof(all.words));
+            this->blocks_.assign(1, all);
+            return;
+        }
+
+        this->blocks_.resize(count);
+        for (auto &block: this->blocks_) {
+            for (uint32_t &word: block.words) {
+                word = static_cast<uint32_t>(data[0]) | static_cast<uint32_t>(data[1]) << 8 |
+                       static_cast<uint32_t>(data[2]) << 16 | static_cast<uint32_t>(data[3]) << 24;
+                data += 4;
+            }
+        }
+    }
+} // namespace sstable
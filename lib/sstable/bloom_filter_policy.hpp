@@ -0,0 +1,76 @@
+//
+// Created by frostzt on 10/17/2026.
+//
+
+#ifndef ENIGMA_DB_BLOOM_FILTER_POLICY_HPP
+#define ENIGMA_DB_BLOOM_FILTER_POLICY_HPP
+
+#include <cstdint>
+#include <vector>
+
+#include "filter_policy.hpp"
+
+namespace sstable {
+    /**
+     * @class BlockedBloomFilterPolicy
+     * @brief Bloom filter whose probes for a key all land in one 64-byte, cache-line aligned block.
+     *
+     * The upper half of a key's hash picks the block, the lower half is multiplied by eight odd salts
+     * to derive one bit position per probe, so a lookup costs a single cache miss. With AVX2 the eight
+     * positions are computed, gathered and tested in a handful of instructions. At 10 bits per key the
+     * false positive rate is a little under 1%.
+     *
+     * Keys are hashed as they are added and the filter is sized once serialize() knows the final
+     * count. mayContain() is meant for deserialized filters; while a filter is still being built it
+     * answers exactly from the added hashes.
+     *
+     * Serialized layout: the blocks (16 little-endian u32 words each) followed by the block count (u32).
+     */
+    class BlockedBloomFilterPolicy final : public FilterPolicy {
+    public:
+        static constexpr size_t kBlockBytes = 64;
+        static constexpr size_t kBlockBits = kBlockBytes * 8;
+        static constexpr size_t kProbes = 8;
+        static constexpr size_t kDefaultBitsPerKey = 10;
+
+        explicit BlockedBloomFilterPolicy(size_t bitsPerKey = kDefaultBitsPerKey);
+
+        void add(std::string_view key) override;
+
+        [[nodiscard]] bool mayContain(std::string_view key) const override;
+
+        /**
+         * Same answer as mayContain() without the AVX2 path, for comparison in benchmarks.
+         */
+        [[nodiscard]] bool mayContainPortable(std::string_view key) const;
+
+        void serialize(std::vector<uint8_t> *out) const override;
+
+        void deserialize(const uint8_t *data, size_t len) override;
+
+        [[nodiscard]] std::string_view name() const override {
+            return std::string_view{"bloom.blocked"};
+        }
+
+        [[nodiscard]] size_t blockCount() const { return this->blocks_.size(); }
+
+        /** Whether mayContain() probes with AVX2 on this machine */
+        static bool hasAVX2Probe();
+
+        struct alignas(kBlockBytes) Block {
+            uint32_t words[kBlockBytes / sizeof(uint32_t)];
+        };
+
+    private:
+        size_t bitsPerKey_;
+
+        /** Hashes added since construction, turned into blocks by serialize() */
+        std::vector<uint64_t> hashes_;
+
+        std::vector<Block> blocks_;
+
+        [[nodiscard]] const Block &blockFor(uint64_t hash) const;
+    };
+} // namespace sstable
+
+#endif //ENIGMA_DB_BLOOM_FILTER_POLICY_HPP
@@ -3,3 +3,56 @@
 //
 
 #include "filter_policy.hpp"
+
+#include "bloom_filter_policy.hpp"
+#include "ribbon_filter_policy.hpp"
+
+namespace sstable {
+    uint64_t filterHash(const std::string_view key) {
+        constexpr uint64_t m = 0xC6A4A7935BD1E995ULL;
+        constexpr int r = 47;
+
+        const auto *data = reinterpret_cast<const uint8_t *>(key.data());
+        const size_t length = key.size();
+        uint64_t h = 0x9747B28CULL ^ (length * m);
+
+        // Bytes are assembled little-endian by hand so the hash does not depend on the host
+        const size_t blocks = length / 8;
+        for (size_t i = 0; i < blocks; ++i) {
+            uint64_t k = 0;
+            for (int b = 0; b < 8; ++b) k |= static_cast<uint64_t>(data[i * 8 + b]) << (8 * b);
+
+            k *= m;
+            k ^= k >> r;
+            k *= m;
+
+            h ^= k;
+            h *= m;
+        }
+
+        const uint8_t *tail = data + blocks * 8;
+        switch (length & 7) {
+            case 7: h ^= static_cast<uint64_t>(tail[6]) << 48; [[fallthrough]];
+            case 6: h ^= static_cast<uint64_t>(tail[5]) << 40; [[fallthrough]];
+            case 5: h ^= static_cast<uint64_t>(tail[4]) << 32; [[fallthrough]];
+            case 4: h ^= static_cast<uint64_t>(tail[3]) << 24; [[fallthrough]];
+            case 3: h ^= static_cast<uint64_t>(tail[2]) << 16; [[fallthrough]];
+            case 2: h ^= static_cast<uint64_t>(tail[1]) << 8; [[fallthrough]];
+            case 1: h ^= static_cast<uint64_t>(tail[0]);
+                h *= m;
+            default: break;
+        }
+
+        h ^= h >> r;
+        h *= m;
+        h ^= h >> r;
+        return h;
+    }
+
+    std::unique_ptr<FilterPolicy> createFilterPolicy(const std::string_view name) {
+        if (name == BlockedBloomFilterPolicy().name()) return std::make_unique<BlockedBloomFilterPolicy>();
+        if (name == RibbonFilterPolicy().name()) return std::make_unique<RibbonFilterPolicy>();
+
+        return nullptr;
+    }
+} // namespace sstable
@@ -6,7 +6,8 @@
 #define FILTER_POLICY_HPP
 
 #include <cstdint>
-#include <string>
+#include <memory>
+#include <string_view>
 #include <vector>
 
 namespace sstable {
@@ -14,9 +15,9 @@ namespace sstable {
     public:
         virtual ~FilterPolicy() = default;
 
-        virtual void add(const std::string &key) = 0;
+        virtual void add(std::string_view key) = 0;
 
-        [[nodiscard]] virtual bool mayContain(const std::string &key) const = 0;
+        [[nodiscard]] virtual bool mayContain(std::string_view key) const = 0;
 
         virtual void serialize(std::vector<uint8_t> *out) const = 0;
 
@@ -24,6 +25,20 @@ namespace sstable {
 
         [[nodiscard]] virtual std::string_view name() const = 0;
     };
+
+    /**
+     * 64-bit hash (MurmurHash64A) every filter policy derives its probes from; stable across
+     * platforms because serialized filters depend on it.
+     */
+    uint64_t filterHash(std::string_view key);
+
+    /**
+     * Creates an empty policy of the kind named `name` (a `FilterPolicy::name()`), ready to
+     * deserialize a filter block written by that policy.
+     *
+     * @return The policy, or nullptr for an unknown name.
+     */
+    std::unique_ptr<FilterPolicy> createFilterPolicy(std::string_view name);
 } // namespace sstable
 
 #endif //FILTER_POLICY_HPP
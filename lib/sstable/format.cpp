@@ -0,0 +1,137 @@
+//
+// Created by frostzt on 10/17/2026.
+//
+
+#include "format.hpp"
+
+#include <algorithm>
+#include <cstdio>
+
+#include "lib/utils/crypto_utils.hpp"
+#include "lib/utils/vint/vint.hpp"
+
+namespace sstable {
+    namespace {
+        const uint8_t *getString(const uint8_t *data, const uint8_t *limit, std::string &out) {
+            utility::StatusCode status;
+            uint32_t length = 0;
+            data = utility::getVarint32(status, data, limit, length);
+            if (data == nullptr || static_cast<size_t>(limit - data) < length) return nullptr;
+
+            out.assign(reinterpret_cast<const char *>(data), length);
+            return data + length;
+        }
+
+        void putString(std::vector<uint8_t> &out, const std::string &value) {
+            utility::putVarint32(out, static_cast<uint32_t>(value.size()));
+            out.insert(out.end(), value.begin(), value.end());
+        }
+    } // namespace
+
+    void BlockHandle::encodeTo(std::vector<uint8_t> &out) const {
+        utility::putVarint64(out, this->offset);
+        utility::putVarint64(out, this->size);
+    }
+
+    const uint8_t *BlockHandle::decodeFrom(const uint8_t *data, const uint8_t *limit) {
+        utility::StatusCode status;
+        data = utility::getVarint64(status, data, limit, this->offset);
+        if (data == nullptr) return nullptr;
+        return utility::getVarint64(status, data, limit, this->size);
+    }
+
+    void BlockHeader::encodeTo(std::vector<uint8_t> &out) const {
+        putFixed32(out, this->compressedSize);
+        putFixed32(out, this->uncompressedSize);
+        out.push_back(static_cast<uint8_t>(this->compression));
+        putFixed32(out, this->checksum);
+    }
+
+    BlockHeader BlockHeader::decode(const uint8_t *data) {
+        BlockHeader header;
+        header.compressedSize = decodeFixed32(data);
+        header.uncompressedSize = decodeFixed32(data + 4);
+        header.compression = static_cast<compression::CompressorID>(data[8]);
+        header.checksum = decodeFixed32(data + 9);
+        return header;
+    }
+
+    void Footer::encodeTo(std::vector<uint8_t> &out) const {
+        const size_t start = out.size();
+        for (const auto &handle: {this->index, this->filter, this->meta}) {
+            putFixed64(out, handle.offset);
+            putFixed64(out, handle.size);
+        }
+
+        out.push_back(static_cast<uint8_t>(this->compressor));
+        out.push_back(this->formatVersion);
+
+        const size_t nameLength = std::min(this->filterName.size(), kMaxFilterNameLength);
+        out.insert(out.end(), this->filterName.begin(), this->filterName.begin() + static_cast<std::ptrdiff_t>(nameLength));
+        out.insert(out.end(), kMaxFilterNameLength - nameLength, 0);
+
+        const auto *begin = reinterpret_cast<const std::byte *>(out.data() + start);
+        putFixed32(out, Utility::computeCRC32(begin, 0, out.size() - start));
+        out.insert(out.end(), kTableMagic.begin(), kTableMagic.end());
+    }
+
+    std::optional<Footer> Footer::decode(const uint8_t *data) {
+        constexpr size_t checksumOffset = kEncodedLength - kTableMagic.size() - 4;
+        if (std::memcmp(data + checksumOffset + 4, kTableMagic.data(), kTableMagic.size()) != 0) return std::nullopt;
+
+        const uint32_t expected = decodeFixed32(data + checksumOffset);
+        if (Utility::computeCRC32(reinterpret_cast<const std::byte *>(data), 0, checksumOffset) != expected) {
+            return std::nullopt;
+        }
+
+        Footer footer;
+        BlockHandle *handles[] = {&footer.index, &footer.filter, &footer.meta};
+        for (size_t i = 0; i < 3; ++i) {
+            handles[i]->offset = decodeFixed64(data + i * 16);
+            handles[i]->size = decodeFixed64(data + i * 16 + 8);
+        }
+
+        footer.compressor = static_cast<compression::CompressorID>(data[48]);
+        footer.formatVersion = data[49];
+        if (footer.formatVersion != kFormatVersion) return std::nullopt;
+
+        const auto *name = reinterpret_cast<const char *>(data + 50);
+        footer.filterName.assign(name, std::find(name, name + kMaxFilterNameLength, '\0'));
+
+        return footer;
+    }
+
+    void TableProperties::encodeTo(std::vector<uint8_t> &out) const {
+        for (const uint64_t value: {this->entries, this->tombstones, this->dataBlocks, this->rawKeyBytes,
+                                    this->rawValueBytes, this->minTimestamp, this->maxTimestamp}) {
+            utility::putVarint64(out, value);
+        }
+
+        putString(out, this->smallestKey);
+        putString(out, this->largestKey);
+    }
+
+    std::optional<TableProperties> TableProperties::decode(const uint8_t *data, const size_t length) {
+        const uint8_t *limit = data + length;
+
+        TableProperties props;
+        utility::StatusCode status;
+        for (uint64_t *value: {&props.entries, &props.tombstones, &props.dataBlocks, &props.rawKeyBytes,
+                               &props.rawValueBytes, &props.minTimestamp, &props.maxTimestamp}) {
+            data = utility::getVarint64(status, data, limit, *value);
+            if (data == nullptr) return std::nullopt;
+        }
+
+        data = getString(data, limit, props.smallestKey);
+        if (data == nullptr) return std::nullopt;
+        if (getString(data, limit, props.largestKey) == nullptr) return std::nullopt;
+
+        return props;
+    }
+
+    std::string tableFileName(const uint64_t number) {
+        char name[32];
+        std::snprintf(name, sizeof(name), "%06llu.sst", static_cast<unsigned long long>(number));
+        return name;
+    }
+} // namespace sstable
@@ -0,0 +1,150 @@
+//
+// Created by frostzt on 10/17/2026.
+//
+
+#ifndef ENIGMA_DB_SSTABLE_FORMAT_HPP
+#define ENIGMA_DB_SSTABLE_FORMAT_HPP
+
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "lib/compression/compressor.hpp"
+
+/**
+ * On-disk layout shared by the SSTable writer and reader, see lib/sstable/README.md.
+ *
+ * Every block is framed by a BlockHeader and addressed by a BlockHandle spanning header and
+ * payload. Integers are little-endian; lengths inside blocks are varints.
+ */
+namespace sstable {
+    static constexpr std::string_view kTableMagic = "ENIGSSTB";
+    static constexpr uint8_t kFormatVersion = 4;
+
+    inline void putFixed32(std::vector<uint8_t> &out, const uint32_t value) {
+        for (int i = 0; i < 4; ++i) out.push_back(static_cast<uint8_t>((value >> 8 * i) & 0xFF));
+    }
+
+    inline void putFixed64(std::vector<uint8_t> &out, const uint64_t value) {
+        for (int i = 0; i < 8; ++i) out.push_back(static_cast<uint8_t>((value >> 8 * i) & 0xFF));
+    }
+
+    inline uint32_t decodeFixed32(const uint8_t *data) {
+        uint32_t value = 0;
+        for (int i = 0; i < 4; ++i) value |= static_cast<uint32_t>(data[i]) << 8 * i;
+        return value;
+    }
+
+    inline uint64_t decodeFixed64(const uint8_t *data) {
+        uint64_t value = 0;
+        for (int i = 0; i < 8; ++i) value |= static_cast<uint64_t>(data[i]) << 8 * i;
+        return value;
+    }
+
+    /**
+     * @struct BlockHandle
+     * @brief Location of a framed block (header + payload) inside a table file.
+     */
+    struct BlockHandle {
+        uint64_t offset = 0;
+        uint64_t size = 0;
+
+        [[nodiscard]] bool isNull() const { return this->size == 0; }
+
+        /** Appends the handle as two varints, the form index entries store it in */
+        void encodeTo(std::vector<uint8_t> &out) const;
+
+        /**
+         * Decodes a handle written by encodeTo().
+         *
+         * @return Pointer past the handle, or nullptr if the bytes are malformed.
+         */
+        const uint8_t *decodeFrom(const uint8_t *data, const uint8_t *limit);
+    };
+
+    /**
+     * @struct BlockHeader
+     * @brief Fixed-size frame in front of every block payload.
+     *
+     * The checksum is the CRC32C of the (possibly compressed) payload as stored on disk.
+     */
+    struct BlockHeader {
+        static constexpr size_t kEncodedLength = 13;
+
+        uint32_t compressedSize = 0;
+        uint32_t uncompressedSize = 0;
+        compression::CompressorID compression = compression::CompressorID::Noop;
+        uint32_t checksum = 0;
+
+        void encodeTo(std::vector<uint8_t> &out) const;
+
+        static BlockHeader decode(const uint8_t *data);
+    };
+
+    /**
+     * @struct Footer
+     * @brief Fixed-size trailer at the very end of a table file.
+     *
+     * Layout: index, filter and meta handles as fixed64 pairs, compressor id (u8), format version
+     * (u8), the `FilterPolicy::name()` of the filter block zero-padded to kMaxFilterNameLength bytes,
+     * CRC32C of everything before it (u32) and the 8 byte magic.
+     */
+    struct Footer {
+        static constexpr size_t kMaxFilterNameLength = 16;
+        static constexpr size_t kEncodedLength = 3 * 16 + 1 + 1 + kMaxFilterNameLength + 4 + 8;
+
+        BlockHandle index;
+        BlockHandle filter;
+        BlockHandle meta;
+        compression::CompressorID compressor = compression::CompressorID::Noop;
+        uint8_t formatVersion = kFormatVersion;
+
+        /** Policy that wrote the filter block, empty without one; longer names are truncated */
+        std::string filterName;
+
+        void encodeTo(std::vector<uint8_t> &out) const;
+
+        /**
+         * Decodes the last kEncodedLength bytes of a table file.
+         *
+         * @return The footer, or std::nullopt if the magic, version or checksum do not match.
+         */
+        static std::optional<Footer> decode(const uint8_t *data);
+    };
+
+    /**
+     * @struct TableProperties
+     * @brief Summary of a table stored in its meta block, enough to place the table in a level
+     * without reading any data block.
+     */
+    struct TableProperties {
+        uint64_t entries = 0;
+        uint64_t tombstones = 0;
+        uint64_t dataBlocks = 0;
+        uint64_t rawKeyBytes = 0;
+        uint64_t rawValueBytes = 0;
+        uint64_t minTimestamp = UINT64_MAX;
+        uint64_t maxTimestamp = 0;
+
+        /** Primary keys (`core::Key::encodeOrdered` form) of the first and last entry */
+        std::string smallestKey;
+        std::string largestKey;
+
+        /** Total size of the table file, not stored in the meta block */
+        uint64_t fileSize = 0;
+
+        void encodeTo(std::vector<uint8_t> &out) const;
+
+        static std::optional<TableProperties> decode(const uint8_t *data, size_t length);
+    };
+
+    /**
+     * Returns the file name of table number `number`, e.g. "000042.sst".
+     */
+    std::string tableFileName(uint64_t number);
+} // namespace sstable
+
+#endif //ENIGMA_DB_SSTABLE_FORMAT_HPP
@@ -3,3 +3,55 @@
 //
 
 #include "key_encoder.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+#include "lib/utils/vint/vint.hpp"
+
+namespace sstable {
+    void RawKeyEncoder::encode(const std::string &, const std::string &currentKey, std::vector<uint8_t> &out) {
+        utility::putVarint32(out, static_cast<uint32_t>(currentKey.size()));
+        out.insert(out.end(), currentKey.begin(), currentKey.end());
+    }
+
+    std::string RawKeyEncoder::decode(const std::string &, const uint8_t *data, size_t &bytesRead) {
+        // Blocks are checksummed before they are decoded, so the varint is trusted to be complete
+        utility::StatusCode status;
+        uint32_t length = 0;
+        const uint8_t *key = utility::getVarint32(status, data, data + 5, length);
+        assert(key != nullptr);
+
+        bytesRead = static_cast<size_t>(key - data) + length;
+        return {reinterpret_cast<const char *>(key), length};
+    }
+
+    void PrefixKeyEncoder::encode(const std::string &lastKey, const std::string &currentKey,
+                                  std::vector<uint8_t> &out) {
+        const size_t limit = std::min(lastKey.size(), currentKey.size());
+        size_t shared = 0;
+        while (shared < limit && lastKey[shared] == currentKey[shared]) ++shared;
+
+        utility::putVarint32(out, static_cast<uint32_t>(shared));
+        utility::putVarint32(out, static_cast<uint32_t>(currentKey.size() - shared));
+        out.insert(out.end(), currentKey.begin() + static_cast<std::ptrdiff_t>(shared), currentKey.end());
+    }
+
+    std::string PrefixKeyEncoder::decode(const std::string &lastKey, const uint8_t *data, size_t &bytesRead) {
+        utility::StatusCode status;
+        uint32_t shared = 0;
+        uint32_t nonShared = 0;
+        const uint8_t *p = utility::getVarint32(status, data, data + 5, shared);
+        assert(p != nullptr);
+        p = utility::getVarint32(status, p, p + 5, nonShared);
+        assert(p != nullptr && shared <= lastKey.size());
+
+        bytesRead = static_cast<size_t>(p - data) + nonShared;
+
+        std::string key;
+        key.reserve(shared + nonShared);
+        key.append(lastKey, 0, shared);
+        key.append(reinterpret_cast<const char *>(p), nonShared);
+        return key;
+    }
+} // namespace sstable
@@ -20,6 +20,36 @@ namespace sstable {
 
         [[nodiscard]] virtual std::string_view name() const = 0;
     };
+
+    /**
+     * Stores every key in full as a varint32 length followed by the key bytes; `lastKey` is ignored.
+     */
+    class RawKeyEncoder final : public KeyEncoder {
+    public:
+        void encode(const std::string &lastKey, const std::string &currentKey, std::vector<uint8_t> &out) override;
+
+        std::string decode(const std::string &lastKey, const uint8_t *data, size_t &bytesRead) override;
+
+        [[nodiscard]] std::string_view name() const override {
+            return std::string_view{"raw"};
+        }
+    };
+
+    /**
+     * Stores only what a key does not share with `lastKey`: varint32 shared prefix length, varint32
+     * suffix length and the suffix bytes. Passing an empty `lastKey` stores the key in full, which is
+     * what block restart points rely on.
+     */
+    class PrefixKeyEncoder final : public KeyEncoder {
+    public:
+        void encode(const std::string &lastKey, const std::string &currentKey, std::vector<uint8_t> &out) override;
+
+        std::string decode(const std::string &lastKey, const uint8_t *data, size_t &bytesRead) override;
+
+        [[nodiscard]] std::string_view name() const override {
+            return std::string_view{"prefix"};
+        }
+    };
 } // namespace sstable
 
 #endif //KEY_ENCODER_HPP
@@ -0,0 +1,196 @@
+//
+// Created by frostzt on 10/17/2026.
+//
+
+#include "ribbon_filter_policy.hpp"
+
+#include <algorithm>
+#include <bit>
+
+namespace sstable {
+    namespace {
+        constexpr size_t kWidth = 64;
+
+        /** Attempts with fresh seeds before the table is grown */
+        constexpr uint32_t kSeedsPerSize = 4;
+
+        struct Row {
+            size_t start;
+            uint64_t coefficients;
+            uint8_t result;
+        };
+
+        uint64_t mix(uint64_t x) {
+            x ^= x >> 30;
+            x *= 0xBF58476D1CE4E5B9ULL;
+            x ^= x >> 27;
+            x *= 0x94D049BB133111EBULL;
+            x ^= x >> 31;
+            return x;
+        }
+
+        Row rowFor(const uint64_t hash, const uint32_t seed, const size_t blocks, const size_t resultBits) {
+            const uint64_t a = mix(hash ^ (static_cast<uint64_t>(seed) + 1) * 0x9E3779B97F4A7C15ULL);
+            const uint64_t b = mix(a);
+
+            // Rows must fit entirely inside the table, so the last kWidth - 1 slots are never a start
+            const uint64_t starts = blocks * kWidth - kWidth + 1;
+            return Row{
+                static_cast<size_t>(((a >> 32) * starts) >> 32),
+                b | 1,
+                static_cast<uint8_t>(a & ((1U << resultBits) - 1)),
+            };
+        }
+
+        /** Slots for `keys` keys with enough slack for the banding to succeed almost always */
+        size_t initialBlocks(const size_t keys) {
+            const size_t slots = keys + keys / 8 + kWidth;
+            return (slots + kWidth - 1) / kWidth;
+        }
+
+        /**
+         * Gaussian elimination on the fly: every row is reduced against the rows already stored until
+         * it finds an empty pivot slot.
+         *
+         * @return false if a row reduced to zero with a non-zero result, i.e. the system has no solution.
+         */
+        bool band(const std::vector<uint64_t> &hashes, const uint32_t seed, const size_t blocks, const size_t resultBits,
+                  std::vector<uint64_t> &coefficients, std::vector<uint8_t> &results) {
+            coefficients.assign(blocks * kWidth, 0);
+            results.assign(blocks * kWidth, 0);
+
+            for (const uint64_t hash: hashes) {
+                auto [start, row, result] = rowFor(hash, seed, blocks, resultBits);
+
+                while (true) {
+                    if (coefficients[start] == 0) {
+                        coefficients[start] = row;
+                        results[start] = result;
+                        break;
+                    }
+
+                    row ^= coefficients[start];
+                    result ^= results[start];
+                    if (row == 0) {
+                        // Duplicate keys reduce to 0 == 0 and are simply dropped
+                        if (result != 0) return false;
+                        break;
+                    }
+
+                    const int shift = std::countr_zero(row);
+                    start += static_cast<size_t>(shift);
+                    row >>= shift;
+                }
+            }
+
+            return true;
+        }
+
+        /** Back substitution from the last slot down, one shift register per fingerprint bit */
+        std::vector<uint64_t> solve(const std::vector<uint64_t> &coefficients, const std::vector<uint8_t> &results,
+                                    const size_t blocks, const size_t resultBits) {
+            std::vector<uint64_t> solution(blocks * resultBits, 0);
+            uint64_t state[8] = {};
+
+            for (size_t slot = blocks * kWidth; slot-- > 0;) {
+                const uint64_t row = coefficients[slot];
+                const size_t block = slot / kWidth;
+                const size_t bit = slot % kWidth;
+
+                for (size_t j = 0; j < resultBits; ++j) {
+                    // state holds the solution of the following slots at bits 1..63
+                    state[j] <<= 1;
+                    const uint64_t value = ((results[slot] >> j) & 1) ^ (std::popcount(state[j] & row) & 1);
+                    state[j] |= value;
+                    solution[block * resultBits + j] |= value << bit;
+                }
+            }
+
+            return solution;
+        }
+    } // namespace
+
+    RibbonFilterPolicy::RibbonFilterPolicy(const size_t resultBits)
+        : resultBits_(std::clamp<size_t>(resultBits, 1, 8)) {
+    }
+
+    void RibbonFilterPolicy::add(const std::string_view key) {
+        this->hashes_.push_back(filterHash(key));
+    }
+
+    bool RibbonFilterPolicy::mayContain(const std::string_view key) const {
+        if (this->matchAll_) return true;
+
+        const uint64_t hash = filterHash(key);
+        if (this->solution_.empty()) {
+            return std::find(this->hashes_.begin(), this->hashes_.end(), hash) != this->hashes_.end();
+        }
+
+        const auto [start, row, result] = rowFor(hash, this->seed_, this->blocks_, this->resultBits_);
+        const size_t block = start / kWidth;
+        const size_t shift = start % kWidth;
+
+        const uint64_t *lo = this->solution_.data() + block * this->resultBits_;
+        const uint64_t *hi = lo + this->resultBits_;
+        for (size_t j = 0; j < this->resultBits_; ++j) {
+            const uint64_t window = shift == 0 ? lo[j] : lo[j] >> shift | hi[j] << (kWidth - shift);
+            if (static_cast<uint8_t>(std::popcount(window & row) & 1) != ((result >> j) & 1)) return false;
+        }
+
+        return true;
+    }
+
+    void RibbonFilterPolicy::serialize(std::vector<uint8_t> *out) const {
+        std::vector<uint64_t> coefficients;
+        std::vector<uint8_t> results;
+
+        size_t blocks = initialBlocks(this->hashes_.size());
+        uint32_t seed = 0;
+        while (!band(this->hashes_, seed, blocks, this->resultBits_, coefficients, results)) {
+            // Bad luck with the seed is the usual cause, a table that is too tight the rare one
+            if (++seed % kSeedsPerSize == 0) blocks += blocks / 16 + 1;
+        }
+
+        const auto solution = solve(coefficients, results, blocks, this->resultBits_);
+
+        out->reserve(out->size() + solution.size() * sizeof(uint64_t) + 9);
+        for (const uint64_t word: solution) {
+            for (int i = 0; i < 8; ++i) out->push_back(static_cast<uint8_t>(word >> (8 * i)));
+        }
+
+        for (int i = 0; i < 4; ++i) out->push_back(static_cast<uint8_t>(blocks >> (8 * i)));
+        for (int i = 0; i < 4; ++i) out->push_back(static_cast<uint8_t>(seed >> (8 * i)));
+        out->push_back(static_cast<uint8_t>(this->resultBits_));
+    }
+
+    void RibbonFilterPolicy::deserialize(const uint8_t *data, const size_t len) {
+        this->hashes_.clear();
+        this->solution_.clear();
+        this->matchAll_ = true;
+        if (len < 9) return;
+
+        const uint8_t *trailer = data + len - 9;
+        uint32_t blocks = 0;
+        uint32_t seed = 0;
+        for (int i = 0; i < 4; ++i) {
+            blocks |= static_cast<uint32_t>(trailer[i]) << (8 * i);
+            seed |= static_cast<uint32_t>(trailer[4 + i]) << (8 * i);
+        }
+
+        const size_t resultBits = trailer[8];
+        if (blocks == 0 || resultBits == 0 || resultBits > 8) return;
+        if (static_cast<size_t>(blocks) * resultBits * sizeof(uint64_t) != len - 9) return;
+
+        this->blocks_ = blocks;
+        this->seed_ = seed;
+        this->resultBits_ = resultBits;
+        this->solution_.resize(static_cast<size_t>(blocks) * resultBits);
+        for (auto &word: this->solution_) {
+            word = 0;
+            for (int i = 0; i < 8; ++i) word |= static_cast<uint64_t>(data[i]) << (8 * i);
+            data += 8;
+        }
+
+        this->matchAll_ = false;
+    }
+} // namespace sstable
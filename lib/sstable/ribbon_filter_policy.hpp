@@ -0,0 +1,69 @@
+//
+// Created by frostzt on 10/17/2026.
+//
+
+#ifndef ENIGMA_DB_RIBBON_FILTER_POLICY_HPP
+#define ENIGMA_DB_RIBBON_FILTER_POLICY_HPP
+
+#include <cstdint>
+#include <vector>
+
+#include "filter_policy.hpp"
+
+namespace sstable {
+    /**
+     * @class RibbonFilterPolicy
+     * @brief Standard Ribbon filter (Dillinger & Walzer) with 64-bit coefficient rows.
+     *
+     * Every key maps to a start slot, a 64-bit coefficient row and an r-bit fingerprint; building the
+     * filter solves the linear system "XOR of the slots selected by the row == fingerprint" over GF(2)
+     * and stores one r-bit solution per slot. A query recomputes the row and checks the equation, so a
+     * false positive happens with probability 2^-r. With r = 7 and 12.5% slack slots the filter spends
+     * about 7.9 bits per key for a 0.8% false positive rate, where a Bloom filter needs 10 bits per key
+     * for 1%. Building costs more than a Bloom filter, roughly 200ns per key.
+     *
+     * Solutions are stored column-major in 64-slot blocks (one u64 per fingerprint bit per block), so a
+     * query costs two loads, an AND and a popcount per fingerprint bit.
+     *
+     * Serialized layout: the solution words (little-endian u64), block count (u32), seed (u32) and
+     * fingerprint bits (u8).
+     */
+    class RibbonFilterPolicy final : public FilterPolicy {
+    public:
+        static constexpr size_t kDefaultResultBits = 7;
+
+        /**
+         * @param resultBits Fingerprint bits per key, 1 to 8; the false positive rate is 2^-resultBits.
+         */
+        explicit RibbonFilterPolicy(size_t resultBits = kDefaultResultBits);
+
+        void add(std::string_view key) override;
+
+        [[nodiscard]] bool mayContain(std::string_view key) const override;
+
+        void serialize(std::vector<uint8_t> *out) const override;
+
+        void deserialize(const uint8_t *data, size_t len) override;
+
+        [[nodiscard]] std::string_view name() const override {
+            return std::string_view{"ribbon"};
+        }
+
+        [[nodiscard]] size_t slotCount() const { return this->blocks_ * 64; }
+
+    private:
+        size_t resultBits_;
+
+        /** Hashes added since construction, solved into slots by serialize() */
+        std::vector<uint64_t> hashes_;
+
+        size_t blocks_{0};
+        uint32_t seed_{0};
+        std::vector<uint64_t> solution_;
+
+        /** Set when the serialized filter could not be read, answers true for every key */
+        bool matchAll_{false};
+    };
+} // namespace sstable
+
+#endif //ENIGMA_DB_RIBBON_FILTER_POLICY_HPP
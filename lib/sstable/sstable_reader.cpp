@@ -0,0 +1,267 @@
+//
+// Created by frostzt on 10/17/2026.
+//
+
+#include "sstable_reader.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <stdexcept>
+
+#include "lib/compression/lz_4_compressor.hpp"
+#include "lib/utils/crypto_utils.hpp"
+
+namespace sstable {
+    namespace {
+        const std::byte *asBytes(const std::string_view data) {
+            return reinterpret_cast<const std::byte *>(data.data());
+        }
+
+        /** Adds the time since construction to a counter when it goes out of scope */
+        class ScopedTimer {
+        private:
+            std::atomic<uint64_t> &total_;
+            std::chrono::steady_clock::time_point start_;
+
+        public:
+            explicit ScopedTimer(std::atomic<uint64_t> &total)
+                : total_(total), start_(std::chrono::steady_clock::now()) {
+            }
+
+            ~ScopedTimer() {
+                const auto elapsed = std::chrono::steady_clock::now() - this->start_;
+                this->total_.fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count(),
+                                       std::memory_order_relaxed);
+            }
+        };
+    } // namespace
+
+    SSTableIterator::SSTableIterator(const SSTableReader *reader): reader_(reader) {
+    }
+
+    void SSTableIterator::loadBlock(const size_t index) {
+        this->blockIndex_ = index;
+        if (index >= this->reader_->index_.size()) {
+            this->block_.reset();
+            return;
+        }
+
+        this->block_.emplace(this->reader_->readBlock(this->reader_->index_[index].handle),
+                             this->reader_->options_.keyEncoder.get());
+    }
+
+    void SSTableIterator::skipEmptyBlocks() {
+        while (this->block_.has_value() && !this->block_->valid()) {
+            this->loadBlock(this->blockIndex_ + 1);
+            if (this->block_.has_value()) this->block_->seekToFirst();
+        }
+    }
+
+    void SSTableIterator::seekToFirst() {
+        this->loadBlock(0);
+        if (this->block_.has_value()) this->block_->seekToFirst();
+        this->skipEmptyBlocks();
+    }
+
+    void SSTableIterator::seek(const core::Key &target) {
+        this->seek(target.orderedBytes());
+    }
+
+    void SSTableIterator::seek(const std::string_view target) {
+        this->loadBlock(this->reader_->findBlock(target));
+        if (this->block_.has_value()) this->block_->seek(target);
+        this->skipEmptyBlocks();
+    }
+
+    void SSTableIterator::next() {
+        this->block_->next();
+        this->skipEmptyBlocks();
+    }
+
+    core::Entry SSTableIterator::entry() const {
+        const auto value = this->value();
+        auto entry = core::Entry::deserialize(asBytes(value), value.size(), this->reader_->schemas());
+        if (!entry) throw std::runtime_error("SSTABLE: failed to decode entry");
+
+        return std::move(*entry);
+    }
+
+    SSTableReader::SSTableReader(std::shared_ptr<io_engine::IoEngine> engine, const std::string &dir,
+                                 const std::string &fileName, const uint64_t fileNumber,
+                                 std::shared_ptr<BlockCache> cache, SSTableOptions options)
+        : engine_(std::move(engine)), fileNumber_(fileNumber), cache_(std::move(cache)), options_(std::move(options)) {
+        const auto path = std::filesystem::path(dir) / fileName;
+
+        std::error_code ec;
+        const auto fileSize = std::filesystem::file_size(path, ec);
+        if (ec || fileSize < Footer::kEncodedLength) {
+            throw std::runtime_error("SSTABLE: " + path.string() + " is not a table file");
+        }
+
+        this->seg_ = this->engine_->openReadOnly(dir, fileName);
+        if (!this->seg_.valid()) throw std::runtime_error("SSTABLE: failed to open table file " + path.string());
+
+        // From here on the destructor will not run, close the segment ourselves on failure
+        try {
+            uint8_t footer[Footer::kEncodedLength];
+            const auto read = this->engine_->read(this->seg_, fileSize - Footer::kEncodedLength, footer, sizeof(footer));
+            if (read != static_cast<long long>(sizeof(footer))) {
+                throw std::runtime_error("SSTABLE: failed to read the footer of " + path.string());
+            }
+
+            const auto decoded = Footer::decode(footer);
+            if (!decoded) throw std::runtime_error("SSTABLE: corrupted footer in " + path.string());
+            this->footer_ = *decoded;
+
+            const auto meta = this->readRawBlock(this->footer_.meta);
+            const auto props = TableProperties::decode(meta.data(), meta.size());
+            if (!props) throw std::runtime_error("SSTABLE: corrupted meta block in " + path.string());
+            this->props_ = *props;
+            this->props_.fileSize = fileSize;
+
+            // The footer names the policy that wrote the filter, tables written with an unknown one
+            // are simply read without a filter
+            if (!this->footer_.filter.isNull()) this->filter_ = createFilterPolicy(this->footer_.filterName);
+            if (this->filter_) {
+                const auto filter = this->readRawBlock(this->footer_.filter);
+                this->filter_->deserialize(filter.data(), filter.size());
+            }
+
+            BlockIterator index(std::make_shared<const std::vector<uint8_t> >(this->readRawBlock(this->footer_.index)),
+                                this->options_.keyEncoder.get());
+            for (index.seekToFirst(); index.valid(); index.next()) {
+                IndexEntry entry{index.key(), {}};
+                const auto *handle = reinterpret_cast<const uint8_t *>(index.value().data());
+                if (entry.handle.decodeFrom(handle, handle + index.value().size()) == nullptr) {
+                    throw std::runtime_error("SSTABLE: corrupted index block in " + path.string());
+                }
+
+                this->index_.push_back(std::move(entry));
+            }
+        } catch (...) {
+            this->engine_->close(this->seg_);
+            throw;
+        }
+    }
+
+    SSTableReader::~SSTableReader() {
+        this->engine_->close(this->seg_);
+    }
+
+    std::vector<uint8_t> SSTableReader::readRawBlock(const BlockHandle &handle) const {
+        if (handle.size < BlockHeader::kEncodedLength) {
+            throw std::runtime_error("SSTABLE: invalid block handle in table " + std::to_string(this->fileNumber_));
+        }
+
+        std::vector<uint8_t> framed(handle.size);
+        const auto read = this->engine_->read(this->seg_, handle.offset, framed.data(), framed.size());
+        if (read != static_cast<long long>(framed.size())) {
+            throw std::runtime_error("SSTABLE: failed to read block of table " + std::to_string(this->fileNumber_));
+        }
+        this->blockReads_.fetch_add(1, std::memory_order_relaxed);
+
+        const auto header = BlockHeader::decode(framed.data());
+        const uint8_t *payload = framed.data() + BlockHeader::kEncodedLength;
+        if (header.compressedSize != handle.size - BlockHeader::kEncodedLength ||
+            Utility::computeCRC32(reinterpret_cast<const std::byte *>(payload), 0, header.compressedSize) !=
+            header.checksum) {
+            throw std::runtime_error("SSTABLE: checksum mismatch in table " + std::to_string(this->fileNumber_));
+        }
+
+        if (header.compression == compression::CompressorID::Noop) {
+            framed.erase(framed.begin(), framed.begin() + BlockHeader::kEncodedLength);
+            return framed;
+        }
+
+        std::vector<uint8_t> raw;
+        if (const auto &compressor = this->options_.compressor; compressor && compressor->id() == header.compression) {
+            compressor->decompress(payload, header.compressedSize, raw);
+        } else if (header.compression == compression::CompressorID::LZ4) {
+            compression::LZ4Compressor().decompress(payload, header.compressedSize, raw);
+        } else {
+            throw std::runtime_error("SSTABLE: unknown compressor in table " + std::to_string(this->fileNumber_));
+        }
+
+        if (raw.size() != header.uncompressedSize) {
+            throw std::runtime_error("SSTABLE: block size mismatch in table " + std::to_string(this->fileNumber_));
+        }
+
+        return raw;
+    }
+
+    BlockCache::Block SSTableReader::readBlock(const BlockHandle &handle) const {
+        if (!this->cache_) return std::make_shared<const std::vector<uint8_t> >(this->readRawBlock(handle));
+
+        if (auto block = this->cache_->lookup(this->fileNumber_, handle.offset)) return block;
+
+        auto block = std::make_shared<const std::vector<uint8_t> >(this->readRawBlock(handle));
+        this->cache_->insert(this->fileNumber_, handle.offset, block);
+        return block;
+    }
+
+    size_t SSTableReader::findBlock(const std::string_view key) const {
+        const auto it = std::lower_bound(this->index_.begin(), this->index_.end(), key,
+                                         [](const IndexEntry &entry, const std::string_view target) {
+                                             return core::Key::compareOrdered(entry.lastKey, target) < 0;
+                                         });
+
+        return static_cast<size_t>(it - this->index_.begin());
+    }
+
+    bool SSTableReader::mayContain(const std::string_view key) const {
+        return !this->filter_ || this->filter_->mayContain(key);
+    }
+
+    bool SSTableReader::lookup(const std::string_view key, std::string &entry) const {
+        this->gets_.fetch_add(1, std::memory_order_relaxed);
+
+        if (!this->mayContain(key)) {
+            this->filterNegatives_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        const size_t blockIndex = this->findBlock(key);
+        if (blockIndex == this->index_.size()) return false;
+
+        BlockIterator block(this->readBlock(this->index_[blockIndex].handle), this->options_.keyEncoder.get());
+        block.seek(key);
+        if (!block.valid() || core::Key::compareOrdered(block.key(), key) != 0) return false;
+
+        entry.assign(block.value());
+        return true;
+    }
+
+    bool SSTableReader::get(const std::string_view key, std::string &entry) const {
+        ScopedTimer timer(this->getNanos_);
+        return this->lookup(key, entry);
+    }
+
+    std::optional<core::Entry> SSTableReader::get(const core::Key &key) const {
+        ScopedTimer timer(this->getNanos_);
+
+        std::string value;
+        if (!this->lookup(key.orderedBytes(), value)) return std::nullopt;
+
+        auto entry = core::Entry::deserialize(asBytes(value), value.size(), this->schemas());
+        if (!entry) throw std::runtime_error("SSTABLE: failed to decode entry in table " + std::to_string(this->fileNumber_));
+
+        return entry;
+    }
+
+    std::vector<SSTableReader::BlockBoundary> SSTableReader::blockBoundaries() const {
+        std::vector<BlockBoundary> boundaries;
+        boundaries.reserve(this->index_.size());
+        for (const auto &entry: this->index_) boundaries.push_back({entry.lastKey, entry.handle.size});
+        return boundaries;
+    }
+
+    SSTableReader::Stats SSTableReader::stats() const {
+        return Stats{
+            this->gets_.load(std::memory_order_relaxed),
+            this->filterNegatives_.load(std::memory_order_relaxed),
+            this->blockReads_.load(std::memory_order_relaxed),
+            this->getNanos_.load(std::memory_order_relaxed),
+        };
+    }
+} // namespace sstable
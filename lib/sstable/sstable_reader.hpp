@@ -0,0 +1,219 @@
+//
+// Created by frostzt on 10/17/2026.
+//
+
+#ifndef ENIGMA_DB_SSTABLE_READER_HPP
+#define ENIGMA_DB_SSTABLE_READER_HPP
+
+#include <atomic>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "lib/entry/entry.hpp"
+#include "lib/io/engine.hpp"
+#include "lib/sstable/block_cache.hpp"
+#include "lib/sstable/block_iterator.hpp"
+#include "lib/sstable/format.hpp"
+#include "lib/sstable/sstable_writer.hpp"
+
+namespace sstable {
+    class SSTableReader;
+
+    /**
+     * @class SSTableIterator
+     * @brief Forward cursor over every entry of one table, tombstones included, in key order.
+     *
+     * Data blocks are loaded one at a time through the reader (and its block cache); the reader must
+     * outlive the iterator.
+     */
+    class SSTableIterator {
+    private:
+        const SSTableReader *reader_;
+        size_t blockIndex_{0};
+        std::optional<BlockIterator> block_;
+
+        /** Loads data block `index`, or invalidates the cursor past the last one */
+        void loadBlock(size_t index);
+
+        /** Moves on to the following blocks while the current one is exhausted */
+        void skipEmptyBlocks();
+
+    public:
+        explicit SSTableIterator(const SSTableReader *reader);
+
+        [[nodiscard]] bool valid() const { return this->block_.has_value() && this->block_->valid(); }
+
+        void seekToFirst();
+
+        /**
+         * Positions the cursor at the first key that is not less than `target`.
+         */
+        void seek(const core::Key &target);
+
+        /**
+         * Same as the `core::Key` overload for an already serialized primary key.
+         */
+        void seek(std::string_view target);
+
+        void next();
+
+        /** Serialized primary key under the cursor */
+        [[nodiscard]] const std::string &key() const { return this->block_->key(); }
+
+        /** Serialized entry under the cursor, valid until the cursor moves to another block */
+        [[nodiscard]] std::string_view value() const { return this->block_->value(); }
+
+        /**
+         * Decodes the entry under the cursor.
+         *
+         * @throw std::runtime_error If the stored bytes fail to deserialize.
+         */
+        [[nodiscard]] core::Entry entry() const;
+    };
+
+    /**
+     * @class SSTableReader
+     * @brief Read access to an immutable table written by SSTableWriter.
+     *
+     * Opening a table reads its footer, meta block, filter block and index; the index stays in memory
+     * and is binary searched for the only data block that can hold a key. Data blocks are verified,
+     * decompressed and, when a cache is given, kept in the shared BlockCache. Readers are safe to use
+     * from any number of threads.
+     */
+    class SSTableReader {
+    public:
+        /**
+         * @struct BlockBoundary
+         * @brief Where a data block ends in key order and how much of the file it takes.
+         */
+        struct BlockBoundary {
+            /** Last key of the block */
+            std::string lastKey;
+
+            /** Framed size of the block on disk */
+            uint64_t size = 0;
+        };
+
+        struct Stats {
+            uint64_t gets = 0;
+
+            /** Gets answered by the filter alone */
+            uint64_t filterNegatives = 0;
+
+            /** Blocks read from the file rather than served by the block cache */
+            uint64_t blockReads = 0;
+
+            /** Wall time spent in get(), summed over all calls */
+            uint64_t getNanos = 0;
+
+            [[nodiscard]] double averageGetNanos() const {
+                return this->gets == 0 ? 0.0 : static_cast<double>(this->getNanos) / static_cast<double>(this->gets);
+            }
+        };
+
+        /**
+         * Opens `dir/fileName` and loads everything but the data blocks.
+         *
+         * @param fileNumber Number the table was created under, identifies its blocks in the cache.
+         * @param cache Cache shared with other readers, blocks are not cached when null.
+         * @param options Must use the key encoder the table was written with. The filter policy is
+         *                picked by the name stored in the footer, not by the options.
+         * @throw std::runtime_error If the file cannot be read or is not a valid table.
+         */
+        SSTableReader(std::shared_ptr<io_engine::IoEngine> engine, const std::string &dir, const std::string &fileName,
+                      uint64_t fileNumber, std::shared_ptr<BlockCache> cache = nullptr,
+                      SSTableOptions options = SSTableOptions::defaults());
+
+        ~SSTableReader();
+
+        SSTableReader(const SSTableReader &) = delete;
+
+        SSTableReader &operator=(const SSTableReader &) = delete;
+
+        /**
+         * Looks up `key`. A tombstone is returned like any other entry so callers know to stop
+         * searching older tables.
+         *
+         * @throw std::runtime_error If a block on the lookup path is corrupted.
+         */
+        [[nodiscard]] std::optional<core::Entry> get(const core::Key &key) const;
+
+        /**
+         * Same as the `core::Key` overload for an already serialized primary key, copies the
+         * serialized entry into `entry` instead of decoding it.
+         *
+         * @return Whether the key was found.
+         */
+        bool get(std::string_view key, std::string &entry) const;
+
+        /**
+         * Returns false when the filter rules `key` out; always true for tables without a filter.
+         */
+        [[nodiscard]] bool mayContain(std::string_view key) const;
+
+        [[nodiscard]] SSTableIterator newIterator() const { return SSTableIterator(this); }
+
+        /**
+         * The data blocks in key order, straight from the in-memory index. Lets callers split the key
+         * range of a table into pieces of about equal size without reading any data block.
+         */
+        [[nodiscard]] std::vector<BlockBoundary> blockBoundaries() const;
+
+        [[nodiscard]] const TableProperties &properties() const { return this->props_; }
+
+        [[nodiscard]] uint64_t fileNumber() const { return this->fileNumber_; }
+
+        /** The registry the table's entries are decoded through, see SSTableOptions::schemas */
+        [[nodiscard]] const core::SchemaRegistry &schemas() const {
+            return this->options_.schemas ? *this->options_.schemas : core::SchemaRegistry::global();
+        }
+
+        [[nodiscard]] Stats stats() const;
+
+    private:
+        friend class SSTableIterator;
+
+        struct IndexEntry {
+            /** Last key of the block */
+            std::string lastKey;
+            BlockHandle handle;
+        };
+
+        std::shared_ptr<io_engine::IoEngine> engine_;
+        io_engine::SegmentHandle seg_;
+        uint64_t fileNumber_;
+        std::shared_ptr<BlockCache> cache_;
+        SSTableOptions options_;
+
+        Footer footer_;
+        TableProperties props_;
+        std::vector<IndexEntry> index_;
+        std::unique_ptr<FilterPolicy> filter_;
+
+        mutable std::atomic<uint64_t> gets_{0};
+        mutable std::atomic<uint64_t> filterNegatives_{0};
+        mutable std::atomic<uint64_t> blockReads_{0};
+        mutable std::atomic<uint64_t> getNanos_{0};
+
+        /**
+         * Reads, verifies and decompresses the block at `handle` without going through the cache.
+         *
+         * @throw std::runtime_error If the block cannot be read or fails its checksum.
+         */
+        [[nodiscard]] std::vector<uint8_t> readRawBlock(const BlockHandle &handle) const;
+
+        /** Data block at `handle`, from the cache when possible */
+        [[nodiscard]] BlockCache::Block readBlock(const BlockHandle &handle) const;
+
+        /** Index of the first data block whose last key is not less than `key`, index_.size() if none */
+        [[nodiscard]] size_t findBlock(std::string_view key) const;
+
+        /** Untimed lookup shared by both get() overloads */
+        bool lookup(std::string_view key, std::string &entry) const;
+    };
+} // namespace sstable
+
+#endif //ENIGMA_DB_SSTABLE_READER_HPP
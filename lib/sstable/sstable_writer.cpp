@@ -0,0 +1,200 @@
+//
+// Created by frostzt on 10/17/2026.
+//
+
+#include "sstable_writer.hpp"
+
+#include <cassert>
+#include <filesystem>
+#include <stdexcept>
+
+#include "lib/compression/lz_4_compressor.hpp"
+#include "lib/utils/crypto_utils.hpp"
+#include "spdlog/spdlog.h"
+
+namespace sstable {
+    namespace {
+        std::string temporaryName(const std::string &fileName) { return fileName + ".tmp"; }
+
+        const std::byte *asBytes(const std::string_view data) {
+            return reinterpret_cast<const std::byte *>(data.data());
+        }
+    } // namespace
+
+    SSTableOptions SSTableOptions::defaults() {
+        SSTableOptions options;
+        options.compressor = std::make_shared<compression::LZ4Compressor>();
+        options.keyEncoder = std::make_shared<PrefixKeyEncoder>();
+        return options;
+    }
+
+    SSTableWriter::SSTableWriter(std::shared_ptr<io_engine::IoEngine> engine, std::string dir, std::string fileName,
+                                 SSTableOptions options)
+        : engine_(std::move(engine)), dir_(std::move(dir)), fileName_(std::move(fileName)),
+          options_(std::move(options)),
+          dataBlock_(this->options_.keyEncoder, this->options_.blockSize, this->options_.restartInterval),
+          indexBlock_(this->options_.keyEncoder, this->options_.blockSize, this->options_.restartInterval) {
+        if (this->options_.filterFactory) this->filter_ = this->options_.filterFactory();
+
+        // The engine appends to existing files, start from a clean one
+        const auto tmp = temporaryName(this->fileName_);
+        std::filesystem::remove(std::filesystem::path(this->dir_) / tmp);
+
+        this->seg_ = this->engine_->openSegment(this->dir_, tmp);
+        if (!this->seg_.valid()) {
+            throw std::runtime_error("SSTABLE: failed to create table file " + this->dir_ + "/" + tmp);
+        }
+
+        this->out_.reserve(kWriteChunk + this->options_.blockSize * 2);
+    }
+
+    SSTableWriter::~SSTableWriter() {
+        if (this->finished_) return;
+
+        this->engine_->close(this->seg_);
+
+        std::error_code ec;
+        std::filesystem::remove(std::filesystem::path(this->dir_) / temporaryName(this->fileName_), ec);
+    }
+
+    void SSTableWriter::add(const std::string_view key, const std::string_view entry) {
+        assert(!this->finished_);
+        assert(this->props_.entries == 0 || core::Key::compareOrdered(key, this->key_) > 0);
+
+        this->key_.assign(key);
+        this->value_.assign(entry);
+
+        if (this->props_.entries == 0) this->props_.smallestKey = this->key_;
+
+        const uint64_t timestamp = core::Entry::serializedTimestamp(asBytes(entry), entry.size());
+        this->props_.entries++;
+        this->props_.tombstones += core::Entry::serializedTombstone(asBytes(entry), entry.size()) ? 1 : 0;
+        this->props_.rawKeyBytes += key.size();
+        this->props_.rawValueBytes += entry.size();
+        this->props_.minTimestamp = std::min(this->props_.minTimestamp, timestamp);
+        this->props_.maxTimestamp = std::max(this->props_.maxTimestamp, timestamp);
+
+        if (this->filter_) this->filter_->add(this->key_);
+
+        this->dataBlock_.add(this->key_, this->value_);
+        if (this->dataBlock_.shouldFlush()) this->flushDataBlock();
+    }
+
+    void SSTableWriter::add(const memtable::Record &record) {
+        this->add(std::string_view(reinterpret_cast<const char *>(record.keyData()), record.keyLength()),
+                  std::string_view(reinterpret_cast<const char *>(record.entryData()), record.entryLength()));
+    }
+
+    void SSTableWriter::flushDataBlock() {
+        if (this->dataBlock_.estimatedSize() == 0) return;
+
+        const BlockHandle handle = this->writeBlock(this->dataBlock_.finish(), true);
+        this->props_.dataBlocks++;
+
+        // Index entries map the last key of a block to it, the first block whose last key is not
+        // less than a target is the only one that can hold it
+        std::vector<uint8_t> encoded;
+        handle.encodeTo(encoded);
+        this->indexBlock_.add(this->key_, std::string(encoded.begin(), encoded.end()));
+    }
+
+    BlockHandle SSTableWriter::writeBlock(const std::vector<uint8_t> &raw, const bool compress) {
+        const std::vector<uint8_t> *payload = &raw;
+        auto codec = compression::CompressorID::Noop;
+
+        const auto &compressor = this->options_.compressor;
+        if (compress && compressor && compressor->id() != compression::CompressorID::Noop) {
+            compressor->compress(raw.data(), raw.size(), this->compressed_);
+            if (this->compressed_.size() < raw.size() - raw.size() / 8) {
+                payload = &this->compressed_;
+                codec = compressor->id();
+            }
+        }
+
+        BlockHeader header;
+        header.compressedSize = static_cast<uint32_t>(payload->size());
+        header.uncompressedSize = static_cast<uint32_t>(raw.size());
+        header.compression = codec;
+        header.checksum = Utility::computeCRC32(reinterpret_cast<const std::byte *>(payload->data()), 0,
+                                                payload->size());
+
+        header.encodeTo(this->out_);
+        this->out_.insert(this->out_.end(), payload->begin(), payload->end());
+
+        const BlockHandle handle{this->offset_, BlockHeader::kEncodedLength + payload->size()};
+        this->offset_ += handle.size;
+
+        if (this->out_.size() >= kWriteChunk) this->writeOut(false);
+        return handle;
+    }
+
+    void SSTableWriter::writeOut(const bool sync) {
+        if (this->out_.empty() && !sync) return;
+
+        const auto written = sync
+                                 ? this->engine_->writeSync(this->seg_, this->out_.data(), this->out_.size())
+                                 : this->engine_->write(this->seg_, this->out_.data(), this->out_.size());
+        if (written != static_cast<long long>(this->out_.size())) {
+            throw std::runtime_error("SSTABLE: failed to write table file " + this->fileName_);
+        }
+
+        this->out_.clear();
+    }
+
+    TableProperties SSTableWriter::finish() {
+        assert(!this->finished_);
+        this->flushDataBlock();
+
+        Footer footer;
+        footer.compressor = this->options_.compressor
+                                ? this->options_.compressor->id()
+                                : compression::CompressorID::Noop;
+
+        if (this->filter_) {
+            std::vector<uint8_t> filter;
+            this->filter_->serialize(&filter);
+            footer.filter = this->writeBlock(filter, false);
+            footer.filterName = this->filter_->name();
+        }
+
+        footer.index = this->writeBlock(this->indexBlock_.finish(), true);
+
+        this->props_.largestKey = this->key_;
+        std::vector<uint8_t> meta;
+        this->props_.encodeTo(meta);
+        footer.meta = this->writeBlock(meta, false);
+
+        footer.encodeTo(this->out_);
+        this->offset_ += Footer::kEncodedLength;
+
+        this->writeOut(true);
+        this->engine_->close(this->seg_);
+
+        const auto dir = std::filesystem::path(this->dir_);
+        std::filesystem::rename(dir / temporaryName(this->fileName_), dir / this->fileName_);
+
+        // The table is about to be recorded in the MANIFEST, its name has to survive a crash first
+        if (!io_engine::syncDirectory(this->dir_)) {
+            throw std::runtime_error("SSTABLE: failed to sync the directory of table file " + this->fileName_);
+        }
+
+        this->finished_ = true;
+        this->props_.fileSize = this->offset_;
+        return this->props_;
+    }
+
+    TableProperties SSTableWriter::writeMemTable(std::shared_ptr<io_engine::IoEngine> engine, const std::string &dir,
+                                                 const std::string &fileName, const memtable::MemTable &table,
+                                                 SSTableOptions options) {
+        SSTableWriter writer(std::move(engine), dir, fileName, std::move(options));
+
+        auto it = table.newIterator();
+        for (it.seekToFirst(); it.valid(); it.next()) {
+            writer.add(it.record());
+        }
+
+        const auto props = writer.finish();
+        spdlog::debug("SSTABLE: flushed {} entries into {} ({} bytes)", props.entries, fileName, props.fileSize);
+        return props;
+    }
+} // namespace sstable
@@ -0,0 +1,151 @@
+//
+// Created by frostzt on 10/17/2026.
+//
+
+#ifndef ENIGMA_DB_SSTABLE_WRITER_HPP
+#define ENIGMA_DB_SSTABLE_WRITER_HPP
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "lib/compression/compressor.hpp"
+#include "lib/io/engine.hpp"
+#include "lib/memtable/memtable.hpp"
+#include "lib/sstable/block_encoder.hpp"
+#include "lib/sstable/filter_policy.hpp"
+#include "lib/sstable/format.hpp"
+#include "lib/sstable/key_encoder.hpp"
+
+namespace sstable {
+    /**
+     * @struct SSTableOptions
+     * @brief Knobs shared by everything that writes tables (flushes and, later, compactions).
+     */
+    struct SSTableOptions {
+        /** Uncompressed size a data block is cut at */
+        size_t blockSize = BasicBlockEncoder::kDefaultBlockSize;
+
+        /** Keys between two restart points of a block, smaller means faster seeks but larger blocks */
+        size_t restartInterval = BasicBlockEncoder::kDefaultRestartInterval;
+
+        std::shared_ptr<compression::Compressor> compressor;
+
+        std::shared_ptr<KeyEncoder> keyEncoder;
+
+        /**
+         * Builds an empty filter for every new table; no filter block is written when unset. The
+         * policy's name() is recorded in the footer so readers know how to decode the filter.
+         */
+        std::function<std::unique_ptr<FilterPolicy>()> filterFactory;
+
+        /**
+         * Registry the entries of tables with a schema are decoded through, the one of the database's
+         * SchemaCatalog; SchemaRegistry::global() when unset. Only read back by SSTableReader.
+         */
+        std::shared_ptr<const core::SchemaRegistry> schemas;
+
+        /** LZ4 compression and prefix-compressed keys, no filter */
+        static SSTableOptions defaults();
+    };
+
+    /**
+     * @class SSTableWriter
+     * @brief Streams sorted entries into an immutable table file.
+     *
+     * Keys are primary keys in their memcmp-ordered form (`core::Key::encodeOrdered`) and values
+     * serialized entries (`core::Entry::serialize`), exactly the bytes a MemTable record holds, so
+     * flushing never decodes an entry. Data blocks are cut at `blockSize`, compressed when that saves at least 1/8th, and
+     * followed by the filter, index and meta blocks and the footer.
+     *
+     * Nothing is visible under the final name until finish() has synced the file; a writer destroyed
+     * before that removes what it wrote.
+     */
+    class SSTableWriter {
+    private:
+        std::shared_ptr<io_engine::IoEngine> engine_;
+        io_engine::SegmentHandle seg_;
+        std::string dir_;
+        std::string fileName_;
+        SSTableOptions options_;
+
+        BasicBlockEncoder dataBlock_;
+        BasicBlockEncoder indexBlock_;
+        std::unique_ptr<FilterPolicy> filter_;
+        TableProperties props_;
+
+        /** Bytes written to the file so far, including what is still sitting in out_ */
+        uint64_t offset_{0};
+
+        /** Framed blocks waiting to be written, flushed to the engine in large chunks */
+        std::vector<uint8_t> out_;
+
+        /** Scratch space reused for every block and key */
+        std::vector<uint8_t> compressed_;
+        std::string key_;
+        std::string value_;
+
+        bool finished_{false};
+
+        static constexpr size_t kWriteChunk = 256_KB;
+
+        void flushDataBlock();
+
+        BlockHandle writeBlock(const std::vector<uint8_t> &raw, bool compress);
+
+        void writeOut(bool sync);
+
+    public:
+        /**
+         * Creates (or truncates) `dir/fileName` and prepares to write a table into it.
+         *
+         * @throw std::runtime_error If the file cannot be opened.
+         */
+        SSTableWriter(std::shared_ptr<io_engine::IoEngine> engine, std::string dir, std::string fileName,
+                      SSTableOptions options = SSTableOptions::defaults());
+
+        ~SSTableWriter();
+
+        SSTableWriter(const SSTableWriter &) = delete;
+
+        SSTableWriter &operator=(const SSTableWriter &) = delete;
+
+        /**
+         * Appends an entry. Keys must be strictly ascending by `core::Key::compareOrdered`.
+         *
+         * @param key Primary key in its ordered form.
+         * @param entry Serialized entry the key belongs to.
+         * @throw std::runtime_error If writing to the file fails.
+         */
+        void add(std::string_view key, std::string_view entry);
+
+        void add(const memtable::Record &record);
+
+        /**
+         * Writes the remaining blocks and the footer, syncs the file, renames it to its final name and
+         * syncs the directory, so the table is durable under that name once this returns.
+         *
+         * @return Properties of the finished table.
+         * @throw std::runtime_error If writing or syncing fails.
+         */
+        TableProperties finish();
+
+        [[nodiscard]] uint64_t entries() const { return this->props_.entries; }
+
+        /** Approximate size of the table if it were finished now */
+        [[nodiscard]] uint64_t fileSize() const { return this->offset_ + this->dataBlock_.estimatedSize(); }
+
+        /**
+         * Writes the newest version of every key in `table`, tombstones included, to `dir/fileName`.
+         *
+         * @return Properties of the written table.
+         */
+        static TableProperties writeMemTable(std::shared_ptr<io_engine::IoEngine> engine, const std::string &dir,
+                                             const std::string &fileName, const memtable::MemTable &table,
+                                             SSTableOptions options = SSTableOptions::defaults());
+    };
+} // namespace sstable
+
+#endif //ENIGMA_DB_SSTABLE_WRITER_HPP
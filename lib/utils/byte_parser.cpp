@@ -4,6 +4,8 @@
 
 #include "byte_parser.hpp"
 
+#include "lib/utils/vint/vint.hpp"
+
 namespace Utility {
 	void ByteParser::writeUint16(std::vector<std::byte> &out, const uint16_t value) {
 		out.push_back(static_cast<std::byte>(value & 0xFF)); // lower byte
@@ -72,6 +74,25 @@ namespace Utility {
 		           reinterpret_cast<const std::byte *>(s.data() + s.size()));
 	}
 
+	void ByteParser::writeVarint32(std::vector<std::byte> &out, const uint32_t value) {
+		const size_t start = out.size();
+		out.resize(start + utility::varintLength(value));
+		utility::encodeVarint32(reinterpret_cast<uint8_t *>(out.data() + start), value);
+	}
+
+	std::optional<uint32_t> ByteParser::readVarint32() {
+		const auto *begin = reinterpret_cast<const uint8_t *>(this->data_ + this->cursor_);
+		const auto *limit = reinterpret_cast<const uint8_t *>(this->data_ + this->length_);
+
+		utility::StatusCode status;
+		uint32_t value = 0;
+		const uint8_t *end = utility::getVarint32(status, begin, limit, value);
+		if (end == nullptr) return std::nullopt;
+
+		this->cursor_ += end - begin;
+		return value;
+	}
+
 	std::string ByteParser::readString() {
 		const uint16_t size = readUint16();
 
@@ -120,6 +141,13 @@ namespace Utility {
 		return this->data_[this->cursor_++];
 	}
 
+	const std::byte *ByteParser::readBytes(const size_t length) {
+		const std::byte *bytes = this->data_ + this->cursor_;
+		this->cursor_ += length;
+
+		return bytes;
+	}
+
 	void ByteParser::writeMagicBytes(std::vector<std::byte> &out) {
 		out.insert(out.end(),
 		           reinterpret_cast<const std::byte *>(magic.data()),
@@ -76,6 +76,12 @@ namespace Utility {
          */
         static void patchUint64(std::vector<std::byte> &out, size_t offset, uint64_t value);
 
+        /** Appends `value` as a LEB128 varint, see utility::putVarint32 */
+        static void writeVarint32(std::vector<std::byte> &out, uint32_t value);
+
+        /** Reads a varint written by writeVarint32, std::nullopt if it is malformed or runs past the data */
+        [[nodiscard]] std::optional<uint32_t> readVarint32();
+
         static void writeString(std::vector<std::byte> &out, const std::string &s);
 
         [[nodiscard]] std::string readString();
@@ -90,6 +96,9 @@ namespace Utility {
 
         [[nodiscard]] std::byte readByte();
 
+        /** Returns a pointer to the next `length` bytes, which are skipped over */
+        [[nodiscard]] const std::byte *readBytes(size_t length);
+
         static void writeMagicBytes(std::vector<std::byte> &out);
     };
 }
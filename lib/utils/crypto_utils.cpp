@@ -4,26 +4,252 @@
 
 #include "crypto_utils.hpp"
 
+#include <array>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define ENIGMA_CRC32_X86 1
+#include <nmmintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
 namespace Utility {
-	uint32_t computeCRC32(const std::vector<std::byte> &data, const size_t offset, size_t length) {
-		if (length == 0) length = data.size() - offset;
+	namespace {
+		using SliceTables = std::array<std::array<uint32_t, 256>, 8>;
 
-		uint32_t crc = 0xFFFFFFFFU;
-		for (size_t i = offset; i < offset + length; ++i) {
-			const auto byte = static_cast<uint8_t>(data[i]);
-			crc = (crc >> 8) ^ crc32Table[(crc ^ byte) & 0xFF];
+		// slices[k][b] is the CRC contribution of byte b followed by k zero bytes
+		constexpr SliceTables makeSliceTables() {
+			SliceTables tables{};
+			for (size_t n = 0; n < 256; ++n) tables[0][n] = crc32Table[n];
+			for (size_t k = 1; k < 8; ++k) {
+				for (size_t n = 0; n < 256; ++n) {
+					const uint32_t prev = tables[k - 1][n];
+					tables[k][n] = (prev >> 8) ^ tables[0][prev & 0xFF];
+				}
+			}
+			return tables;
 		}
-		return ~crc;
-	}
 
-	uint32_t computeCRC32(const std::byte *data, const size_t offset, const size_t length) {
-		uint32_t crc = 0xFFFFFFFFU;
+		constexpr SliceTables kSlices = makeSliceTables();
 
-		for (size_t i = 0; i < length; ++i) {
-			const auto byte = static_cast<uint8_t>(data[offset + i]);
-			crc = (crc >> 8) ^ crc32Table[(crc ^ byte) & 0xFF];
+		inline uint64_t loadUint64(const std::byte *p) {
+			uint64_t value;
+			std::memcpy(&value, p, sizeof(value));
+			return value;
 		}
 
-		return ~crc;
+		uint32_t sliceBy8(uint32_t crc, const std::byte *p, size_t length) {
+			// Byte steps until p is 8-byte aligned so the wide loads below never straddle lines
+			while (length > 0 && (reinterpret_cast<uintptr_t>(p) & 7) != 0) {
+				crc = (crc >> 8) ^ kSlices[0][(crc ^ static_cast<uint8_t>(*p++)) & 0xFF];
+				length--;
+			}
+
+			while (length >= 8) {
+				const uint64_t word = loadUint64(p) ^ crc;
+				crc = kSlices[7][word & 0xFF] ^
+				      kSlices[6][(word >> 8) & 0xFF] ^
+				      kSlices[5][(word >> 16) & 0xFF] ^
+				      kSlices[4][(word >> 24) & 0xFF] ^
+				      kSlices[3][(word >> 32) & 0xFF] ^
+				      kSlices[2][(word >> 40) & 0xFF] ^
+				      kSlices[1][(word >> 48) & 0xFF] ^
+				      kSlices[0][word >> 56];
+				p += 8;
+				length -= 8;
+			}
+
+			while (length-- > 0) {
+				crc = (crc >> 8) ^ kSlices[0][(crc ^ static_cast<uint8_t>(*p++)) & 0xFF];
+			}
+
+			return crc;
+		}
+
+#ifdef ENIGMA_CRC32_X86
+		/**
+		 * The crc32 instruction has a latency of 3 cycles but a throughput of 1, so large buffers are
+		 * split into three lanes that are checksummed side by side. The lane CRCs are then stitched
+		 * together by advancing the earlier ones over the length of a lane with a precomputed "append
+		 * N zero bytes" operator (see Mark Adler's crc32c.c).
+		 */
+		constexpr size_t kLongLane = 8192;
+		constexpr size_t kShortLane = 256;
+		constexpr uint32_t kPolynomial = 0x82F63B78U;
+
+		uint32_t gf2MatrixTimes(const uint32_t *matrix, uint32_t vector) {
+			uint32_t sum = 0;
+			while (vector != 0) {
+				if (vector & 1) sum ^= *matrix;
+				vector >>= 1;
+				matrix++;
+			}
+			return sum;
+		}
+
+		void gf2MatrixSquare(uint32_t *square, const uint32_t *matrix) {
+			for (int n = 0; n < 32; ++n) square[n] = gf2MatrixTimes(matrix, matrix[n]);
+		}
+
+		/** Builds the operator that feeds `length` zero bytes through a raw CRC register */
+		void zerosOperator(uint32_t *even, size_t length) {
+			uint32_t odd[32];
+
+			// Operator for one zero bit
+			odd[0] = kPolynomial;
+			uint32_t row = 1;
+			for (int n = 1; n < 32; ++n) {
+				odd[n] = row;
+				row <<= 1;
+			}
+
+			gf2MatrixSquare(even, odd); // two zero bits
+			gf2MatrixSquare(odd, even); // four zero bits
+
+			// Each squaring doubles the run of zeros, the first one in the loop reaching a full byte
+			do {
+				gf2MatrixSquare(even, odd);
+				length >>= 1;
+				if (length == 0) return;
+				gf2MatrixSquare(odd, even);
+				length >>= 1;
+			} while (length != 0);
+
+			for (int n = 0; n < 32; ++n) even[n] = odd[n];
+		}
+
+		struct ShiftTable {
+			uint32_t table[4][256];
+
+			explicit ShiftTable(const size_t length) {
+				uint32_t op[32];
+				zerosOperator(op, length);
+				for (uint32_t n = 0; n < 256; ++n) {
+					this->table[0][n] = gf2MatrixTimes(op, n);
+					this->table[1][n] = gf2MatrixTimes(op, n << 8);
+					this->table[2][n] = gf2MatrixTimes(op, n << 16);
+					this->table[3][n] = gf2MatrixTimes(op, n << 24);
+				}
+			}
+
+			[[nodiscard]] uint32_t shift(const uint32_t crc) const {
+				return this->table[0][crc & 0xFF] ^ this->table[1][(crc >> 8) & 0xFF] ^
+				       this->table[2][(crc >> 16) & 0xFF] ^ this->table[3][crc >> 24];
+			}
+		};
+
+#ifndef _MSC_VER
+		__attribute__((target("sse4.2")))
+#endif
+		uint64_t interleave(uint64_t crc, const std::byte *&p, size_t &length, const size_t lane,
+		                    const ShiftTable &shifter) {
+			while (length >= lane * 3) {
+				uint64_t crc0 = crc;
+				uint64_t crc1 = 0;
+				uint64_t crc2 = 0;
+
+				const std::byte *end = p + lane;
+				do {
+					crc0 = _mm_crc32_u64(crc0, loadUint64(p));
+					crc1 = _mm_crc32_u64(crc1, loadUint64(p + lane));
+					crc2 = _mm_crc32_u64(crc2, loadUint64(p + lane * 2));
+					p += 8;
+				} while (p < end);
+
+				crc0 = shifter.shift(static_cast<uint32_t>(crc0)) ^ crc1;
+				crc = shifter.shift(static_cast<uint32_t>(crc0)) ^ crc2;
+
+				p += lane * 2;
+				length -= lane * 3;
+			}
+
+			return crc;
+		}
+
+#ifndef _MSC_VER
+		__attribute__((target("sse4.2")))
+#endif
+		uint32_t hardwareCRC(uint32_t crc32, const std::byte *p, size_t length) {
+			uint64_t crc = crc32;
+
+			while (length > 0 && (reinterpret_cast<uintptr_t>(p) & 7) != 0) {
+				crc = _mm_crc32_u8(static_cast<uint32_t>(crc), static_cast<uint8_t>(*p++));
+				length--;
+			}
+
+			// Function-local so that checksums taken during static initialisation still see built tables
+			static const ShiftTable longShift(kLongLane);
+			static const ShiftTable shortShift(kShortLane);
+
+			crc = interleave(crc, p, length, kLongLane, longShift);
+			crc = interleave(crc, p, length, kShortLane, shortShift);
+
+			while (length >= 8) {
+				crc = _mm_crc32_u64(crc, loadUint64(p));
+				p += 8;
+				length -= 8;
+			}
+
+			while (length-- > 0) {
+				crc = _mm_crc32_u8(static_cast<uint32_t>(crc), static_cast<uint8_t>(*p++));
+			}
+
+			return static_cast<uint32_t>(crc);
+		}
+
+		bool cpuHasSSE42() {
+#ifdef _MSC_VER
+			int info[4];
+			__cpuid(info, 1);
+			return (info[2] & (1 << 20)) != 0;
+#else
+			return __builtin_cpu_supports("sse4.2");
+#endif
+		}
+#endif
+
+		using CRCFunction = uint32_t (*)(uint32_t, const std::byte *, size_t);
+
+		CRCFunction selectCRC() {
+#ifdef ENIGMA_CRC32_X86
+			if (cpuHasSSE42()) return hardwareCRC;
+#endif
+			return sliceBy8;
+		}
+	} // namespace
+
+	bool hasHardwareCRC32() {
+#ifdef ENIGMA_CRC32_X86
+		return cpuHasSSE42();
+#else
+		return false;
+#endif
+	}
+
+	uint32_t extendCRC32Software(const uint32_t crc, const std::byte *data, const size_t length) {
+		return ~sliceBy8(~crc, data, length);
+	}
+
+	uint32_t extendCRC32Hardware(const uint32_t crc, const std::byte *data, const size_t length) {
+#ifdef ENIGMA_CRC32_X86
+		return ~hardwareCRC(~crc, data, length);
+#else
+		return extendCRC32Software(crc, data, length);
+#endif
+	}
+
+	uint32_t extendCRC32(const uint32_t crc, const std::byte *data, const size_t length) {
+		static const CRCFunction crcFunction = selectCRC();
+		return ~crcFunction(~crc, data, length);
+	}
+
+	uint32_t computeCRC32(const std::vector<std::byte> &data, const size_t offset, size_t length) {
+		if (length == 0) length = data.size() - offset;
+		return extendCRC32(0, data.data() + offset, length);
+	}
+
+	uint32_t computeCRC32(const std::byte *data, const size_t offset, const size_t length) {
+		return extendCRC32(0, data + offset, length);
 	}
 }
@@ -80,8 +80,27 @@ namespace Utility {
 		0xBE2DA0A5L, 0x4C4623A6L, 0x5F16D052L, 0xAD7D5351L
 	};
 
+    /**
+     * CRC32C (Castagnoli) of `length` bytes starting at `data + offset`. Uses the SSE4.2 `crc32`
+     * instruction when the CPU has it and a slicing-by-8 table walk otherwise; the choice is made
+     * once at startup.
+     */
     uint32_t computeCRC32(const std::byte* data, size_t offset, size_t length);
 
+    /**
+     * Continues a checksum previously returned by `computeCRC32`/`extendCRC32` over `length` more
+     * bytes, so `extendCRC32(computeCRC32(a), b)` equals the checksum of `a` followed by `b`.
+     */
+    uint32_t extendCRC32(uint32_t crc, const std::byte* data, size_t length);
+
+    /** Portable slicing-by-8 implementation, always available. */
+    uint32_t extendCRC32Software(uint32_t crc, const std::byte* data, size_t length);
+
+    /** SSE4.2 implementation; only call it when `hasHardwareCRC32()` is true. */
+    uint32_t extendCRC32Hardware(uint32_t crc, const std::byte* data, size_t length);
+
+    bool hasHardwareCRC32();
+
     uint32_t computeCRC32(const std::vector<std::byte> &data, size_t offset, size_t length);
 }
 
@@ -5,6 +5,8 @@
 #ifndef ENIGMA_VINT_H
 #define ENIGMA_VINT_H
 
+#include <cassert>
+#include <cstddef>
 #include <cstdint>
 #include <vector>
 
@@ -61,6 +63,35 @@ namespace utility {
         assert(i < 10);
     }
 
+    /**
+     * Encodes a 32-bit unsigned integer like putVarint32() into a buffer the caller sized, e.g. with
+     * varintLength(), for writers that lay out a record in place.
+     *
+     * @param dst Where the encoded bytes are written, must have room for varintLength(value) bytes.
+     * @param value The 32-bit unsigned integer value to be encoded.
+     * @return A pointer one past the last byte written.
+     */
+    inline uint8_t *encodeVarint32(uint8_t *dst, uint32_t value) {
+        while (value >= 0x80u) {
+            *dst++ = static_cast<uint8_t>(value | 0x80u);
+            value >>= 7;
+        }
+
+        *dst++ = static_cast<uint8_t>(value);
+        return dst;
+    }
+
+    /** Number of bytes `value` takes as a varint */
+    inline size_t varintLength(uint64_t value) {
+        size_t length = 1;
+        while (value >= 0x80u) {
+            value >>= 7;
+            ++length;
+        }
+
+        return length;
+    }
+
     /**
      * Decodes a variable-length 32-bit unsigned integer from the provided data
      * pointer and updates the output parameter with the decoded value.
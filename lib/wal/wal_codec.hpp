@@ -18,6 +18,8 @@ namespace WAL {
     enum class FlushMode {
         NO_FLUSH,
         FORCE_FLUSH,
+        /** Batched with concurrent appenders and made durable with a single fdatasync per batch */
+        GROUP_COMMIT,
     };
 
     static constexpr size_t MAGIC_SIZE = 5;
@@ -62,16 +64,40 @@ namespace WAL {
         return totalBytesWritten;
     }
 
+    /**
+     * Appends a record to `out` using the same framing as writeRecord(): magic bytes, payload length
+     * and the serialized payload. Lets callers stage several records and write them in one go.
+     *
+     * @param out The buffer to append the record to.
+     * @param entry The entry to be serialized into the buffer.
+     * @return The total number of bytes appended to the buffer.
+     */
+    inline uint32_t encodeRecord(std::vector<std::byte> &out, const core::Entry &entry) {
+        const size_t start = out.size();
+        const size_t payloadStart = start + MAGIC_SIZE + sizeof(uint32_t);
+        const uint32_t payloadLength = entry.serializedSize();
+
+        // Sized once, the entry is serialized straight into the batch
+        out.resize(payloadStart + payloadLength);
+        std::memcpy(out.data() + start, MAGIC.data(), MAGIC_SIZE);
+        std::memcpy(out.data() + start + MAGIC_SIZE, &payloadLength, sizeof(payloadLength));
+        entry.serializeInto(std::span(out).subspan(payloadStart, payloadLength));
+
+        return out.size() - start;
+    }
+
     /**
      * Reads a record from the provided input file stream. The record is deserialized
      * and returned as an optional Entry object. This includes reading magic bytes,
      * payload length, and the serialized payload. Logs errors in case of failure.
      *
      * @param in The input file stream to read the record from. Must be open and valid.
+     * @param schemas The registry of the database the WAL belongs to.
      * @return An optional Entry object representing the deserialized record.
      *         Returns std::nullopt if the record cannot be read or deserialized.
      */
-    inline std::optional<core::Entry> readRecord(std::ifstream &in) {
+    inline std::optional<core::Entry> readRecord(std::ifstream &in,
+                                                 const core::SchemaRegistry &schemas = core::SchemaRegistry::global()) {
         assert(in.is_open());
 
         // Read the magic bytes
@@ -89,8 +115,9 @@ namespace WAL {
             return std::nullopt;
         }
 
-        // Read the payload
-        std::vector<std::byte> payload(payloadLength);
+        // Read the payload into a buffer reused across records
+        thread_local std::vector<std::byte> payload;
+        payload.resize(payloadLength);
         in.read(reinterpret_cast<char *>(payload.data()), payloadLength);
         if (in.gcount() < payloadLength) {
             // spdlog::error("WAL: incomplete payload - skipping.");
@@ -98,7 +125,7 @@ namespace WAL {
         }
 
         // Deserialize the entry
-        const auto entryOpt = core::Entry::deserialize(payload.data(), payload.size());
+        const auto entryOpt = core::Entry::deserialize(payload.data(), payload.size(), schemas);
         if (!entryOpt.has_value()) {
             // spdlog::warn("WAL: failed to deserialize entry");
             return std::nullopt;
@@ -106,6 +133,91 @@ namespace WAL {
 
         return entryOpt.value();
     }
+
+    /**
+     * Appends `length` bytes of an arbitrary payload to `out` framed like a WAL record: magic bytes,
+     * payload length and the payload. Lets other logs, e.g. the MANIFEST, share the WAL's framing; the
+     * payload has to carry its own checksum.
+     *
+     * @return The total number of bytes appended to the buffer.
+     */
+    inline uint32_t encodeFrame(std::vector<std::byte> &out, const std::byte *payload, const uint32_t length) {
+        const size_t start = out.size();
+        out.resize(start + MAGIC_SIZE + sizeof(length) + length);
+
+        std::memcpy(out.data() + start, MAGIC.data(), MAGIC_SIZE);
+        std::memcpy(out.data() + start + MAGIC_SIZE, &length, sizeof(length));
+        if (length > 0) std::memcpy(out.data() + start + MAGIC_SIZE + sizeof(length), payload, length);
+
+        return out.size() - start;
+    }
+
+    /**
+     * Locates the payload of the frame starting at `offset` of a log loaded into memory and advances
+     * `offset` past it. Unlike nextRecord() the payload is not expected to be an entry.
+     *
+     * @return false at the end of the data or at a torn frame.
+     */
+    inline bool nextFrame(const std::byte *data, const size_t size, size_t &offset, const std::byte *&payload,
+                          uint32_t &payloadLength) {
+        constexpr size_t headerSize = MAGIC_SIZE + sizeof(uint32_t);
+        if (size - offset < headerSize) return false;
+        if (std::memcmp(data + offset, MAGIC.data(), MAGIC_SIZE) != 0) return false;
+
+        std::memcpy(&payloadLength, data + offset + MAGIC_SIZE, sizeof(payloadLength));
+        if (size - offset - headerSize < payloadLength) return false;
+
+        payload = data + offset + headerSize;
+        offset += headerSize + payloadLength;
+        return true;
+    }
+
+    /**
+     * Locates the payload of the record starting at `offset` of a WAL file that has been loaded into
+     * memory and advances `offset` past the record, without deserializing the payload.
+     *
+     * @param data The contents of the WAL file.
+     * @param size The number of bytes in `data`.
+     * @param offset Position of the record, moved past it on success.
+     * @param payload Set to the serialized entry on success.
+     * @param payloadLength Set to the length of the serialized entry on success.
+     * @return false at the end of the data or at a torn record.
+     */
+    inline bool nextRecord(const std::byte *data, const size_t size, size_t &offset, const std::byte *&payload,
+                           uint32_t &payloadLength) {
+        size_t next = offset;
+        if (!nextFrame(data, size, next, payload, payloadLength)) return false;
+
+        // Anything shorter cannot hold an entry's magic, size, timestamp and checksum
+        if (payloadLength < 25) return false;
+
+        offset = next;
+        return true;
+    }
+
+    /**
+     * Decodes the record starting at `offset` of a WAL file that has been loaded into memory and
+     * advances `offset` past it, mirroring readRecord() without any stream overhead.
+     *
+     * @param data The contents of the WAL file.
+     * @param size The number of bytes in `data`.
+     * @param offset Position of the record to decode, moved past it on success.
+     * @param schemas The registry of the database the WAL belongs to.
+     * @return The decoded entry, or std::nullopt at the end of the data or at a torn or corrupted record.
+     */
+    inline std::optional<core::Entry> readRecord(const std::byte *data, const size_t size, size_t &offset,
+                                                 const core::SchemaRegistry &schemas = core::SchemaRegistry::global()) {
+        size_t next = offset;
+        const std::byte *payload = nullptr;
+        uint32_t payloadLength = 0;
+        if (!nextRecord(data, size, next, payload, payloadLength)) return std::nullopt;
+
+        auto entry = core::Entry::deserialize(payload, payloadLength, schemas);
+        if (!entry.has_value()) return std::nullopt;
+
+        offset = next;
+        return entry;
+    }
 } // namespace WAL
 
 
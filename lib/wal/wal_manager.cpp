@@ -4,16 +4,158 @@
 
 #include "wal_manager.hpp"
 #include "wal_codec.hpp"
+#include "wal_segment_reader.hpp"
 
 #include <algorithm>
 #include <filesystem>
+#include <queue>
 #include <thread>
 
 namespace WAL {
+    namespace {
+        /** A framed record inside one of the loaded WAL files */
+        struct RecordRef {
+            uint64_t timestamp;
+            uint64_t offset;
+            uint32_t length;
+            uint32_t file;
+        };
+
+        /** Records per replay batch; each batch is deserialized in parallel, then replayed in order */
+        constexpr size_t kReplayBatch = 16384;
+
+        /** Frames every record of a mapped file, stopping at the first torn record */
+        std::vector<RecordRef> scanFile(const std::filesystem::path &path, WALSegmentReader &reader,
+                                        const uint32_t file) {
+            std::vector<RecordRef> records;
+
+            const std::byte *payload = nullptr;
+            uint32_t payloadLength = 0;
+            while (reader.nextPayload(payload, payloadLength)) {
+                records.push_back({core::Entry::serializedTimestamp(payload, payloadLength),
+                                   static_cast<uint64_t>(payload - reader.data()), payloadLength, file});
+            }
+
+            if (reader.offset() != reader.size()) {
+                std::cout << "Failed to read record from WAL file, possibly corrupted: " << path << std::endl;
+            }
+
+            return records;
+        }
+
+        /** Runs fn(0..count-1) on up to `workers` threads, each thread pulling the next index */
+        void parallelFor(const size_t count, const size_t workers, const std::function<void(size_t)> &fn) {
+            std::atomic<size_t> next{0};
+            const auto work = [&next, count, &fn]() {
+                for (size_t i = next++; i < count; i = next++) fn(i);
+            };
+
+            std::vector<std::thread> pool;
+            for (size_t t = 1; t < std::min(workers, count); ++t) pool.emplace_back(work);
+            work();
+
+            for (auto &thread: pool) thread.join();
+        }
+
+        using Segments = std::vector<std::optional<WALSegmentReader> >;
+
+        /**
+         * Maps and frames every WAL file of `walDir` and hands its records to `batchFn` in ascending
+         * timestamp order, up to kReplayBatch at a time, along with the mapped files they point into.
+         */
+        void forEachBatch(const std::string &walDir, const size_t workers,
+                          const std::function<void(const std::vector<RecordRef> &, const Segments &)> &batchFn) {
+            std::vector<WALFile> files;
+            for (const auto &entry: std::filesystem::directory_iterator(walDir)) {
+                if (!entry.is_regular_file()) continue;
+                if (auto file = parseFileName(entry.path())) files.push_back(std::move(*file));
+            }
+
+            // Map and frame every file; only timestamps are read here, entries are decoded at replay
+            Segments segments(files.size());
+            std::vector<std::vector<RecordRef> > records(files.size());
+            parallelFor(files.size(), workers, [&](const size_t i) {
+                try {
+                    segments[i].emplace(files[i].path);
+                } catch (const std::runtime_error &) {
+                    std::cout << "Failed to map WAL file, skipping: " << files[i].path << std::endl;
+                    return;
+                }
+
+                records[i] = scanFile(files[i].path, *segments[i], static_cast<uint32_t>(i));
+            });
+
+            // Every writer appends in order, so its files concatenated by file number form one stream
+            std::vector<size_t> byWriter(files.size());
+            for (size_t i = 0; i < files.size(); ++i) byWriter[i] = i;
+            std::ranges::sort(byWriter, [&files](const size_t a, const size_t b) {
+                if (files[a].writerId != files[b].writerId) return files[a].writerId < files[b].writerId;
+                return files[a].fileNumber < files[b].fileNumber;
+            });
+
+            std::vector<std::vector<size_t> > streamFiles;
+            for (size_t i = 0; i < byWriter.size(); ++i) {
+                if (i == 0 || files[byWriter[i]].writerId != files[byWriter[i - 1]].writerId) streamFiles.emplace_back();
+                streamFiles.back().push_back(byWriter[i]);
+            }
+
+            std::vector<std::vector<RecordRef> > streams(streamFiles.size());
+            parallelFor(streamFiles.size(), workers, [&](const size_t s) {
+                auto &stream = streams[s];
+                for (const size_t file: streamFiles[s]) {
+                    stream.insert(stream.end(), records[file].begin(), records[file].end());
+                    records[file] = {};
+                }
+
+                // Entries are timestamped before they reach the writer, so appends can race slightly
+                const auto byTimestamp = [](const RecordRef &a, const RecordRef &b) { return a.timestamp < b.timestamp; };
+                if (!std::ranges::is_sorted(stream, byTimestamp)) std::ranges::stable_sort(stream, byTimestamp);
+            });
+
+            // K-way merge of the writer streams, ties keep the lower writer first
+            using Head = std::pair<uint64_t, size_t>;
+            std::priority_queue<Head, std::vector<Head>, std::greater<> > heads;
+            std::vector<size_t> positions(streams.size(), 0);
+            for (size_t s = 0; s < streams.size(); ++s) {
+                if (!streams[s].empty()) heads.emplace(streams[s].front().timestamp, s);
+            }
+
+            std::vector<RecordRef> batch;
+            batch.reserve(kReplayBatch);
+            while (!heads.empty()) {
+                batch.clear();
+                while (!heads.empty() && batch.size() < kReplayBatch) {
+                    const size_t s = heads.top().second;
+                    heads.pop();
+
+                    batch.push_back(streams[s][positions[s]++]);
+                    if (positions[s] < streams[s].size()) heads.emplace(streams[s][positions[s]].timestamp, s);
+                }
+
+                batchFn(batch, segments);
+            }
+        }
+
+        /** Decodes a batch in parallel slices with decode(data, length), keeping the merged order */
+        template<typename T, typename Decode>
+        void decodeBatch(const std::vector<RecordRef> &batch, const Segments &segments, const size_t workers,
+                         std::vector<std::optional<T> > &decoded, Decode &&decode) {
+            constexpr size_t slice = 1024;
+            decoded.assign(batch.size(), std::nullopt);
+            parallelFor((batch.size() + slice - 1) / slice, workers, [&](const size_t sliceIdx) {
+                const size_t end = std::min(batch.size(), (sliceIdx + 1) * slice);
+                for (size_t i = sliceIdx * slice; i < end; ++i) {
+                    const auto &record = batch[i];
+                    decoded[i] = decode(segments[record.file]->data() + record.offset, record.length);
+                }
+            });
+        }
+    } // namespace
+
     bool WALManager::append(const core::Entry &entry) const {
         const auto threadId = std::hash<std::thread::id>{}(std::this_thread::get_id());
         const size_t writerIdx = threadId % this->writersCount_;
-        return this->writers_[writerIdx]->append(entry, FlushMode::FORCE_FLUSH);
+        return this->writers_[writerIdx]->append(entry, this->flushMode_);
     }
 
     void WALManager::close() const {
@@ -33,17 +175,15 @@ namespace WAL {
             }
         }
 
-        // Read data stream
+        // Decode straight out of the mapped files
         for (const auto &path: filepaths) {
-            std::ifstream stream(path, std::ios::in | std::ios::binary);
-            while (stream && stream.good() && !stream.eof()) {
-                if (auto maybeEntry = WAL::readRecord(stream); maybeEntry.has_value()) {
-                    replyFn(std::move(*maybeEntry));
-                } else {
-                    if (!stream.eof()) {
-                        std::cout << "Failed to read record from WAL file, possibly corrupted: " << path << std::endl;
-                    }
-                }
+            WALSegmentReader reader(path);
+            while (auto maybeEntry = reader.next(this->schemas())) {
+                replyFn(std::move(*maybeEntry));
+            }
+
+            if (reader.offset() != reader.size()) {
+                std::cout << "Failed to read record from WAL file, possibly corrupted: " << path << std::endl;
             }
         }
     }
@@ -51,16 +191,86 @@ namespace WAL {
     std::vector<core::Entry> WALManager::loadAll() const {
         std::vector<core::Entry> entries;
 
-        this->loadAll([&entries](core::Entry &&entry) {
+        // Recovery already yields entries sorted by timestamp
+        this->recover([&entries](core::Entry &&entry) {
             entries.push_back(std::move(entry));
         });
 
-        // Sort all the entries
-        std::ranges::sort(entries, [](const core::Entry &a, const core::Entry &b) {
-            return a.timestamp_ < b.timestamp_;
+        return entries;
+    }
+
+    void WALManager::recover(const std::function<void(core::Entry &&)> &replayFn, size_t workers) const {
+        if (workers == 0) workers = std::max(1u, std::thread::hardware_concurrency());
+
+        std::vector<std::optional<core::Entry> > decoded;
+        forEachBatch(this->walDir_, workers, [&](const std::vector<RecordRef> &batch, const Segments &segments) {
+            decodeBatch(batch, segments, workers, decoded, [this](const std::byte *data, const size_t length) {
+                return core::Entry::deserialize(data, length, this->schemas());
+            });
+
+            for (auto &entry: decoded) {
+                // Checksum failures are logged by Entry::deserialize
+                if (entry.has_value()) replayFn(std::move(*entry));
+            }
         });
+    }
 
-        return entries;
+    void WALManager::replay(const std::function<void(const core::EntryView &)> &replayFn, size_t workers) const {
+        if (workers == 0) workers = std::max(1u, std::thread::hardware_concurrency());
+
+        std::vector<std::optional<core::EntryView> > parsed;
+        forEachBatch(this->walDir_, workers, [&](const std::vector<RecordRef> &batch, const Segments &segments) {
+            decodeBatch(batch, segments, workers, parsed, [this](const std::byte *data, const size_t length) {
+                return core::EntryView::parse(data, length, true, this->schemas());
+            });
+
+            for (const auto &entry: parsed) {
+                if (entry.has_value()) replayFn(*entry);
+            }
+        });
+    }
+
+    void WALManager::recoverInto(memtable::MemTableManager &memTables, const size_t workers) const {
+        // The replayed bytes go into the MemTables as they are, nothing is decoded but the keys
+        this->replay([&memTables](const core::EntryView &entry) {
+            memTables.apply(entry);
+        }, workers);
+    }
+
+    memtable::LogPosition WALManager::sealSegments() const {
+        memtable::LogPosition position;
+        position.reserve(this->writers_.size());
+        for (const auto &writer: this->writers_) {
+            position.push_back(writer->seal());
+        }
+
+        return position;
+    }
+
+    size_t WALManager::truncate(const memtable::LogPosition &position) const {
+        std::vector<std::filesystem::path> obsolete;
+        for (const auto &entry: std::filesystem::directory_iterator(this->walDir_)) {
+            if (!entry.is_regular_file()) continue;
+
+            // Writer ids start at 1, writers beyond the position did not exist when it was taken
+            const auto file = parseFileName(entry.path());
+            if (file && file->writerId >= 1 && file->writerId <= position.size() &&
+                file->fileNumber < position[file->writerId - 1]) {
+                obsolete.push_back(file->path);
+            }
+        }
+
+        size_t removed = 0;
+        for (const auto &path: obsolete) {
+            std::error_code ec;
+            if (std::filesystem::remove(path, ec)) {
+                removed++;
+            } else if (ec) {
+                std::cout << "Failed to remove obsolete WAL file: " << path << ", " << ec.message() << std::endl;
+            }
+        }
+
+        return removed;
     }
 
     void WALManager::startFlushThread() {
@@ -11,6 +11,8 @@
 
 #include "wal_writer.hpp"
 #include "lib/entry/entry.hpp"
+#include "lib/entry/entry_view.hpp"
+#include "lib/memtable/memtable_manager.hpp"
 
 namespace WAL {
     /**
@@ -33,19 +35,39 @@ namespace WAL {
         /** Represents the interval for which the flush thread will auto-flush the writer */
         std::chrono::milliseconds flushInterval_{100};
 
+        /** IO engine shared by every writer of this manager */
+        std::shared_ptr<io_engine::IoEngine> engine_;
+
         /** A pool of writers maintained by this manager */
         std::vector<std::unique_ptr<WALWriter> > writers_;
 
         /** Total count of all the writers currently running */
         size_t writersCount_;
 
+        /** How appends are flushed, FORCE_FLUSH flushes every record while GROUP_COMMIT makes them durable */
+        FlushMode flushMode_;
+
+        /** Registry recovered entries are decoded through, SchemaRegistry::global() when null */
+        std::shared_ptr<const core::SchemaRegistry> schemas_;
+
+        [[nodiscard]] const core::SchemaRegistry &schemas() const {
+            return this->schemas_ ? *this->schemas_ : core::SchemaRegistry::global();
+        }
+
     public:
-        explicit WALManager(const size_t numWriters, const size_t maxFileSize, std::string &walDir) {
+        explicit WALManager(const size_t numWriters, const size_t maxFileSize, std::string &walDir,
+                            const FlushMode flushMode = FlushMode::FORCE_FLUSH,
+                            const io_engine::IoEngineType engineType = io_engine::IoEngineType::Uring) {
             // Store the wal dir for later use
             this->walDir_ = walDir;
+            this->flushMode_ = flushMode;
+
+            // Segments never outgrow maxFileSize by more than a record, no point reserving beyond that
+            this->engine_ = io_engine::createIoEngine(
+                engineType, std::min(maxFileSize, io_engine::POSIXEngine::kDefaultPreallocateBytes));
 
             for (size_t i = 0; i < numWriters; i++) {
-                writers_.emplace_back(std::make_unique<WALWriter>(i + 1, walDir, maxFileSize));
+                writers_.emplace_back(std::make_unique<WALWriter>(i + 1, walDir, maxFileSize, this->engine_));
             }
 
             this->writersCount_ = numWriters;
@@ -74,11 +96,19 @@ namespace WAL {
          */
         void stopFlushThread();
 
+        /**
+         * Sets the registry entries are decoded through while recovering, that of the database's
+         * SchemaCatalog, so tables referred to by id resolve to the database's own schemas. Set it before
+         * recovering; until then SchemaRegistry::global() is used.
+         */
+        void setSchemas(std::shared_ptr<const core::SchemaRegistry> schemas) { this->schemas_ = std::move(schemas); }
+
         /**
          * Appends a new entry to the Write-Ahead Log (WAL) using a specific writer
          * determined by the current thread's ID. This method ensures thread-safe
          * appending of entries by distributing the workload among multiple writers.
-         * The appended data is flushed to disk immediately.
+         * The appended data is flushed according to the manager's flush mode; under
+         * GROUP_COMMIT this only returns once the entry has been fdatasync'ed.
          *
          * @param entry The entry to be appended to the WAL.
          * @return True if the entry was successfully appended, false otherwise.
@@ -114,6 +144,62 @@ namespace WAL {
          */
         [[nodiscard]] std::vector<core::Entry> loadAll() const;
 
+        /**
+         * Recovers every entry from the Write-Ahead Log (WAL) files using a pool of
+         * decode threads. Files are loaded and framed concurrently, one per worker at
+         * a time, and the per-writer streams are then k-way merged by timestamp, so no
+         * global sort over all entries is needed. Entries are deserialized in parallel
+         * batches in merged order, so at most one batch of decoded entries is held at
+         * a time on top of the raw file contents. A file is read up to its first torn
+         * record and records failing their checksum are skipped.
+         *
+         * @param replayFn A callback invoked on the calling thread for every recovered
+         *                 entry, in ascending timestamp order.
+         * @param workers The number of decode threads, 0 uses every hardware thread.
+         */
+        void recover(const std::function<void(core::Entry &&)> &replayFn, size_t workers = 0) const;
+
+        /**
+         * Recovers the Write-Ahead Log (WAL) like recover(), but hands every record over as a
+         * core::EntryView straight into the mapped files instead of decoding it; only the framing
+         * and checksums are checked in parallel.
+         *
+         * @param replayFn A callback invoked on the calling thread for every recovered entry, in
+         *                 ascending timestamp order. The view is only valid during the call.
+         * @param workers The number of decode threads, 0 uses every hardware thread.
+         */
+        void replay(const std::function<void(const core::EntryView &)> &replayFn, size_t workers = 0) const;
+
+        /**
+         * Recovers the Write-Ahead Log (WAL) like replay() and applies every entry
+         * to the given MemTableManager in timestamp order, copying the logged bytes
+         * into the MemTables without decoding them.
+         *
+         * @param memTables The MemTables to rebuild.
+         * @param workers The number of decode threads, 0 uses every hardware thread.
+         */
+        void recoverInto(memtable::MemTableManager &memTables, size_t workers = 0) const;
+
+        /**
+         * Seals the current file of every writer, see WALWriter::seal(). Meant as the log sealer of a
+         * MemTableManager, which calls it with writes excluded as it freezes its active MemTable:
+         *
+         *     memTables.setLogSealer([&wal] { return wal.sealSegments(); });
+         *
+         * @return Per writer, the first file holding none of the entries appended so far.
+         */
+        [[nodiscard]] memtable::LogPosition sealSegments() const;
+
+        /**
+         * Deletes every WAL file below `position`, called once the MemTable that recorded it and every
+         * older one have been flushed to durable SSTables. Recovery then only replays entries that are
+         * not in an SSTable yet.
+         *
+         * @param position The position of the flushed MemTable, an empty one deletes nothing.
+         * @return The number of files deleted.
+         */
+        size_t truncate(const memtable::LogPosition &position) const;
+
         [[nodiscard]] uint32_t getWritersMetaData() const {
             uint32_t total = 0;
             for (int i = 0; i < this->writersCount_; i++) {
@@ -0,0 +1,105 @@
+//
+// Created by frostzt on 10/17/2026.
+//
+
+#include "wal_segment_reader.hpp"
+
+#include <algorithm>
+#include <fcntl.h>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <utility>
+
+#include "wal_codec.hpp"
+
+namespace WAL {
+    WALSegmentReader::WALSegmentReader(const std::filesystem::path &path) {
+        const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) throw std::runtime_error("WAL: Failed to open WAL file for reading!");
+
+        struct stat fileStat{};
+        if (::fstat(fd, &fileStat) < 0) {
+            ::close(fd);
+            throw std::runtime_error("WAL: Failed to stat WAL file!");
+        }
+
+        this->size_ = static_cast<size_t>(fileStat.st_size);
+
+        // mmap rejects empty ranges, an empty segment simply has no records
+        if (this->size_ > 0) {
+            void *mapped = ::mmap(nullptr, this->size_, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapped == MAP_FAILED) {
+                ::close(fd);
+                throw std::runtime_error("WAL: Failed to map WAL file!");
+            }
+
+            ::madvise(mapped, this->size_, MADV_SEQUENTIAL);
+            this->data_ = static_cast<const std::byte *>(mapped);
+        }
+
+        // The mapping stays valid without the descriptor
+        ::close(fd);
+        this->prefetch();
+    }
+
+    WALSegmentReader::~WALSegmentReader() {
+        if (this->data_ != nullptr) ::munmap(const_cast<std::byte *>(this->data_), this->size_);
+    }
+
+    WALSegmentReader::WALSegmentReader(WALSegmentReader &&other) noexcept
+        : data_(std::exchange(other.data_, nullptr)), size_(std::exchange(other.size_, 0)),
+          offset_(std::exchange(other.offset_, 0)), prefetched_(std::exchange(other.prefetched_, 0)) {
+    }
+
+    WALSegmentReader &WALSegmentReader::operator=(WALSegmentReader &&other) noexcept {
+        if (this == &other) return *this;
+
+        if (this->data_ != nullptr) ::munmap(const_cast<std::byte *>(this->data_), this->size_);
+        this->data_ = std::exchange(other.data_, nullptr);
+        this->size_ = std::exchange(other.size_, 0);
+        this->offset_ = std::exchange(other.offset_, 0);
+        this->prefetched_ = std::exchange(other.prefetched_, 0);
+
+        return *this;
+    }
+
+    void WALSegmentReader::prefetch() {
+        // Keep a full window ahead of the cursor, re-advising once half of it has been consumed
+        if (this->data_ == nullptr || this->prefetched_ >= this->size_) return;
+        if (this->prefetched_ > this->offset_ + kPrefetchBytes / 2) return;
+
+        // madvise wants a page aligned start
+        const size_t pageSize = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+        const size_t start = this->prefetched_ & ~(pageSize - 1);
+        const size_t end = std::min(this->size_, this->offset_ + kPrefetchBytes);
+
+        ::madvise(const_cast<std::byte *>(this->data_) + start, end - start, MADV_WILLNEED);
+        this->prefetched_ = end;
+    }
+
+    bool WALSegmentReader::nextPayload(const std::byte *&payload, uint32_t &payloadLength) {
+        if (!WAL::nextRecord(this->data_, this->size_, this->offset_, payload, payloadLength)) return false;
+
+        this->prefetch();
+        return true;
+    }
+
+    std::optional<core::Entry> WALSegmentReader::next(const core::SchemaRegistry &schemas) {
+        const size_t start = this->offset_;
+
+        const std::byte *payload = nullptr;
+        uint32_t payloadLength = 0;
+        if (!this->nextPayload(payload, payloadLength)) return std::nullopt;
+
+        auto entry = core::Entry::deserialize(payload, payloadLength, schemas);
+        if (!entry.has_value()) {
+            // Leave the cursor on the corrupted record so offset() reports where reading stopped
+            this->offset_ = start;
+            return std::nullopt;
+        }
+
+        return entry;
+    }
+} // namespace WAL
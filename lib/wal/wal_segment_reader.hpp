@@ -0,0 +1,81 @@
+//
+// Created by frostzt on 10/17/2026.
+//
+
+#ifndef ENIGMA_DB_WAL_SEGMENT_READER_HPP
+#define ENIGMA_DB_WAL_SEGMENT_READER_HPP
+
+#include <cstddef>
+#include <filesystem>
+#include <optional>
+
+#include "lib/entry/entry.hpp"
+#include "lib/utils/constants.hpp"
+
+namespace WAL {
+    /**
+     * Read-only, memory-mapped view of a single WAL file. Records are framed in place and their payloads
+     * handed to `Entry::deserialize` as pointers into the mapping, so reading a segment performs no
+     * copies and no per-record allocations beyond the decoded entry itself.
+     *
+     * The mapping is advised as sequential and the reader asks the kernel to fault in the next
+     * kPrefetchBytes ahead of the cursor as it advances.
+     */
+    class WALSegmentReader {
+    public:
+        static constexpr size_t kPrefetchBytes = 4_MB;
+
+        /**
+         * Maps the file at `path`.
+         *
+         * @throw std::runtime_error If the file cannot be opened or mapped.
+         */
+        explicit WALSegmentReader(const std::filesystem::path &path);
+
+        ~WALSegmentReader();
+
+        WALSegmentReader(WALSegmentReader &&other) noexcept;
+
+        WALSegmentReader &operator=(WALSegmentReader &&other) noexcept;
+
+        WALSegmentReader(const WALSegmentReader &) = delete;
+
+        WALSegmentReader &operator=(const WALSegmentReader &) = delete;
+
+        [[nodiscard]] const std::byte *data() const { return this->data_; }
+
+        [[nodiscard]] size_t size() const { return this->size_; }
+
+        /** Offset of the next record, equal to size() once every record has been read */
+        [[nodiscard]] size_t offset() const { return this->offset_; }
+
+        /**
+         * Frames the next record without decoding it.
+         *
+         * @param payload Set to the serialized entry inside the mapping.
+         * @param payloadLength Set to the length of the serialized entry.
+         * @return false at the end of the segment or at a torn record.
+         */
+        bool nextPayload(const std::byte *&payload, uint32_t &payloadLength);
+
+        /**
+         * Decodes the next record.
+         *
+         * @param schemas The registry of the database the WAL belongs to.
+         * @return The entry, or std::nullopt at the end of the segment or at a torn or corrupted record.
+         */
+        std::optional<core::Entry> next(const core::SchemaRegistry &schemas = core::SchemaRegistry::global());
+
+    private:
+        const std::byte *data_{nullptr};
+        size_t size_{0};
+        size_t offset_{0};
+
+        /** End of the range already advised with MADV_WILLNEED */
+        size_t prefetched_{0};
+
+        void prefetch();
+    };
+} // namespace WAL
+
+#endif //ENIGMA_DB_WAL_SEGMENT_READER_HPP
@@ -2,6 +2,7 @@
 // Created by frostzt on 7/28/2025.
 //
 
+#include <charconv>
 #include <iomanip>
 #include <sys/stat.h>
 
@@ -9,17 +10,32 @@
 #include "wal_codec.hpp"
 
 namespace WAL {
-    std::string WALWriter::filePath(const uint32_t fileId) const {
+    std::optional<WALFile> parseFileName(const std::filesystem::path &path) {
+        const auto fileName = path.filename().string();
+        if (!fileName.starts_with("w_") || !fileName.ends_with(".wal")) return std::nullopt;
+
+        const char *begin = fileName.data() + 2;
+        const char *end = fileName.data() + fileName.size() - 4;
+
+        WALFile file{path, 0, 0};
+        const auto [writerEnd, writerErr] = std::from_chars(begin, end, file.writerId);
+        if (writerErr != std::errc{} || writerEnd == end || *writerEnd != '_') return std::nullopt;
+
+        const auto [numberEnd, numberErr] = std::from_chars(writerEnd + 1, end, file.fileNumber);
+        if (numberErr != std::errc{} || numberEnd != end) return std::nullopt;
+
+        return file;
+    }
+
+    std::string WALWriter::fileName(const uint32_t fileId) const {
         std::ostringstream oss;
-        oss << this->walDir_ << "/" << "w_" << std::to_string(this->writerId_) << "_" << std::setw(8) << std::setfill('0') <<
-                fileId <<
-                ".wal";
+        oss << "w_" << std::to_string(this->writerId_) << "_" << std::setw(8) << std::setfill('0') << fileId << ".wal";
         return oss.str();
     }
 
     void WALWriter::flush() {
         std::lock_guard guard(this->writeMutex_);
-        this->currentOutStream_.flush();
+        this->writeBufferLocked();
     }
 
     size_t WALWriter::getFileSize(const std::string &path) {
@@ -31,39 +47,131 @@ namespace WAL {
         return fileStat.st_size;
     }
 
+    bool WALWriter::writeBufferLocked(const bool sync) {
+        if (this->buffer_.empty()) return !sync || this->engine_->flush(this->seg_);
+
+        const auto written = sync
+                                 ? this->engine_->writeSync(this->seg_, this->buffer_.data(), this->buffer_.size())
+                                 : this->engine_->write(this->seg_, this->buffer_.data(), this->buffer_.size());
+        const bool ok = written == static_cast<long long>(this->buffer_.size());
+        if (ok) this->currentFileSize_ += this->buffer_.size();
+
+        this->buffer_.clear();
+        return ok;
+    }
+
     bool WALWriter::append(const core::Entry &entry, const FlushMode flushMode = FlushMode::FORCE_FLUSH) {
+        if (flushMode == FlushMode::GROUP_COMMIT) return this->groupCommit(entry);
+
         std::lock_guard guard(this->writeMutex_);
 
-        const auto bytesWritten = WAL::writeRecord(this->currentOutStream_, entry, flushMode);
-        this->currentFileSize_ += bytesWritten;
+        WAL::encodeRecord(this->buffer_, entry);
+
+        if (flushMode == FlushMode::FORCE_FLUSH || this->buffer_.size() >= kMaxBufferedBytes) {
+            if (!this->writeBufferLocked()) return false;
+        }
 
         // Soft rotation, this might exceed file size, but that would happen at max by 1 entry
-        if (this->currentFileSize_ >= this->maxFileSize_) {
+        if (this->currentFileSize_ + this->buffer_.size() >= this->maxFileSize_) {
             this->rotate(); // Rotate the WAL file
         }
 
         return true;
     }
 
+    bool WALWriter::groupCommit(const core::Entry &entry) {
+        // Encoded before queueing so the leader only has to copy bytes
+        thread_local std::vector<std::byte> record;
+        record.clear();
+        WAL::encodeRecord(record, entry);
+
+        PendingCommit self{&record};
+
+        std::unique_lock lock(this->commitMutex_);
+        this->commitQueue_.push_back(&self);
+        self.cv.wait(lock, [this, &self] { return self.done || this->commitQueue_.front() == &self; });
+        if (self.done) return self.ok;
+
+        // We lead: take everything queued so far, the records stay put while their owners wait
+        this->batch_.clear();
+        size_t batchBytes = 0;
+        for (PendingCommit *pending: this->commitQueue_) {
+            const size_t recordBytes = pending->record->size();
+            if (!this->batch_.empty() && batchBytes + recordBytes > kMaxBatchBytes) break;
+
+            this->batch_.push_back(pending);
+            batchBytes += recordBytes;
+        }
+        lock.unlock();
+
+        bool ok;
+        try {
+            std::lock_guard guard(this->writeMutex_);
+
+            // Anything buffered by NO_FLUSH appends goes out first, in the same write
+            this->buffer_.reserve(this->buffer_.size() + batchBytes);
+            for (const PendingCommit *pending: this->batch_) {
+                this->buffer_.insert(this->buffer_.end(), pending->record->begin(), pending->record->end());
+            }
+
+            ok = this->writeBufferLocked(true);
+            if (ok && this->currentFileSize_ >= this->maxFileSize_) {
+                this->rotate();
+            }
+        } catch (const std::exception &) {
+            // Followers must still be released, they report the failure to their callers
+            ok = false;
+        }
+
+        lock.lock();
+        for (PendingCommit *pending: this->batch_) {
+            this->commitQueue_.pop_front();
+            pending->ok = ok;
+            pending->done = true;
+            if (pending != &self) pending->cv.notify_one();
+        }
+
+        // Hand leadership to whoever queued up while we were writing
+        if (!this->commitQueue_.empty()) this->commitQueue_.front()->cv.notify_one();
+
+        return ok;
+    }
+
+    uint32_t WALWriter::seal() {
+        std::lock_guard guard(this->writeMutex_);
+
+        // A closed writer appends nothing more, everything it wrote is in the current file or before
+        if (!this->seg_.valid()) return this->currentFileNumber_ + 1;
+
+        if (this->currentFileSize_ + this->buffer_.size() > 0) this->rotate();
+        return this->currentFileNumber_;
+    }
+
     void WALWriter::close() {
         std::lock_guard guard(this->writeMutex_);
 
-        if (this->currentOutStream_.is_open()) {
-            this->currentOutStream_.flush();
-            this->currentOutStream_.close();
+        if (this->seg_.valid()) {
+            this->writeBufferLocked();
+            this->engine_->flush(this->seg_);
+            this->engine_->close(this->seg_);
+            this->seg_ = {};
         }
     }
 
     void WALWriter::rotate() {
-        if (this->currentOutStream_.is_open()) {
-            this->currentOutStream_.flush(); // Flush the current buffer, append NOT necessarily forces flush
-            this->currentOutStream_.close();
+        if (this->seg_.valid()) {
+            // Write out the buffer, append NOT necessarily forces a write
+            if (!this->writeBufferLocked()) {
+                throw std::runtime_error("WAL: Failed to write buffered records before rotating!");
+            }
+
+            this->engine_->flush(this->seg_);
+            this->engine_->close(this->seg_);
         }
 
-        // Open the new WAL file and set it as current ofstream
-        const std::string path = this->filePath(++this->currentFileNumber_); // update the file number
-        this->currentOutStream_.open(path, std::ios::out | std::ios::app | std::ios::binary);
-        if (!this->currentOutStream_.good()) {
+        // Open the new WAL file and set it as the current segment
+        this->seg_ = this->engine_->openSegment(this->walDir_, this->fileName(++this->currentFileNumber_));
+        if (!this->seg_.valid()) {
             throw std::runtime_error("WAL: Failed to open WAL file for writing!");
         }
 
@@ -5,18 +5,36 @@
 #ifndef WAL_WRITER_HPP
 #define WAL_WRITER_HPP
 
+#include <algorithm>
 #include <atomic>
+#include <condition_variable>
 #include <cstdint>
-#include <fstream>
+#include <deque>
+#include <filesystem>
 #include <iosfwd>
+#include <memory>
 #include <mutex>
+#include <optional>
 #include <string>
+#include <vector>
 
 #include "wal_codec.hpp"
 #include "lib/entry/entry.hpp"
 #include "lib/io/engine.hpp"
+#include "lib/io/posix_engine.hpp"
+#include "lib/utils/constants.hpp"
 
 namespace WAL {
+    /** A WAL file named w_<writerId>_<fileNumber>.wal */
+    struct WALFile {
+        std::filesystem::path path;
+        size_t writerId;
+        uint32_t fileNumber;
+    };
+
+    /** Parses the name of a WAL file, std::nullopt for anything else */
+    std::optional<WALFile> parseFileName(const std::filesystem::path &path);
+
     class WALWriter {
     private:
         /** A unique identifier for this Writer */
@@ -25,49 +43,96 @@ namespace WAL {
         /** WAL File directory */
         std::string walDir_;
 
-        /** Current file ofstream */
-        std::ofstream currentOutStream_;
-
-        /** IO Engine */
-        io_engine::IoEngine& engine_;
+        /** IO Engine, shared with the other writers of a WALManager */
+        std::shared_ptr<io_engine::IoEngine> engine_;
 
         /** Currently active segment */
         io_engine::SegmentHandle seg_;
 
+        /** Encoded records that have not been handed to the engine yet */
+        std::vector<std::byte> buffer_;
+
+        /** NO_FLUSH appends are written out once this many bytes are buffered */
+        static constexpr size_t kMaxBufferedBytes = 64_KB;
+
         /** Max file byte size to be stored */
         size_t maxFileSize_;
 
         /** Current file number */
         std::atomic<uint32_t> currentFileNumber_;
 
-        /** Current file size in bytes */
+        /** Bytes written to the current file, records still in buffer_ are not counted until written */
         size_t currentFileSize_;
 
         // Mutexes
         std::mutex writeMutex_;
 
+        /** An appender waiting for its record to become durable */
+        struct PendingCommit {
+            explicit PendingCommit(const std::vector<std::byte> *record) : record(record) {
+            }
+
+            const std::vector<std::byte> *record;
+            bool done = false;
+            bool ok = false;
+            std::condition_variable cv;
+        };
+
+        /** Appenders waiting on a group commit; the one at the front leads the next batch */
+        std::deque<PendingCommit *> commitQueue_;
+
+        /** Guards commitQueue_ and the completion state of every queued PendingCommit */
+        std::mutex commitMutex_;
+
+        /** Records the current leader took from the queue, only touched by the leader */
+        std::vector<PendingCommit *> batch_;
+
+        /** Upper bound on a single group commit; one oversized record still goes out on its own */
+        static constexpr size_t kMaxBatchBytes = 1_MB;
+
+        /**
+         * Queues an entry for the next group commit and blocks until the batch carrying it has been
+         * written with a single write and made durable with a single fdatasync. The first appender in
+         * the queue becomes the leader and commits on behalf of everyone queued behind it.
+         *
+         * @param entry The entry to append.
+         * @return true once the entry is durable, false if writing or syncing its batch failed.
+         */
+        bool groupCommit(const core::Entry &entry);
+
+        /**
+         * Hands the buffered records to the engine in a single write and empties the buffer, whether
+         * or not the write succeeded; only a successful write counts towards currentFileSize_. Callers
+         * must hold writeMutex_.
+         *
+         * @param sync Whether to make the write durable in the same engine call.
+         * @return true if every buffered byte was written (and synced when asked to).
+         */
+        bool writeBufferLocked(bool sync = false);
+
         /**
          * Rotates the Write-Ahead Log (WAL) file by closing the current file,
          * opening a new file for writing, and resetting relevant internal
          * tracking fields. This method ensures thread safety with a mutex.
          *
-         * The rotation involves safely flushing and closing the existing
-         * file stream, followed by initializing a new WAL file with an
+         * The rotation involves writing out any buffered records and closing
+         * the existing segment, followed by opening a new WAL segment with an
          * incremented file identifier.
          *
-         * @throws std::runtime_error if the new WAL file fails to open for writing
+         * @throws std::runtime_error if the buffered records cannot be written or
+         *         the new WAL file fails to open for writing
          */
         void rotate();
 
         /**
-         * Constructs the full file path for a Write-Ahead Log (WAL) file
-         * given its file identifier. The file path is generated based on
-         * the WAL directory path and includes the fileId as part of the name.
+         * Constructs the file name for a Write-Ahead Log (WAL) file given its
+         * file identifier, relative to the WAL directory. The name includes the
+         * writer id and the zero-padded fileId.
          *
          * @param fileId The unique identifier for the WAL file.
-         * @return The complete file path for the specified WAL file as a string.
+         * @return The file name for the specified WAL file as a string.
          */
-        std::string filePath(uint32_t fileId) const;
+        std::string fileName(uint32_t fileId) const;
 
         /**
          * Retrieves the size of a file specified by its path.
@@ -82,15 +147,32 @@ namespace WAL {
         static size_t getFileSize(const std::string &path);
 
         bool init() {
-            this->currentFileNumber_ = 1;
-            this->seg_ = this->engine_.openSegment("wal", std::string_view(std::to_string(this->currentFileNumber_)));
+            // Numbering carries on after the files a previous run left behind, so a sealed position
+            // never covers a file that is still to be written; a fresh directory starts at w_<id>_00000001.wal
+            std::error_code ec;
+            for (const auto &entry: std::filesystem::directory_iterator(this->walDir_, ec)) {
+                if (const auto file = parseFileName(entry.path()); file && file->writerId == this->writerId_) {
+                    this->currentFileNumber_ = std::max(this->currentFileNumber_.load(), file->fileNumber);
+                }
+            }
+
+            this->rotate();
 
             return true;
         }
 
     public:
-        explicit WALWriter(size_t writerId, std::string walDir, const size_t maxFileByteSize): writerId_(writerId),
+        /**
+         * @param writerId A unique identifier for this writer, part of every file name it creates.
+         * @param walDir Directory the WAL files are created in.
+         * @param maxFileByteSize Size after which the writer rotates to a new file.
+         * @param engine Engine to write through, this writer creates its own (io_uring when available) when null.
+         */
+        explicit WALWriter(size_t writerId, std::string walDir, const size_t maxFileByteSize,
+                           std::shared_ptr<io_engine::IoEngine> engine = nullptr): writerId_(writerId),
             walDir_(std::move(walDir)),
+            engine_(engine ? std::move(engine) : io_engine::createIoEngine(io_engine::IoEngineType::Uring,
+                        std::min(maxFileByteSize, io_engine::POSIXEngine::kDefaultPreallocateBytes))),
             maxFileSize_(maxFileByteSize),
             currentFileNumber_(0),
             currentFileSize_(0) {
@@ -100,11 +182,18 @@ namespace WAL {
             }
         }
 
+        ~WALWriter() {
+            this->close();
+        }
+
         /**
          * Appends a new entry to the current Write-Ahead Log (WAL) file. The method
          * ensures thread safety by using a mutex to synchronize writes. After appending
          * the entry, the total number of bytes written is updated and logged.
          *
+         * With `FlushMode::GROUP_COMMIT` the call only returns once the entry is durable,
+         * concurrent appenders share a single write and fdatasync.
+         *
          * @param entry The Entry object to append to the current WAL file.
          * @return true if the entry was successfully written to the WAL.
          */
@@ -112,28 +201,35 @@ namespace WAL {
 
         /**
          * Gracefully closes the current Write-Ahead Log (WAL) file by ensuring
-         * that the file stream is flushed and closed safely. This method guarantees
-         * thread safety by utilizing a mutex to lock the write operations during
-         * the closure process.
+         * that buffered records are written and the segment is closed safely. This
+         * method guarantees thread safety by utilizing a mutex to lock the write
+         * operations during the closure process.
          *
-         * The method first flushes any buffered data to the file and then closes
-         * the associated file stream if it is open. Closing the WAL ensures that
-         * no further writing operations occur and flushes any pending data from
-         * memory to disk.
+         * Closing the WAL ensures that no further writing operations occur and
+         * hands any pending data from memory to the engine.
          */
         void close();
 
         /**
-         * Flushes the current Write-Ahead Log (WAL) file stream to ensure that
-         * any buffered data is written to the underlying storage. This method
-         * is thread-safe and utilizes a mutex to prevent concurrent writes during
-         * the flushing operation.
+         * Writes the records buffered by NO_FLUSH appends to the current
+         * Write-Ahead Log (WAL) file. This method is thread-safe and utilizes a
+         * mutex to prevent concurrent writes during the flushing operation.
          *
-         * This ensures the durability of the log data by synchronizing the buffer
-         * state with the permanent storage.
+         * The records become visible to readers of the file; they are only
+         * durable once a group commit syncs the segment or it is rotated or closed.
          */
         void flush();
 
+        /**
+         * Rotates to a new file unless nothing was appended to the current one yet, so every record
+         * appended before the call is in a file numbered below the returned one and every record
+         * appended after it is not.
+         *
+         * @return The number of the file the next record is appended to.
+         * @throws std::runtime_error if rotating fails, see rotate()
+         */
+        uint32_t seal();
+
         /**
          * Returns the current file number of the WAL file.
          *
@@ -144,15 +240,12 @@ namespace WAL {
         }
 
         /**
-         * Checks if the current output stream is in a good state.
-         * The method queries the `std::ofstream` object to determine if it is still
-         * valid for writing operations. A "good" state indicates that no errors
-         * have occurred, and the stream is ready for I/O operations.
+         * Checks if the writer currently has a segment open for writing.
          *
-         * @return true if the current output stream is in a good state, false otherwise.
+         * @return true if the current segment is open, false otherwise.
          */
         bool isStreamGood() const {
-            return this->currentOutStream_.good();
+            return this->seg_.valid();
         }
     };
 } // namespace WAL
@@ -0,0 +1,60 @@
+//
+// Created by frostzt on 10/17/2026.
+//
+
+#include "lib/abstract/arena.hpp"
+#include "catch2/catch_test_macros.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+TEST_CASE("should hand out aligned, non-overlapping allocations", "[ARENA]") {
+    Arena arena(1024);
+
+    std::vector<std::pair<std::byte *, size_t> > allocations;
+    for (size_t i = 1; i <= 200; ++i) {
+        const size_t size = (i * 37) % 300 + 1;
+        std::byte *mem = arena.allocate(size);
+        REQUIRE(reinterpret_cast<uintptr_t>(mem) % Arena::kAlignment == 0);
+
+        std::memset(mem, static_cast<int>(i), size);
+        allocations.emplace_back(mem, size);
+    }
+
+    // Every allocation still holds the pattern it was filled with
+    for (size_t i = 0; i < allocations.size(); ++i) {
+        const auto &[mem, size] = allocations[i];
+        REQUIRE(std::all_of(mem, mem + size, [i](std::byte b) { return b == static_cast<std::byte>(i + 1); }));
+    }
+
+    REQUIRE(arena.memoryUsage() >= 200);
+};
+
+TEST_CASE("should allocate concurrently without handing out the same memory twice", "[ARENA]") {
+    Arena arena(4096);
+
+    constexpr int threadCount = 8;
+    constexpr int perThreadCount = 5000;
+
+    std::vector<std::vector<std::byte *> > results(threadCount);
+    std::vector<std::thread> threads;
+    threads.reserve(threadCount);
+
+    for (int t = 0; t < threadCount; ++t) {
+        threads.emplace_back([&arena, &results, t]() {
+            for (int i = 0; i < perThreadCount; ++i) {
+                results[t].push_back(arena.allocate(24));
+            }
+        });
+    }
+
+    for (auto &thread: threads) thread.join();
+
+    std::vector<std::byte *> all;
+    for (const auto &result: results) all.insert(all.end(), result.begin(), result.end());
+
+    std::ranges::sort(all);
+    REQUIRE(std::ranges::adjacent_find(all) == all.end());
+};
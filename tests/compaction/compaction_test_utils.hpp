@@ -0,0 +1,38 @@
+//
+// Created by frostzt on 10/17/2026.
+//
+
+#ifndef ENIGMA_DB_COMPACTION_TEST_UTILS_HPP
+#define ENIGMA_DB_COMPACTION_TEST_UTILS_HPP
+
+#include "lib/compaction/compaction_scheduler.hpp"
+#include "tests/test_utils.hpp"
+
+namespace TESTS {
+    /** Flushes keys first, first + step, ... below last of table "customers", all at `timestamp` */
+    inline uint64_t flushRange(compaction::CompactionScheduler &scheduler, const int64_t first, const int64_t last,
+                               const int64_t step, const uint64_t timestamp, const bool tombstone = false) {
+        const memtable::MemTable table{"customers", memtable::MemTableBackend::SkipList};
+        for (int64_t i = first; i < last; i += step) {
+            table.put(core::Entry{"customers", keyOf(i), {{"name", makeField("user_" + std::to_string(i))}},
+                                  tombstone, timestamp});
+        }
+
+        return scheduler.flush(table);
+    }
+
+    /** Four levels of a few KB each, compacted inline, so a handful of flushes reaches the last level */
+    inline compaction::CompactionOptions smallTree(const size_t l0StopWritesTrigger = 4) {
+        compaction::CompactionOptions options;
+        options.levels = 4;
+        options.l0CompactionTrigger = 2;
+        options.l0StopWritesTrigger = l0StopWritesTrigger;
+        options.baseLevelBytes = 16_KB;
+        options.levelSizeMultiplier = 4;
+        options.targetFileBytes = 8_KB;
+        options.backgroundThreads = 0;
+        return options;
+    }
+} // namespace TESTS
+
+#endif //ENIGMA_DB_COMPACTION_TEST_UTILS_HPP
@@ -0,0 +1,365 @@
+//
+// Created by frostzt on 10/17/2026.
+//
+
+#include <filesystem>
+
+#include "catch2/catch_test_macros.hpp"
+#include "lib/compaction/compaction_scheduler.hpp"
+#include "lib/io/posix_engine.hpp"
+#include "tests/compaction/compaction_test_utils.hpp"
+
+namespace {
+    /** Every level below L0 must hold tables in key order with disjoint ranges */
+    void requireDisjointLevels(const compaction::CompactionScheduler &scheduler) {
+        for (size_t level = 1; level < scheduler.options().levels; ++level) {
+            const auto files = scheduler.levelFiles(level);
+            for (size_t i = 1; i < files.size(); ++i) {
+                const auto &prev = files[i - 1]->props.largestKey;
+                const auto &next = files[i]->props.smallestKey;
+                REQUIRE(core::Key::compareOrdered(prev, next) < 0);
+            }
+        }
+    }
+} // namespace
+
+TEST_CASE("compaction scheduler should keep the newest version of every key across levels", "[COMPACTION]") {
+    const std::string dir = "compaction_scheduler_newest";
+    std::filesystem::remove_all(dir);
+    const auto engine = std::make_shared<io_engine::POSIXEngine>(0);
+
+    compaction::CompactionScheduler scheduler(engine, dir, TESTS::smallTree());
+
+    // Round r rewrites keys [200r, 200r + 1000) so every table overlaps the previous four
+    constexpr int64_t rounds = 12;
+    for (int64_t round = 0; round < rounds; ++round) {
+        REQUIRE(TESTS::flushRange(scheduler, 200 * round, 200 * round + 1000, 1, round + 1) > 0);
+        scheduler.waitForIdle();
+    }
+
+    REQUIRE(scheduler.filesAtLevel(0) < 2);
+    requireDisjointLevels(scheduler);
+
+    for (int64_t i = 0; i < 200 * (rounds - 1) + 1000; ++i) {
+        const auto entry = scheduler.get(TESTS::keyOf(i));
+        REQUIRE(entry.has_value());
+        REQUIRE(entry->primaryKey_ == TESTS::keyOf(i));
+        REQUIRE(entry->timestamp_ == static_cast<uint64_t>(std::min<int64_t>(rounds - 1, i / 200) + 1));
+    }
+    REQUIRE(!scheduler.get(TESTS::keyOf(-1)).has_value());
+
+    // Outputs were split, so some level holds more than one table
+    size_t deepFiles = 0;
+    for (size_t level = 1; level < 4; ++level) deepFiles = std::max(deepFiles, scheduler.filesAtLevel(level));
+    REQUIRE(deepFiles > 1);
+
+    const auto stats = scheduler.stats();
+    REQUIRE(stats.flushes == rounds);
+    REQUIRE(stats.compactions > 0);
+    REQUIRE(stats.shadowedDropped > 0);
+    REQUIRE(stats.bytesRead > 0);
+    REQUIRE(stats.writeAmplification() > 1.0);
+    REQUIRE(stats.stalls == 0);
+
+    std::filesystem::remove_all(dir);
+};
+
+TEST_CASE("compaction scheduler should drop tombstones only once nothing deeper holds the key", "[COMPACTION]") {
+    const std::string dir = "compaction_scheduler_tombstones";
+    std::filesystem::remove_all(dir);
+    const auto engine = std::make_shared<io_engine::POSIXEngine>(0);
+
+    auto options = TESTS::smallTree();
+    options.levels = 3;
+    options.baseLevelBytes = 1;
+    options.targetFileBytes = 64_MB;
+    compaction::CompactionScheduler scheduler(engine, dir, options);
+
+    // Push keys 0..1999 down to the last level
+    TESTS::flushRange(scheduler, 0, 1000, 1, 1);
+    TESTS::flushRange(scheduler, 1000, 2000, 1, 1);
+    REQUIRE(scheduler.compactOnce());
+    REQUIRE(scheduler.compactOnce());
+    REQUIRE(!scheduler.compactOnce());
+    REQUIRE(scheduler.filesAtLevel(2) == 1);
+    REQUIRE(scheduler.stats().trivialMoves == 1);
+
+    // Delete the evens and update the odds below 1000
+    TESTS::flushRange(scheduler, 0, 1000, 2, 2, true);
+    TESTS::flushRange(scheduler, 1, 1000, 2, 3);
+
+    // L0 -> L1 must keep the tombstones, the old versions are still in L2
+    REQUIRE(scheduler.compactOnce());
+    REQUIRE(scheduler.filesAtLevel(0) == 0);
+    REQUIRE(scheduler.filesAtLevel(1) == 1);
+    REQUIRE(scheduler.stats().tombstonesDropped == 0);
+
+    const auto deleted = scheduler.get(TESTS::keyOf(0));
+    REQUIRE(deleted.has_value());
+    REQUIRE(deleted->isTombstone_);
+
+    // L1 -> L2 merges into the last level where they have nothing left to hide
+    REQUIRE(scheduler.compactOnce());
+    REQUIRE(scheduler.filesAtLevel(1) == 0);
+    REQUIRE(scheduler.filesAtLevel(2) == 1);
+
+    const auto stats = scheduler.stats();
+    REQUIRE(stats.tombstonesDropped == 500);
+    REQUIRE(scheduler.levelFiles(2).front()->props.entries == 1500);
+    REQUIRE(scheduler.levelFiles(2).front()->props.tombstones == 0);
+
+    for (int64_t i = 0; i < 2000; ++i) {
+        const auto entry = scheduler.get(TESTS::keyOf(i));
+        if (i < 1000 && i % 2 == 0) {
+            REQUIRE(!entry.has_value());
+            continue;
+        }
+
+        REQUIRE(entry.has_value());
+        REQUIRE(entry->timestamp_ == (i < 1000 ? 3u : 1u));
+    }
+
+    // Only the live tables are left in the directory
+    size_t tables = 0;
+    for (const auto &file: std::filesystem::directory_iterator(dir)) tables += file.path().extension() == ".sst";
+    REQUIRE(tables == 1);
+
+    std::filesystem::remove_all(dir);
+};
+
+TEST_CASE("compaction scheduler should stall flushes while L0 is full", "[COMPACTION]") {
+    const std::string dir = "compaction_scheduler_stall";
+    std::filesystem::remove_all(dir);
+    const auto engine = std::make_shared<io_engine::POSIXEngine>(0);
+
+    auto options = TESTS::smallTree();
+    options.l0StopWritesTrigger = 2;
+    compaction::CompactionScheduler scheduler(engine, dir, options);
+
+    TESTS::flushRange(scheduler, 0, 500, 1, 1);
+    TESTS::flushRange(scheduler, 0, 500, 1, 2);
+    REQUIRE(scheduler.filesAtLevel(0) == 2);
+
+    // Without background threads the stalled flush compacts L0 itself
+    TESTS::flushRange(scheduler, 0, 500, 1, 3);
+    REQUIRE(scheduler.filesAtLevel(0) == 1);
+
+    const auto stats = scheduler.stats();
+    REQUIRE(stats.stalls == 1);
+    REQUIRE(stats.stallNanos > 0);
+    REQUIRE(stats.compactions == 1);
+
+    REQUIRE(scheduler.get(TESTS::keyOf(42))->timestamp_ == 3);
+
+    std::filesystem::remove_all(dir);
+};
+
+TEST_CASE("compaction scheduler should compact flushed memtables in the background", "[COMPACTION]") {
+    const std::string dir = "compaction_scheduler_background";
+    std::filesystem::remove_all(dir);
+    const auto engine = std::make_shared<io_engine::POSIXEngine>(0);
+
+    auto options = TESTS::smallTree();
+    options.backgroundThreads = 2;
+    options.rateLimitBytesPerSecond = 64_MB;
+    compaction::CompactionScheduler scheduler(engine, dir, options);
+    scheduler.start();
+
+    memtable::MemTableManager memTables{"customers", memtable::MemTableBackend::SkipList, 256_KB};
+
+    constexpr int64_t keys = 3000;
+    constexpr int64_t writes = 30000;
+    for (int64_t i = 0; i < writes; ++i) {
+        memTables.apply(core::Entry{"customers", TESTS::keyOf((i * 7919) % keys), {{"name", TESTS::makeField("x")}},
+                                    i % 11 == 0, static_cast<uint64_t>(i + 1)});
+        if (memTables.frozenCount() > 0) scheduler.flushFrozen(memTables);
+    }
+
+    scheduler.waitForIdle();
+    REQUIRE(memTables.frozenCount() == 0);
+    REQUIRE(scheduler.filesAtLevel(0) < 2);
+    requireDisjointLevels(scheduler);
+
+    // The last write of key k is the largest i < writes with i * 7919 % keys == k
+    std::vector<int64_t> last(keys, -1);
+    for (int64_t i = 0; i < writes; ++i) last[(i * 7919) % keys] = i;
+
+    for (int64_t k = 0; k < keys; ++k) {
+        auto entry = memTables.get(TESTS::keyOf(k));
+        if (!entry) entry = scheduler.get(TESTS::keyOf(k));
+
+        // A deleted key may have lost its tombstone to a compaction into the last populated level
+        if (last[k] % 11 == 0) {
+            REQUIRE((!entry.has_value() || entry->isTombstone_));
+            continue;
+        }
+
+        REQUIRE(entry.has_value());
+        REQUIRE(!entry->isTombstone_);
+        REQUIRE(entry->timestamp_ == static_cast<uint64_t>(last[k] + 1));
+    }
+
+    scheduler.stop();
+
+    const auto stats = scheduler.stats();
+    REQUIRE(stats.flushes > 4);
+    REQUIRE(stats.compactions > 0);
+    REQUIRE(stats.writeAmplification() > 1.0);
+
+    std::filesystem::remove_all(dir);
+};
+
+TEST_CASE("tiered compaction should merge similarly sized runs and keep the newest version", "[COMPACTION]") {
+    const std::string dir = "compaction_scheduler_tiered";
+    std::filesystem::remove_all(dir);
+    const auto engine = std::make_shared<io_engine::POSIXEngine>(0);
+
+    auto options = TESTS::smallTree();
+    options.style = compaction::CompactionStyle::Tiered;
+    options.l0CompactionTrigger = 4;
+    options.l0StopWritesTrigger = 8;
+    options.tieredMaxSizeAmplificationPercent = 1000;
+    compaction::CompactionScheduler scheduler(engine, dir, options);
+
+    // Three equal runs stay below the trigger
+    for (int64_t round = 0; round < 3; ++round) TESTS::flushRange(scheduler, 0, 1000, 1, round + 1);
+    REQUIRE(!scheduler.compactOnce());
+    REQUIRE(scheduler.filesAtLevel(0) == 3);
+
+    // The fourth makes them all similar in size, they become one run
+    TESTS::flushRange(scheduler, 0, 1000, 1, 4);
+    REQUIRE(scheduler.compactOnce());
+    REQUIRE(scheduler.filesAtLevel(0) == 1);
+    REQUIRE(scheduler.levelFiles(0).front()->props.entries == 1000);
+
+    // Small runs on top of the large one are merged among themselves first
+    for (int64_t round = 4; round < 8; ++round) {
+        TESTS::flushRange(scheduler, 2000 + 10 * round, 2010 + 10 * round, 1, round + 1);
+    }
+    REQUIRE(scheduler.compactOnce());
+    REQUIRE(scheduler.filesAtLevel(0) == 2);
+    REQUIRE(scheduler.levelFiles(0).front()->props.entries == 1000);
+    REQUIRE(scheduler.levelFiles(0).back()->props.entries == 40);
+
+    for (size_t level = 1; level < options.levels; ++level) REQUIRE(scheduler.filesAtLevel(level) == 0);
+    REQUIRE(scheduler.sortedRuns() == 2);
+
+    for (int64_t i = 0; i < 1000; ++i) REQUIRE(scheduler.get(TESTS::keyOf(i))->timestamp_ == 4);
+    for (int64_t round = 4; round < 8; ++round) {
+        REQUIRE(scheduler.get(TESTS::keyOf(2000 + 10 * round))->timestamp_ == static_cast<uint64_t>(round + 1));
+    }
+
+    const auto stats = scheduler.stats();
+    REQUIRE(stats.compactions == 2);
+    REQUIRE(stats.shadowedDropped == 3000);
+    REQUIRE(stats.tombstonesDropped == 0);
+
+    std::filesystem::remove_all(dir);
+};
+
+TEST_CASE("tiered compaction should merge everything once size amplification grows too large", "[COMPACTION]") {
+    const std::string dir = "compaction_scheduler_tiered_amp";
+    std::filesystem::remove_all(dir);
+    const auto engine = std::make_shared<io_engine::POSIXEngine>(0);
+
+    auto options = TESTS::smallTree();
+    options.style = compaction::CompactionStyle::Tiered;
+    options.l0CompactionTrigger = 8;
+    options.l0StopWritesTrigger = 16;
+    options.tieredMaxSizeAmplificationPercent = 100;
+    compaction::CompactionScheduler scheduler(engine, dir, options);
+
+    TESTS::flushRange(scheduler, 0, 1000, 1, 1);
+    TESTS::flushRange(scheduler, 0, 1000, 2, 2, true);
+    REQUIRE(!scheduler.compactOnce());
+
+    // The newer runs now outweigh the oldest, the full merge has nothing older to keep tombstones for
+    TESTS::flushRange(scheduler, 1, 1000, 2, 3);
+    REQUIRE(scheduler.compactOnce());
+    REQUIRE(scheduler.filesAtLevel(0) == 1);
+
+    const auto stats = scheduler.stats();
+    REQUIRE(stats.tombstonesDropped == 500);
+    REQUIRE(scheduler.levelFiles(0).front()->props.entries == 500);
+
+    for (int64_t i = 0; i < 1000; ++i) {
+        const auto entry = scheduler.get(TESTS::keyOf(i));
+        if (i % 2 == 0) {
+            REQUIRE(!entry.has_value());
+        } else {
+            REQUIRE(entry->timestamp_ == 3);
+        }
+    }
+
+    std::filesystem::remove_all(dir);
+};
+
+TEST_CASE("tiered compaction should write less than leveled compaction for the same writes", "[COMPACTION]") {
+    const auto engine = std::make_shared<io_engine::POSIXEngine>(0);
+
+    const auto writeAmplification = [&engine](const compaction::CompactionStyle style) {
+        const std::string dir = "compaction_scheduler_amplification";
+        std::filesystem::remove_all(dir);
+
+        auto options = TESTS::smallTree();
+        options.style = style;
+        options.levels = 5;
+        options.l0CompactionTrigger = 4;
+        options.l0StopWritesTrigger = 8;
+        compaction::CompactionScheduler scheduler(engine, dir, options);
+
+        // Every flush updates a slice spread over the whole key space
+        for (int64_t round = 0; round < 32; ++round) {
+            TESTS::flushRange(scheduler, round % 7, 4000, 7, round + 1);
+            scheduler.waitForIdle();
+        }
+
+        for (int64_t i = 0; i < 4000; i += 13) REQUIRE(scheduler.get(TESTS::keyOf(i)).has_value());
+
+        const double amplification = scheduler.stats().writeAmplification();
+        std::filesystem::remove_all(dir);
+        return amplification;
+    };
+
+    REQUIRE(writeAmplification(compaction::CompactionStyle::Tiered) <
+            writeAmplification(compaction::CompactionStyle::Leveled));
+};
+
+TEST_CASE("compaction scheduler should split a large compaction into parallel key ranges", "[COMPACTION]") {
+    const std::string dir = "compaction_scheduler_subcompactions";
+    std::filesystem::remove_all(dir);
+    const auto engine = std::make_shared<io_engine::POSIXEngine>(0);
+
+    auto options = TESTS::smallTree();
+    options.l0CompactionTrigger = 4;
+    options.l0StopWritesTrigger = 8;
+    options.maxSubcompactions = 4;
+    options.targetFileBytes = 16_KB;
+    compaction::CompactionScheduler scheduler(engine, dir, options);
+
+    // Four overlapping L0 tables over the same 4000 keys
+    for (int64_t round = 0; round < 4; ++round) {
+        TESTS::flushRange(scheduler, round, 4000, round == 0 ? 1 : 2, round + 1);
+    }
+
+    REQUIRE(scheduler.compactOnce());
+    REQUIRE(scheduler.filesAtLevel(0) == 0);
+    requireDisjointLevels(scheduler);
+
+    const auto stats = scheduler.stats();
+    REQUIRE(stats.compactions == 1);
+    REQUIRE(stats.subcompactions == 4);
+
+    // Round 1 rewrites 2000 odds, rounds 2 and 3 another 1999 evens and odds; no range counts one twice
+    REQUIRE(stats.shadowedDropped == 5998);
+
+    uint64_t entries = 0;
+    for (const auto &file: scheduler.levelFiles(1)) entries += file->props.entries;
+    REQUIRE(entries == 4000);
+
+    for (int64_t i = 2; i < 4000; ++i) REQUIRE(scheduler.get(TESTS::keyOf(i))->timestamp_ == (i % 2 == 0 ? 3u : 4u));
+    REQUIRE(scheduler.get(TESTS::keyOf(0))->timestamp_ == 1);
+    REQUIRE(scheduler.get(TESTS::keyOf(1))->timestamp_ == 2);
+
+    std::filesystem::remove_all(dir);
+};
@@ -0,0 +1,40 @@
+//
+// Created by frostzt on 10/17/2026.
+//
+
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "catch2/catch_test_macros.hpp"
+#include "lib/compaction/rate_limiter.hpp"
+
+TEST_CASE("rate limiter should hold concurrent writers to the configured rate", "[COMPACTION]") {
+    // 100 KB/s shared by 4 threads writing 10 KB each twice, 80 KB in total
+    compaction::RateLimiter limiter(100 * 1024);
+
+    const auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&limiter] {
+            for (int i = 0; i < 2; ++i) limiter.request(10 * 1024);
+        });
+    }
+    for (auto &thread: threads) thread.join();
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+
+    // The first request goes through at once, the other seven wait for their share
+    REQUIRE(elapsed >= std::chrono::milliseconds(650));
+    REQUIRE(limiter.bytesRequested() == 80 * 1024);
+    REQUIRE(limiter.waitNanos() > 0);
+};
+
+TEST_CASE("rate limiter should let everything through without a rate", "[COMPACTION]") {
+    compaction::RateLimiter limiter(0);
+
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < 1000; ++i) limiter.request(1024 * 1024);
+
+    REQUIRE(std::chrono::steady_clock::now() - start < std::chrono::milliseconds(100));
+    REQUIRE(limiter.waitNanos() == 0);
+};
@@ -0,0 +1,125 @@
+//
+// Created by frostzt on 10/17/2026.
+//
+
+#include <filesystem>
+
+#include "catch2/catch_test_macros.hpp"
+#include "lib/compaction/table_merging_iterator.hpp"
+#include "lib/io/posix_engine.hpp"
+#include "lib/sstable/sstable_writer.hpp"
+#include "tests/test_utils.hpp"
+
+namespace {
+    /** Writes keys first, first + step, ... below last into table `number`, all at `timestamp` */
+    std::shared_ptr<sstable::SSTableReader> writeTable(const std::string &dir,
+                                                       const std::shared_ptr<io_engine::IoEngine> &engine,
+                                                       const uint64_t number, const int64_t first, const int64_t last,
+                                                       const int64_t step, const uint64_t timestamp,
+                                                       const bool tombstone = false) {
+        const memtable::MemTable table{"customers", memtable::MemTableBackend::SkipList};
+        for (int64_t i = first; i < last; i += step) {
+            table.put(core::Entry{"customers", TESTS::keyOf(i), {{"id", TESTS::makeField(i)}}, tombstone, timestamp});
+        }
+
+        sstable::SSTableWriter::writeMemTable(engine, dir, sstable::tableFileName(number), table);
+        return std::make_shared<sstable::SSTableReader>(engine, dir, sstable::tableFileName(number), number);
+    }
+} // namespace
+
+TEST_CASE("table merging iterator should yield every key once with its newest version", "[COMPACTION]") {
+    const std::string dir = "compaction_merging_iterator";
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+    const auto engine = std::make_shared<io_engine::POSIXEngine>(0);
+
+    // An older level of two disjoint tables, and two newer overlapping "L0" tables
+    const auto oldLow = writeTable(dir, engine, 1, 0, 500, 1, 10);
+    const auto oldHigh = writeTable(dir, engine, 2, 500, 1000, 1, 10);
+    const auto evens = writeTable(dir, engine, 3, 0, 1000, 2, 20);
+    const auto deletes = writeTable(dir, engine, 4, 0, 1000, 3, 30, true);
+
+    compaction::TableMergingIterator it({{deletes}, {evens}, {oldLow, oldHigh}});
+
+    int64_t expected = 0;
+    for (it.seekToFirst(); it.valid(); it.next()) {
+        const auto value = it.value();
+        const auto entry = core::Entry::deserialize(reinterpret_cast<const std::byte *>(value.data()), value.size());
+        REQUIRE(entry.has_value());
+        REQUIRE(entry->primaryKey_ == TESTS::keyOf(expected));
+
+        if (expected % 3 == 0) {
+            REQUIRE(entry->isTombstone_);
+            REQUIRE(entry->timestamp_ == 30);
+        } else {
+            REQUIRE(!entry->isTombstone_);
+            REQUIRE(entry->timestamp_ == (expected % 2 == 0 ? 20 : 10));
+        }
+
+        expected++;
+    }
+
+    REQUIRE(expected == 1000);
+
+    // 1834 versions of 1000 keys
+    REQUIRE(it.shadowed() == 834);
+
+    std::filesystem::remove_all(dir);
+};
+
+TEST_CASE("table merging iterator should break timestamp ties in favour of the earlier run", "[COMPACTION]") {
+    const std::string dir = "compaction_merging_iterator_ties";
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+    const auto engine = std::make_shared<io_engine::POSIXEngine>(0);
+
+    const auto live = writeTable(dir, engine, 1, 0, 100, 1, 50);
+    const auto deleted = writeTable(dir, engine, 2, 0, 100, 1, 50, true);
+
+    compaction::TableMergingIterator first({{deleted}, {live}});
+    size_t tombstones = 0;
+    for (first.seekToFirst(); first.valid(); first.next()) {
+        const auto value = first.value();
+        tombstones += core::Entry::serializedTombstone(reinterpret_cast<const std::byte *>(value.data()), value.size());
+    }
+    REQUIRE(tombstones == 100);
+
+    compaction::TableMergingIterator second({{live}, {deleted}, {}});
+    tombstones = 0;
+    for (second.seekToFirst(); second.valid(); second.next()) {
+        const auto value = second.value();
+        tombstones += core::Entry::serializedTombstone(reinterpret_cast<const std::byte *>(value.data()), value.size());
+    }
+    REQUIRE(tombstones == 0);
+
+    std::filesystem::remove_all(dir);
+};
+
+TEST_CASE("table merging iterator should seek past the tables of a run that end before the target", "[COMPACTION]") {
+    const std::string dir = "compaction_merging_iterator_seek";
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+    const auto engine = std::make_shared<io_engine::POSIXEngine>(0);
+
+    const auto oldLow = writeTable(dir, engine, 1, 0, 500, 1, 10);
+    const auto oldHigh = writeTable(dir, engine, 2, 500, 1000, 1, 10);
+    const auto odds = writeTable(dir, engine, 3, 1, 1000, 2, 20);
+
+    compaction::TableMergingIterator it({{odds}, {oldLow, oldHigh}});
+
+    it.seek(TESTS::keyOf(700).orderedBytes());
+
+    int64_t expected = 700;
+    for (; it.valid(); it.next()) {
+        const auto value = it.value();
+        const auto entry = core::Entry::deserialize(reinterpret_cast<const std::byte *>(value.data()), value.size());
+        REQUIRE(entry->primaryKey_ == TESTS::keyOf(expected));
+        REQUIRE(entry->timestamp_ == (expected % 2 == 1 ? 20 : 10));
+        ++expected;
+    }
+
+    REQUIRE(expected == 1000);
+    REQUIRE(it.shadowed() == 150);
+
+    std::filesystem::remove_all(dir);
+};
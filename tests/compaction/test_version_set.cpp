@@ -0,0 +1,278 @@
+//
+// Created by frostzt on 10/17/2026.
+//
+
+#include <filesystem>
+#include <fstream>
+#include <unordered_set>
+
+#include "catch2/catch_test_macros.hpp"
+#include "lib/compaction/compaction_scheduler.hpp"
+#include "lib/compaction/version_edit.hpp"
+#include "lib/io/posix_engine.hpp"
+#include "tests/compaction/compaction_test_utils.hpp"
+
+namespace {
+    /** Forwards to a POSIXEngine but fails the next `failures` appends to a MANIFEST */
+    class ManifestFaults final : public io_engine::IoEngine {
+    public:
+        enum class Fault {
+            /** The edit lands in full, only syncing it fails */
+            SyncFails,
+            /** Half of the edit lands */
+            TornWrite,
+        };
+
+        Fault fault = Fault::SyncFails;
+        size_t failures = 0;
+
+        io_engine::SegmentHandle openSegment(const std::string_view parentDir,
+                                             const std::string_view segmentName) override {
+            const auto seg = this->engine_.openSegment(parentDir, segmentName);
+            if (segmentName.starts_with("MANIFEST-")) this->manifests_.insert(seg.id);
+            return seg;
+        }
+
+        io_engine::SegmentHandle openReadOnly(const std::string_view parentDir,
+                                              const std::string_view segmentName) override {
+            return this->engine_.openReadOnly(parentDir, segmentName);
+        }
+
+        long long write(const io_engine::SegmentHandle seg, const void *data, const std::size_t len) override {
+            if (!this->failing(seg, Fault::TornWrite)) return this->engine_.write(seg, data, len);
+
+            (void) this->engine_.write(seg, data, len / 2);
+            return -1;
+        }
+
+        long long read(const io_engine::SegmentHandle seg, const uint64_t offset, void *buf,
+                       const std::size_t len) override {
+            return this->engine_.read(seg, offset, buf, len);
+        }
+
+        bool flush(const io_engine::SegmentHandle seg) override {
+            const bool failed = this->failing(seg, Fault::SyncFails);
+            return this->engine_.flush(seg) && !failed;
+        }
+
+        bool close(const io_engine::SegmentHandle seg) override { return this->engine_.close(seg); }
+
+    private:
+        io_engine::POSIXEngine engine_{0};
+        std::unordered_set<uint64_t> manifests_;
+
+        bool failing(const io_engine::SegmentHandle seg, const Fault fault) {
+            if (this->failures == 0 || this->fault != fault || !this->manifests_.contains(seg.id)) return false;
+
+            --this->failures;
+            return true;
+        }
+    };
+
+    std::vector<std::vector<uint64_t> > layout(const compaction::CompactionScheduler &scheduler) {
+        std::vector<std::vector<uint64_t> > numbers;
+        for (size_t level = 0; level < scheduler.options().levels; ++level) {
+            auto &files = numbers.emplace_back();
+            for (const auto &file: scheduler.levelFiles(level)) files.push_back(file->number);
+        }
+
+        return numbers;
+    }
+
+    size_t tablesIn(const std::string &dir) {
+        size_t tables = 0;
+        for (const auto &file: std::filesystem::directory_iterator(dir)) tables += file.path().extension() == ".sst";
+        return tables;
+    }
+} // namespace
+
+TEST_CASE("version edit should round trip and reject corrupted bytes", "[COMPACTION]") {
+    compaction::VersionEdit edit;
+    edit.setNextFileNumber(42);
+    edit.setCompactPointer(2, "pointer");
+    edit.deleteFile(1, 7);
+    edit.addFile(0, 40, 40);
+    edit.addFile(2, 41, 39);
+
+    std::vector<std::byte> encoded;
+    edit.encodeTo(encoded);
+
+    const auto decoded = compaction::VersionEdit::decode(encoded.data(), encoded.size());
+    REQUIRE(decoded.has_value());
+    REQUIRE(decoded->nextFileNumber() == 42u);
+    REQUIRE(decoded->compactPointers().size() == 1);
+    REQUIRE(decoded->compactPointers()[0].level == 2);
+    REQUIRE(decoded->compactPointers()[0].key == "pointer");
+    REQUIRE(decoded->deletedFiles().size() == 1);
+    REQUIRE(decoded->deletedFiles()[0].number == 7);
+    REQUIRE(decoded->newFiles().size() == 2);
+    REQUIRE(decoded->newFiles()[1].level == 2);
+    REQUIRE(decoded->newFiles()[1].number == 41);
+    REQUIRE(decoded->newFiles()[1].newestFlush == 39);
+
+    encoded[3] ^= std::byte{0x01};
+    REQUIRE(!compaction::VersionEdit::decode(encoded.data(), encoded.size()).has_value());
+    REQUIRE(!compaction::VersionEdit::decode(encoded.data(), 2).has_value());
+};
+
+TEST_CASE("compaction scheduler should recover its levels from the MANIFEST", "[COMPACTION]") {
+    const std::string dir = "version_set_recover";
+    std::filesystem::remove_all(dir);
+    const auto engine = std::make_shared<io_engine::POSIXEngine>(0);
+
+    std::vector<std::vector<uint64_t> > before;
+    uint64_t lastFlushed = 0;
+    {
+        compaction::CompactionScheduler scheduler(engine, dir, TESTS::smallTree(8));
+        for (int64_t round = 0; round < 6; ++round) {
+            lastFlushed = TESTS::flushRange(scheduler, 300 * round, 300 * round + 900, 1, round + 1);
+            scheduler.waitForIdle();
+        }
+
+        // One more table left in L0
+        lastFlushed = TESTS::flushRange(scheduler, 0, 100, 1, 7);
+        before = layout(scheduler);
+        REQUIRE(scheduler.stats().compactions > 0);
+    }
+
+    // A table an interrupted compaction left behind
+    std::filesystem::copy_file(std::filesystem::path(dir) / sstable::tableFileName(lastFlushed),
+                               std::filesystem::path(dir) / sstable::tableFileName(lastFlushed + 100));
+
+    compaction::CompactionScheduler scheduler(engine, dir, TESTS::smallTree(8));
+    REQUIRE(layout(scheduler) == before);
+    REQUIRE(!std::filesystem::exists(std::filesystem::path(dir) / sstable::tableFileName(lastFlushed + 100)));
+
+    size_t live = 0;
+    for (const auto &files: before) live += files.size();
+    REQUIRE(tablesIn(dir) == live);
+
+    for (int64_t i = 0; i < 300 * 5 + 900; ++i) {
+        const auto entry = scheduler.get(TESTS::keyOf(i));
+        REQUIRE(entry.has_value());
+        REQUIRE(entry->timestamp_ == (i < 100 ? 7u : static_cast<uint64_t>(std::min<int64_t>(5, i / 300) + 1)));
+    }
+
+    // New tables are numbered after everything that was ever in the directory
+    REQUIRE(TESTS::flushRange(scheduler, 0, 10, 1, 8) > lastFlushed + 100);
+    REQUIRE(scheduler.get(TESTS::keyOf(5))->timestamp_ == 8);
+
+    // Only one MANIFEST is kept
+    size_t manifests = 0;
+    for (const auto &file: std::filesystem::directory_iterator(dir)) {
+        manifests += file.path().filename().string().starts_with("MANIFEST-");
+    }
+    REQUIRE(manifests == 1);
+
+    std::filesystem::remove_all(dir);
+};
+
+TEST_CASE("compaction scheduler should ignore a torn edit at the end of the MANIFEST", "[COMPACTION]") {
+    const std::string dir = "version_set_torn";
+    std::filesystem::remove_all(dir);
+    const auto engine = std::make_shared<io_engine::POSIXEngine>(0);
+
+    std::vector<std::vector<uint64_t> > before;
+    {
+        compaction::CompactionScheduler scheduler(engine, dir, TESTS::smallTree(8));
+        TESTS::flushRange(scheduler, 0, 500, 1, 1);
+        before = layout(scheduler);
+    }
+
+    std::string manifest;
+    std::ifstream(std::filesystem::path(dir) / "CURRENT") >> manifest;
+    std::ofstream(std::filesystem::path(dir) / manifest, std::ios::app | std::ios::binary) << "WAL01\x40";
+
+    compaction::CompactionScheduler scheduler(engine, dir, TESTS::smallTree(8));
+    REQUIRE(layout(scheduler) == before);
+    REQUIRE(scheduler.get(TESTS::keyOf(42))->timestamp_ == 1);
+
+    std::filesystem::remove_all(dir);
+};
+
+TEST_CASE("a pinned version should keep compacted tables on disk until it is released", "[COMPACTION]") {
+    const std::string dir = "version_set_pinned";
+    std::filesystem::remove_all(dir);
+    const auto engine = std::make_shared<io_engine::POSIXEngine>(0);
+
+    auto options = TESTS::smallTree(8);
+    options.targetFileBytes = 64_MB;
+    compaction::CompactionScheduler scheduler(engine, dir, options);
+
+    TESTS::flushRange(scheduler, 0, 500, 1, 1);
+    TESTS::flushRange(scheduler, 0, 500, 1, 2);
+
+    auto pinned = scheduler.current();
+    REQUIRE(pinned->levels[0].size() == 2);
+
+    REQUIRE(scheduler.compactOnce());
+    REQUIRE(scheduler.filesAtLevel(0) == 0);
+    REQUIRE(scheduler.filesAtLevel(1) == 1);
+
+    // The old L0 tables are still readable through the pinned version
+    REQUIRE(tablesIn(dir) == 3);
+    std::string value;
+    REQUIRE(pinned->levels[0].front()->reader->get(pinned->levels[0].front()->props.smallestKey, value));
+
+    // Released, they go with the next installed change
+    pinned.reset();
+    TESTS::flushRange(scheduler, 0, 10, 1, 3);
+    REQUIRE(tablesIn(dir) == 2);
+
+    std::filesystem::remove_all(dir);
+};
+
+TEST_CASE("a failed MANIFEST append should leave a MANIFEST that recovers without the edit", "[COMPACTION]") {
+    const std::string dir = "version_set_failed_append";
+
+    for (const auto fault: {ManifestFaults::Fault::SyncFails, ManifestFaults::Fault::TornWrite}) {
+        std::filesystem::remove_all(dir);
+        const auto engine = std::make_shared<ManifestFaults>();
+        engine->fault = fault;
+        {
+            compaction::CompactionScheduler scheduler(engine, dir, TESTS::smallTree(8));
+            TESTS::flushRange(scheduler, 0, 100, 1, 1);
+
+            // The flushed table is gone again, the MANIFEST it may have reached is replaced
+            engine->failures = 1;
+            REQUIRE_THROWS_AS(TESTS::flushRange(scheduler, 100, 200, 1, 2), std::runtime_error);
+            REQUIRE(tablesIn(dir) == 1);
+
+            // Later edits go to the new MANIFEST
+            TESTS::flushRange(scheduler, 200, 300, 1, 3);
+        }
+
+        compaction::CompactionScheduler scheduler(std::make_shared<io_engine::POSIXEngine>(0), dir,
+                                                  TESTS::smallTree(8));
+        REQUIRE(scheduler.filesAtLevel(0) == 2);
+        REQUIRE(scheduler.get(TESTS::keyOf(50))->timestamp_ == 1);
+        REQUIRE(!scheduler.get(TESTS::keyOf(150)).has_value());
+        REQUIRE(scheduler.get(TESTS::keyOf(250))->timestamp_ == 3);
+    }
+
+    std::filesystem::remove_all(dir);
+};
+
+TEST_CASE("a MANIFEST that cannot be replaced should refuse edits and keep their tables", "[COMPACTION]") {
+    const std::string dir = "version_set_failed_manifest";
+    std::filesystem::remove_all(dir);
+    const auto engine = std::make_shared<ManifestFaults>();
+    {
+        compaction::CompactionScheduler scheduler(engine, dir, TESTS::smallTree(8));
+        TESTS::flushRange(scheduler, 0, 100, 1, 1);
+
+        // Syncing the edit fails and so does the new MANIFEST, the edit may or may not be durable
+        engine->failures = 2;
+        REQUIRE_THROWS_AS(TESTS::flushRange(scheduler, 100, 200, 1, 2), std::runtime_error);
+        REQUIRE(tablesIn(dir) == 2);
+        REQUIRE_THROWS_AS(TESTS::flushRange(scheduler, 200, 300, 1, 3), std::runtime_error);
+    }
+
+    // The edit did land, and its table is still there
+    compaction::CompactionScheduler scheduler(std::make_shared<io_engine::POSIXEngine>(0), dir, TESTS::smallTree(8));
+    REQUIRE(scheduler.get(TESTS::keyOf(50))->timestamp_ == 1);
+    REQUIRE(scheduler.get(TESTS::keyOf(150))->timestamp_ == 2);
+    REQUIRE(!scheduler.get(TESTS::keyOf(250)).has_value());
+
+    std::filesystem::remove_all(dir);
+};
@@ -0,0 +1,148 @@
+//
+// Created by frostzt on 10/17/2026.
+//
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "catch2/catch_test_macros.hpp"
+#include "lib/entry/entry_view.hpp"
+#include "lib/memtable/memtable.hpp"
+#include "tests/test_utils.hpp"
+
+namespace {
+    using core::datatypes::Field;
+    using core::datatypes::FieldType;
+
+    core::Key compositeKey() {
+        return core::Key{{TESTS::makeField(std::string("tenant_7")), TESTS::makeField(int64_t{42})}};
+    }
+
+    core::Row customerRow() {
+        return {
+            {"name", TESTS::makeField(std::string("alice"))},
+            {"age", TESTS::makeField(int32_t{30})},
+            {"balance", TESTS::makeField(12.5)},
+            {"active", Field{true, FieldType::Bool, nullptr}},
+            {"joined", TESTS::makeField(std::chrono::system_clock::time_point(std::chrono::nanoseconds(99)))},
+            {"avatar", TESTS::makeField(std::vector<uint8_t>{0x01, 0x02})},
+            {"nickname", Field{std::monostate{}, FieldType::Null, nullptr}},
+        };
+    }
+} // namespace
+
+TEST_CASE("entry views should read named columns in place", "[ENTRY]") {
+    const core::Entry entry{"view_customers", compositeKey(), customerRow(), false, 1234};
+    const auto serialized = entry.serialize();
+
+    const auto view = core::EntryView::parse(serialized.data(), serialized.size());
+    REQUIRE(view.has_value());
+    REQUIRE(view->tableName() == "view_customers");
+    REQUIRE(view->tableId() == core::TableSchema::kNoTableId);
+    REQUIRE(view->schema() == nullptr);
+    REQUIRE(view->timestamp() == 1234);
+    REQUIRE(!view->isTombstone());
+    REQUIRE(view->bytes().size() == serialized.size());
+
+    // The key, part by part and as a whole
+    REQUIRE(view->keyPartCount() == 2);
+    REQUIRE(view->keyPart(0).asString() == "tenant_7");
+    REQUIRE(view->keyPart(1).asInt64() == 42);
+    REQUIRE(view->key() == compositeKey());
+    REQUIRE(view->keyBytes().data() == serialized.data() + entry.serializedKeyOffset());
+
+    REQUIRE(view->column("name")->asString() == "alice");
+    REQUIRE(view->column("age")->asInt32() == 30);
+    REQUIRE(view->column("balance")->asDouble() == 12.5);
+    REQUIRE(view->column("active")->asBool());
+    REQUIRE(view->column("joined")->asTimestamp().time_since_epoch() == std::chrono::nanoseconds(99));
+    REQUIRE(view->column("avatar")->asBinary().size() == 2);
+    REQUIRE(view->column("nickname")->isNull());
+    REQUIRE(!view->column("missing").has_value());
+    REQUIRE_THROWS_AS((void) view->column("age")->asInt64(), std::runtime_error);
+
+    size_t columns = 0;
+    view->forEachColumn([&columns](std::string_view, const core::FieldView &) { ++columns; });
+    REQUIRE(columns == customerRow().size());
+
+    REQUIRE(core::Entry::compareRowData(view->row(), customerRow()));
+    REQUIRE(core::Entry::compareEntries(view->toEntry(), entry));
+};
+
+TEST_CASE("entry views should read packed rows through their schema", "[ENTRY]") {
+    const auto schema = std::make_shared<const core::TableSchema>("view_orders", std::vector<core::ColumnSchema>{
+                                                                      {"customer", FieldType::String},
+                                                                      {"quantity", FieldType::Int32},
+                                                                      {"token", FieldType::UUID},
+                                                                      {"note", FieldType::String},
+                                                                  });
+    const core::Row row{
+        {"customer", TESTS::makeField(std::string("bob"))},
+        {"quantity", TESTS::makeField(int32_t{3})},
+        {"token", TESTS::makeField(core::datatypes::UUID("123e4567-e89b-12d3-a456-426614174000"))},
+    };
+    const core::Entry entry{schema, core::Key{{TESTS::makeField(int64_t{7})}}, row, true, 55};
+    const auto serialized = entry.serialize();
+
+    // Like Entry::deserialize, a packed row needs its schema registered
+    REQUIRE(!core::EntryView::parse(serialized.data(), serialized.size()).has_value());
+    core::SchemaRegistry::global().put(schema);
+
+    const auto view = core::EntryView::parse(serialized.data(), serialized.size());
+    REQUIRE(view.has_value());
+    REQUIRE(view->schema() == schema);
+    REQUIRE(view->packedRow().has_value());
+    REQUIRE(view->isTombstone());
+    REQUIRE(view->timestamp() == 55);
+
+    REQUIRE(view->column("customer")->asString() == "bob");
+    REQUIRE(view->column("quantity")->asInt32() == 3);
+    REQUIRE(view->column("token")->asUUID() == core::datatypes::UUID("123e4567-e89b-12d3-a456-426614174000"));
+    REQUIRE(!view->column("note").has_value());
+    REQUIRE(!view->column("missing").has_value());
+
+    REQUIRE(core::Entry::compareRowData(view->row(), row));
+    REQUIRE(core::Entry::compareEntries(view->toEntry(), entry));
+};
+
+TEST_CASE("entry views should reject malformed entries", "[ENTRY]") {
+    const core::Entry entry{"view_customers", compositeKey(), customerRow(), false, 1234};
+    auto serialized = entry.serialize();
+
+    // Bytes past the entry are not part of it
+    auto padded = serialized;
+    padded.resize(serialized.size() + 16);
+    REQUIRE(core::EntryView::parse(padded.data(), padded.size())->bytes().size() == serialized.size());
+
+    REQUIRE(!core::EntryView::parse(serialized.data(), serialized.size() - 1).has_value());
+    REQUIRE(!core::EntryView::parse(serialized.data(), 3).has_value());
+
+    // A flipped timestamp bit only shows in the checksum
+    serialized[serialized.size() - 12] ^= std::byte{0x01};
+    REQUIRE(!core::EntryView::parse(serialized.data(), serialized.size()).has_value());
+    REQUIRE(core::EntryView::parse(serialized.data(), serialized.size(), false)->timestamp() == 1235);
+
+    // A column length running into the trailer does not parse, checksum or not
+    auto truncated = entry.serialize();
+    const size_t rowOffset = entry.serializedKeyOffset() + compositeKey().parts_.size() * 2 + 2 +
+                             compositeKey().parts_[0].serializedSize() + compositeKey().parts_[1].serializedSize();
+    truncated[rowOffset] = std::byte{0xFE};
+    REQUIRE(!core::EntryView::parse(truncated.data(), truncated.size(), false).has_value());
+};
+
+TEST_CASE("memtables should store entry views without decoding them", "[ENTRY]") {
+    const core::Entry entry{"view_customers", compositeKey(), customerRow(), false, 77};
+    const auto serialized = entry.serialize();
+    const auto view = core::EntryView::parse(serialized.data(), serialized.size());
+
+    for (const auto backend: {memtable::MemTableBackend::AVL, memtable::MemTableBackend::SkipList}) {
+        const memtable::MemTable memTable{"view_customers", backend};
+        memTable.put(*view);
+
+        const auto found = memTable.get(compositeKey());
+        REQUIRE(found.has_value());
+        REQUIRE(core::Entry::compareEntries(*found, entry));
+    }
+};
@@ -0,0 +1,104 @@
+//
+// Created by frostzt on 10/17/2026.
+//
+
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "catch2/catch_test_macros.hpp"
+#include "lib/entry/key.hpp"
+#include "tests/test_utils.hpp"
+
+namespace {
+    int sign(const int value) { return (value > 0) - (value < 0); }
+
+    /** Encodings must compare like the keys themselves and decode back to them */
+    void requireOrderPreserved(const std::vector<core::Key> &keys) {
+        for (const auto &lhs: keys) {
+            const std::string encoded = lhs.orderedBytes();
+            REQUIRE(core::Key::decodeOrdered(reinterpret_cast<const std::byte *>(encoded.data()), encoded.size()) ==
+                    lhs);
+
+            for (const auto &rhs: keys) {
+                const int expected = lhs < rhs ? -1 : rhs < lhs ? 1 : 0;
+                REQUIRE(sign(core::Key::compareOrdered(encoded, rhs.orderedBytes())) == expected);
+            }
+        }
+    }
+} // namespace
+
+TEST_CASE("ordered keys should sort integers and timestamps across the sign boundary", "[KEY]") {
+    // Fields of different types do not compare, every type gets its own set
+    std::vector<core::Key> int64s, int32s, timestamps;
+    for (const int64_t v: {std::numeric_limits<int64_t>::min(), int64_t{-256}, int64_t{-1}, int64_t{0}, int64_t{1},
+                           int64_t{255}, int64_t{256}, std::numeric_limits<int64_t>::max()}) {
+        int64s.push_back(core::Key{{TESTS::makeField(v)}});
+        int32s.push_back(core::Key{{TESTS::makeField(static_cast<int32_t>(std::clamp<int64_t>(v, INT32_MIN, INT32_MAX)))}});
+        timestamps.push_back(
+            core::Key{{TESTS::makeField(std::chrono::system_clock::time_point(std::chrono::nanoseconds(v)))}});
+    }
+
+    requireOrderPreserved(int64s);
+    requireOrderPreserved(int32s);
+    requireOrderPreserved(timestamps);
+};
+
+TEST_CASE("ordered keys should sort doubles like operator<", "[KEY]") {
+    std::vector<core::Key> keys;
+    for (const double v: {-std::numeric_limits<double>::infinity(), -1e300, -2.5, -std::numeric_limits<double>::min(),
+                          0.0, std::numeric_limits<double>::denorm_min(), 1.0, 2.5, 1e300,
+                          std::numeric_limits<double>::infinity()}) {
+        keys.push_back(core::Key{{TESTS::makeField(v)}});
+    }
+
+    requireOrderPreserved(keys);
+
+    // -0.0 == 0.0, the encodings must agree
+    REQUIRE(core::Key{{TESTS::makeField(-0.0)}}.orderedBytes() == core::Key{{TESTS::makeField(0.0)}}.orderedBytes());
+};
+
+TEST_CASE("ordered keys should escape zero bytes so prefixes sort first", "[KEY]") {
+    std::vector<core::Key> strings, binaries, composites;
+    for (const std::string &v: {std::string(), std::string(1, '\0'), std::string(2, '\0'), std::string("a"),
+                               std::string("a\0", 2), std::string("a\0b", 3), std::string("a\xff", 2),
+                               std::string("ab"), std::string("b")}) {
+        strings.push_back(core::Key{{TESTS::makeField(v)}});
+        binaries.push_back(core::Key{{TESTS::makeField(std::vector<uint8_t>(v.begin(), v.end()))}});
+
+        // A string followed by another component must not bleed into it
+        composites.push_back(core::Key{{TESTS::makeField(v)}});
+        composites.push_back(core::Key{{TESTS::makeField(v), TESTS::makeField(std::string(1, '\0'))}});
+        composites.push_back(core::Key{{TESTS::makeField(v), TESTS::makeField(std::string("\x01"))}});
+    }
+
+    requireOrderPreserved(strings);
+    requireOrderPreserved(binaries);
+    requireOrderPreserved(composites);
+};
+
+TEST_CASE("ordered keys should compare composite keys component by component", "[KEY]") {
+    std::mt19937_64 rng(7);
+    std::vector<core::Key> keys;
+    for (int i = 0; i < 200; ++i) {
+        std::vector<core::datatypes::Field> parts;
+        parts.push_back(TESTS::makeField(std::string(rng() % 3, static_cast<char>('a' + rng() % 2))));
+        if (rng() % 4 == 0) {
+            keys.emplace_back(std::move(parts));
+            continue;
+        }
+
+        parts.push_back(TESTS::makeField(static_cast<int64_t>(rng() % 5) - 2));
+        if (rng() % 2 != 0) {
+            std::array<uint8_t, 16> uuid{};
+            uuid[rng() % 16] = static_cast<uint8_t>(rng());
+            parts.push_back(TESTS::makeField(core::datatypes::UUID{uuid}));
+        }
+        keys.emplace_back(std::move(parts));
+    }
+
+    requireOrderPreserved(keys);
+};
@@ -0,0 +1,163 @@
+//
+// Created by frostzt on 10/17/2026.
+//
+
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "catch2/catch_test_macros.hpp"
+#include "lib/entry/entry.hpp"
+#include "lib/entry/packed_row.hpp"
+#include "tests/test_utils.hpp"
+
+namespace {
+    using core::datatypes::FieldType;
+
+    std::vector<core::ColumnSchema> orderColumns() {
+        return {
+            {"id", FieldType::Int64},
+            {"customer", FieldType::String},
+            {"quantity", FieldType::Int32},
+            {"price", FieldType::Double},
+            {"paid", FieldType::Bool},
+            {"placed_at", FieldType::Timestamp},
+            {"token", FieldType::UUID},
+            {"note", FieldType::Binary},
+        };
+    }
+
+    core::Row orderRow() {
+        return {
+            {"id", TESTS::makeField(int64_t{42})},
+            {"customer", TESTS::makeField(std::string("alice"))},
+            {"quantity", TESTS::makeField(int32_t{-3})},
+            {"price", TESTS::makeField(19.5)},
+            {"paid", core::datatypes::Field{true, FieldType::Bool, nullptr}},
+            {"placed_at", TESTS::makeField(std::chrono::system_clock::time_point(std::chrono::nanoseconds(1234567)))},
+            {"token", TESTS::makeField(core::datatypes::UUID("123e4567-e89b-12d3-a456-426614174000"))},
+            {"note", TESTS::makeField(std::vector<uint8_t>{0x00, 0xFF, 0x10})},
+        };
+    }
+} // namespace
+
+TEST_CASE("packed rows should round trip every column type", "[ROW]") {
+    const core::TableSchema schema{"orders", orderColumns()};
+    const auto row = orderRow();
+
+    std::vector<std::byte> packed;
+    core::encodePackedRow(schema, row, packed);
+    REQUIRE(packed.size() == core::packedRowSize(schema, row));
+
+    const core::PackedRowView view(schema, packed.data(), packed.size());
+    REQUIRE(view.storedColumns() == 8);
+    REQUIRE(view.getInt64(0) == 42);
+    REQUIRE(view.getString(1) == "alice");
+    REQUIRE(view.getInt32(2) == -3);
+    REQUIRE(view.getDouble(3) == 19.5);
+    REQUIRE(view.getBool(4));
+    REQUIRE(view.getTimestamp(5).time_since_epoch() == std::chrono::nanoseconds(1234567));
+    REQUIRE(view.getUUID(6) == core::datatypes::UUID("123e4567-e89b-12d3-a456-426614174000"));
+    REQUIRE(view.getBinary(7).size() == 3);
+    REQUIRE(view.getBinary(7)[1] == std::byte{0xFF});
+    REQUIRE(*view.field("customer") == TESTS::makeField(std::string("alice")));
+    REQUIRE(!view.field("missing").has_value());
+
+    REQUIRE(core::Entry::compareRowData(view.toRow(), row));
+};
+
+TEST_CASE("packed rows should be smaller than the legacy row encoding", "[ROW]") {
+    const auto schema = std::make_shared<const core::TableSchema>("orders", orderColumns());
+    const core::Key key{{TESTS::makeField(int64_t{42})}};
+
+    const core::Entry legacy{"orders", key, orderRow(), false, 7};
+    const core::Entry packed{schema, key, orderRow(), false, 7};
+    REQUIRE(packed.serialize().size() < legacy.serialize().size());
+};
+
+TEST_CASE("packed rows should store null and absent columns as null", "[ROW]") {
+    const core::TableSchema schema{"orders", orderColumns()};
+    const core::Row row{
+        {"id", TESTS::makeField(int64_t{1})},
+        {"note", core::datatypes::Field{std::monostate{}, FieldType::Null, nullptr}},
+    };
+
+    std::vector<std::byte> packed;
+    core::encodePackedRow(schema, row, packed);
+
+    const core::PackedRowView view(schema, packed.data(), packed.size());
+    REQUIRE(!view.isNull(0));
+    for (uint16_t id = 1; id < 8; ++id) REQUIRE(view.isNull(id));
+    REQUIRE(view.getString(1).empty());
+
+    const auto decoded = view.toRow();
+    REQUIRE(decoded.size() == 1);
+    REQUIRE(decoded.at("id") == TESTS::makeField(int64_t{1}));
+};
+
+TEST_CASE("packed rows should read under a schema that gained columns", "[ROW]") {
+    const core::TableSchema before{"orders", {{"id", FieldType::Int64}, {"customer", FieldType::String}}};
+    auto columns = before.columns();
+    columns.push_back({"quantity", FieldType::Int32});
+    columns.push_back({"comment", FieldType::String});
+    const core::TableSchema after{"orders", columns};
+
+    std::vector<std::byte> packed;
+    core::encodePackedRow(before, {{"id", TESTS::makeField(int64_t{5})}, {"customer", TESTS::makeField(std::string("bob"))}},
+                          packed);
+
+    const core::PackedRowView view(after, packed.data(), packed.size());
+    REQUIRE(view.storedColumns() == 2);
+    REQUIRE(view.getString(1) == "bob");
+    REQUIRE(view.isNull(2));
+    REQUIRE(view.isNull(3));
+    REQUIRE(view.toRow().size() == 2);
+
+    // A row of the newer schema does not read under the older one
+    std::vector<std::byte> newer;
+    core::encodePackedRow(after, {{"comment", TESTS::makeField(std::string("late"))}}, newer);
+    REQUIRE_THROWS_AS(core::PackedRowView(before, newer.data(), newer.size()), std::runtime_error);
+    REQUIRE_THROWS_AS(core::PackedRowView(after, newer.data(), newer.size() - 1), std::runtime_error);
+};
+
+TEST_CASE("packed rows should reject columns the schema does not describe", "[ROW]") {
+    const core::TableSchema schema{"orders", orderColumns()};
+    std::vector<std::byte> packed;
+
+    REQUIRE_THROWS_AS(core::encodePackedRow(schema, {{"unknown", TESTS::makeField(int64_t{1})}}, packed),
+                      std::runtime_error);
+    REQUIRE_THROWS_AS(core::encodePackedRow(schema, {{"id", TESTS::makeField(int32_t{1})}}, packed),
+                      std::runtime_error);
+
+    REQUIRE_THROWS_AS(core::TableSchema("orders", {{"id", FieldType::Int64}, {"id", FieldType::String}}),
+                      std::invalid_argument);
+    REQUIRE_THROWS_AS(core::TableSchema("orders", {{"id", FieldType::Custom}}), std::invalid_argument);
+};
+
+TEST_CASE("entries should deserialize packed rows through the schema registry", "[ROW]") {
+    const auto schema = std::make_shared<const core::TableSchema>("packed_orders", orderColumns());
+    const core::Entry entry{schema, core::Key{{TESTS::makeField(int64_t{42})}}, orderRow(), false, 99};
+    const auto serialized = entry.serialize();
+
+    // Without the schema the row cannot be read
+    REQUIRE(!core::Entry::deserialize(serialized.data(), serialized.size()).has_value());
+
+    core::SchemaRegistry::global().put(schema);
+    const auto decoded = core::Entry::deserialize(serialized.data(), serialized.size());
+    REQUIRE(decoded.has_value());
+    REQUIRE(core::Entry::compareEntries(*decoded, entry));
+    REQUIRE(decoded->schema_ == schema);
+    REQUIRE(core::Entry::serializedTimestamp(serialized.data(), serialized.size()) == 99);
+
+    // A schema that appends columns may replace it, one that rewrites them may not
+    auto columns = orderColumns();
+    columns.push_back({"discount", FieldType::Double});
+    core::SchemaRegistry::global().put(std::make_shared<const core::TableSchema>("packed_orders", columns));
+    REQUIRE(core::Entry::compareEntries(*core::Entry::deserialize(serialized.data(), serialized.size()), entry));
+
+    REQUIRE_THROWS_AS(core::SchemaRegistry::global().put(std::make_shared<const core::TableSchema>(
+                          "packed_orders", std::vector<core::ColumnSchema>{{"id", FieldType::String}})),
+                      std::invalid_argument);
+};
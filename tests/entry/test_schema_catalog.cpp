@@ -0,0 +1,136 @@
+//
+// Created by frostzt on 10/17/2026.
+//
+
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+
+#include "catch2/catch_test_macros.hpp"
+#include "lib/entry/entry_view.hpp"
+#include "lib/entry/schema_catalog.hpp"
+#include "lib/io/posix_engine.hpp"
+#include "lib/memtable/memtable_manager.hpp"
+#include "lib/wal/wal_codec.hpp"
+#include "tests/test_utils.hpp"
+
+namespace {
+    using core::datatypes::FieldType;
+
+} // namespace
+
+TEST_CASE("schema catalog should persist tables and let entries refer to them by id", "[CATALOG]") {
+    const std::string dir = "schema_catalog";
+    std::filesystem::remove_all(dir);
+    const auto engine = std::make_shared<io_engine::POSIXEngine>(0);
+
+    const std::string tableName = "catalog_customers_with_a_long_name";
+    {
+        core::SchemaCatalog catalog(engine, dir);
+        const auto customers = catalog.createTable(tableName, {{"name", FieldType::String}});
+        const auto orders = catalog.createTable("catalog_orders", {{"total", FieldType::Double}});
+        REQUIRE(customers->tableId() == 1);
+        REQUIRE(orders->tableId() == 2);
+
+        REQUIRE_THROWS_AS(catalog.createTable(tableName, {}), std::invalid_argument);
+        REQUIRE_THROWS_AS(catalog.addColumns("missing", {}), std::invalid_argument);
+
+        const auto grown = catalog.addColumns(tableName, {{"age", FieldType::Int32}});
+        REQUIRE(grown->tableId() == 1);
+        REQUIRE(grown->columnId("age") == 1);
+        REQUIRE(catalog.find(1u) == grown);
+        REQUIRE(catalog.schemas()->find(1u) == grown);
+        REQUIRE(core::SchemaRegistry::global().find(1u) == nullptr);
+    }
+
+    // A torn record at the tail is dropped on reopening
+    std::ofstream(std::filesystem::path(dir) / core::SchemaCatalog::kFileName, std::ios::app | std::ios::binary)
+            << "WAL01\x40";
+
+    core::SchemaCatalog catalog(engine, dir);
+    const auto customers = catalog.find(tableName);
+    REQUIRE(customers != nullptr);
+    REQUIRE(customers->tableId() == 1);
+    REQUIRE(customers->columnCount() == 2);
+    REQUIRE(catalog.find(2u)->tableName() == "catalog_orders");
+    REQUIRE(catalog.createTable("catalog_items", {})->tableId() == 3);
+    REQUIRE(catalog.tables().size() == 3);
+
+    // The table id replaces the name in the encoded entry
+    const core::Row row{{"name", TESTS::makeField(std::string("alice"))}, {"age", TESTS::makeField(int32_t{30})}};
+    const core::Entry entry{customers, TESTS::keyOf(1), row, false, 11};
+    const core::Entry named{tableName, TESTS::keyOf(1), row, false, 11};
+    const auto encoded = entry.serialize();
+    REQUIRE(encoded.size() + tableName.size() < named.serialize().size());
+    REQUIRE(entry.serializedKeyOffset() == 5 + 8 + 2 + 1);
+
+    // Only the catalog's own registry knows its ids
+    REQUIRE(!core::Entry::deserialize(encoded.data(), encoded.size()).has_value());
+    const auto decoded = core::Entry::deserialize(encoded.data(), encoded.size(), *catalog.schemas());
+    REQUIRE(decoded.has_value());
+    REQUIRE(decoded->tableName == tableName);
+    REQUIRE(core::Entry::compareEntries(*decoded, entry));
+
+    // Through the WAL framing
+    std::vector<std::byte> framed;
+    WAL::encodeRecord(framed, entry);
+    size_t offset = 0;
+    const std::byte *payload = nullptr;
+    uint32_t payloadLength = 0;
+    REQUIRE(WAL::nextFrame(framed.data(), framed.size(), offset, payload, payloadLength));
+    REQUIRE(core::Entry::deserialize(payload, payloadLength, *catalog.schemas())->tableName == tableName);
+
+    // MemTables of the table keep their entries and tombstones by id
+    memtable::MemTableManager memTables{customers, memtable::MemTableBackend::AVL,
+                                        memtable::MemTableManager::kDefaultMaxMemTableBytes, catalog.schemas()};
+    memTables.apply(entry);
+    memTables.apply(core::Entry{customers, TESTS::keyOf(2), row, false, 12});
+    REQUIRE(memTables.get(TESTS::keyOf(1))->tableName == tableName);
+    REQUIRE(memTables.get(TESTS::keyOf(2))->rowData_.at("age") == TESTS::makeField(int32_t{30}));
+
+    std::filesystem::remove_all(dir);
+};
+
+TEST_CASE("schema catalogs should keep the table ids of their databases apart", "[CATALOG]") {
+    const std::string firstDir = "schema_catalog_first";
+    const std::string secondDir = "schema_catalog_second";
+    std::filesystem::remove_all(firstDir);
+    std::filesystem::remove_all(secondDir);
+    const auto engine = std::make_shared<io_engine::POSIXEngine>(0);
+
+    const core::Row row{{"name", TESTS::makeField(std::string("alice"))}};
+    std::vector<std::byte> users;
+    std::vector<std::byte> accounts;
+    {
+        // Both databases hand out table id 1, to different tables
+        core::SchemaCatalog first(engine, firstDir);
+        core::SchemaCatalog second(engine, secondDir);
+        const auto usersTable = first.createTable("catalog_users", {{"name", FieldType::String}});
+        const auto accountsTable = second.createTable("catalog_accounts", {{"name", FieldType::String}});
+        REQUIRE(usersTable->tableId() == 1);
+        REQUIRE(accountsTable->tableId() == 1);
+
+        users = core::Entry{usersTable, TESTS::keyOf(1), row, false, 1}.serialize();
+        accounts = core::Entry{accountsTable, TESTS::keyOf(1), row, false, 2}.serialize();
+        REQUIRE(core::Entry::deserialize(users.data(), users.size(), *first.schemas())->tableName == "catalog_users");
+        REQUIRE(core::Entry::deserialize(accounts.data(), accounts.size(), *second.schemas())->tableName ==
+                "catalog_accounts");
+
+        // A rejected change never reaches the CATALOG
+        REQUIRE_THROWS_AS(first.addColumns("catalog_users", {{"name", FieldType::Int32}}), std::invalid_argument);
+    }
+
+    // Both reopen, side by side in the same process
+    core::SchemaCatalog first(engine, firstDir);
+    core::SchemaCatalog second(engine, secondDir);
+    REQUIRE(first.find(1u)->tableName() == "catalog_users");
+    REQUIRE(first.find(1u)->columnCount() == 1);
+    REQUIRE(second.find(1u)->tableName() == "catalog_accounts");
+    REQUIRE(core::EntryView::parse(users.data(), users.size(), true, *first.schemas())->tableName() ==
+            "catalog_users");
+    REQUIRE(core::EntryView::parse(accounts.data(), accounts.size(), true, *second.schemas())->tableName() ==
+            "catalog_accounts");
+
+    std::filesystem::remove_all(firstDir);
+    std::filesystem::remove_all(secondDir);
+};
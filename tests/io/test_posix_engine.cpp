@@ -0,0 +1,87 @@
+//
+// Created by frostzt on 10/17/2026.
+//
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "catch2/catch_test_macros.hpp"
+#include "lib/io/posix_engine.hpp"
+
+TEST_CASE("posix engine should append to segments and trim preallocation on close", "[IO]") {
+    const std::string path = "io_engine";
+    std::filesystem::create_directory(path);
+
+    io_engine::POSIXEngine engine{64_KB};
+
+    const std::string first = "hello ";
+    const std::string second = "world";
+
+    auto seg = engine.openSegment(path, "segment.log");
+    REQUIRE(seg.valid());
+    REQUIRE(engine.write(seg, first.data(), first.size()) == static_cast<long long>(first.size()));
+    REQUIRE(engine.flush(seg));
+
+    // Preallocated space is not part of the file's size
+    REQUIRE(std::filesystem::file_size(path + "/segment.log") == first.size());
+    REQUIRE(engine.close(seg));
+    REQUIRE(!engine.flush(seg));
+
+    // Reopening continues at the end of the file
+    seg = engine.openSegment(path, "segment.log");
+    REQUIRE(engine.write(seg, second.data(), second.size()) == static_cast<long long>(second.size()));
+    REQUIRE(engine.close(seg));
+
+    std::ifstream in(path + "/segment.log", std::ios::in | std::ios::binary);
+    const std::string contents{std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()};
+    REQUIRE(contents == first + second);
+
+    REQUIRE(!engine.openSegment(path + "/missing", "segment.log").valid());
+
+    std::filesystem::remove_all(path);
+};
+
+TEST_CASE("io engines should read back synced writes in batches", "[IO]") {
+    const std::string path = "io_engine";
+    std::filesystem::create_directory(path);
+
+    // Uring falls back to POSIX when it is not available, either way both must behave the same
+    for (const auto type: {io_engine::IoEngineType::POSIX, io_engine::IoEngineType::Uring}) {
+        const auto engine = io_engine::createIoEngine(type, 64_KB);
+
+        std::string payload(400_KB, '\0');
+        for (size_t i = 0; i < payload.size(); ++i) payload[i] = static_cast<char>('a' + i % 26);
+
+        auto seg = engine->openSegment(path, "batch.log");
+        REQUIRE(engine->writeSync(seg, payload.data(), payload.size()) == static_cast<long long>(payload.size()));
+        REQUIRE(engine->close(seg));
+
+        REQUIRE(!engine->openReadOnly(path, "missing.log").valid());
+        seg = engine->openReadOnly(path, "batch.log");
+        REQUIRE(seg.valid());
+
+        // More reads than a single submission holds, one of them past the end of the file
+        std::vector<std::string> buffers(100, std::string(4_KB, '\0'));
+        std::vector<io_engine::ReadRequest> requests;
+        for (size_t i = 0; i < buffers.size(); ++i) {
+            requests.push_back({seg, i * 3_KB, buffers[i].data(), buffers[i].size()});
+        }
+        std::string tail(100, '\0');
+        requests.push_back({seg, payload.size() - 10, tail.data(), tail.size()});
+        engine->readBatch(requests);
+
+        REQUIRE(requests.back().result == 10);
+        REQUIRE(tail.substr(0, 10) == payload.substr(payload.size() - 10));
+        for (size_t i = 0; i < buffers.size(); ++i) {
+            REQUIRE(requests[i].result == static_cast<long long>(4_KB));
+            REQUIRE(buffers[i] == payload.substr(i * 3_KB, 4_KB));
+        }
+
+        REQUIRE(engine->close(seg));
+        std::filesystem::remove(path + "/batch.log");
+    }
+
+    std::filesystem::remove_all(path);
+};
@@ -0,0 +1,111 @@
+//
+// Created by frostzt on 10/17/2026.
+//
+
+#include <algorithm>
+
+#include "catch2/catch_test_macros.hpp"
+#include "lib/memtable/memtable_manager.hpp"
+#include "lib/utils/constants.hpp"
+#include "tests/test_utils.hpp"
+
+
+TEST_CASE("memtable iterator should walk keys in both directions", "[MEMTABLE]") {
+    for (const auto backend: {memtable::MemTableBackend::AVL, memtable::MemTableBackend::SkipList}) {
+        const memtable::MemTable table{"customers", backend};
+
+        // Even keys only, every key written twice so the skiplist holds two versions
+        for (int64_t i = 0; i < 100; i += 2) {
+            table.put(core::Entry{"customers", TESTS::keyOf(i), {{"name", TESTS::makeField("old")}}, false, 10});
+            table.put(core::Entry{"customers", TESTS::keyOf(i), {{"name", TESTS::makeField("new")}}, false, 20});
+        }
+
+        auto it = table.newIterator();
+
+        int64_t expected = 0;
+        for (it.seekToFirst(); it.valid(); it.next(), expected += 2) {
+            const auto entry = it.entry();
+            REQUIRE(entry.primaryKey_ == TESTS::keyOf(expected));
+            REQUIRE(entry.rowData_.at("name") == TESTS::makeField("new"));
+        }
+        REQUIRE(expected == 100);
+
+        expected = 98;
+        for (it.seekToLast(); it.valid(); it.prev(), expected -= 2) {
+            REQUIRE(it.entry().primaryKey_ == TESTS::keyOf(expected));
+            REQUIRE(it.record().timestamp() == 20);
+        }
+        REQUIRE(expected == -2);
+
+        it.seek(TESTS::keyOf(31));
+        REQUIRE(it.valid());
+        REQUIRE(it.entry().primaryKey_ == TESTS::keyOf(32));
+
+        it.seekForPrev(TESTS::keyOf(31));
+        REQUIRE(it.valid());
+        REQUIRE(it.entry().primaryKey_ == TESTS::keyOf(30));
+
+        it.seek(TESTS::keyOf(99));
+        REQUIRE(!it.valid());
+    }
+};
+
+TEST_CASE("memtable manager iterator should merge active and frozen tables", "[MEMTABLE]") {
+    for (const auto backend: {memtable::MemTableBackend::AVL, memtable::MemTableBackend::SkipList}) {
+        memtable::MemTableManager manager{"customers", backend, 64_KB};
+
+        constexpr int64_t total = 2000;
+        for (int64_t i = 0; i < total; ++i) {
+            manager.apply(core::Entry{"customers", TESTS::keyOf(i), {{"name", TESTS::makeField("v1")}}, false, 10});
+        }
+
+        // Rewrite a stripe of keys and delete another so versions span several tables
+        for (int64_t i = 0; i < total; i += 10) {
+            manager.apply(core::Entry{"customers", TESTS::keyOf(i), {{"name", TESTS::makeField("v2")}}, false, 20});
+            manager.apply(core::Entry{"customers", TESTS::keyOf(i + 5), {}, true, 20});
+        }
+
+        REQUIRE(manager.frozenCount() > 0);
+
+        {
+            auto it = manager.newIterator();
+
+            int64_t expected = 0;
+            for (it.seekToFirst(); it.valid(); it.next(), ++expected) {
+                const auto entry = it.entry();
+                REQUIRE(entry.primaryKey_ == TESTS::keyOf(expected));
+                REQUIRE(entry.isTombstone_ == (expected % 10 == 5));
+                if (expected % 10 == 0) REQUIRE(entry.rowData_.at("name") == TESTS::makeField("v2"));
+            }
+            REQUIRE(expected == total);
+
+            // Switching direction mid-way lands on the neighbouring keys
+            it.seek(TESTS::keyOf(500));
+            it.next();
+            it.prev();
+            it.prev();
+            REQUIRE(it.entry().primaryKey_ == TESTS::keyOf(499));
+            it.next();
+            REQUIRE(it.entry().primaryKey_ == TESTS::keyOf(500));
+            REQUIRE(it.entry().rowData_.at("name") == TESTS::makeField("v2"));
+
+            expected = total - 1;
+            for (it.seekToLast(); it.valid(); it.prev(), --expected) {
+                REQUIRE(it.entry().primaryKey_ == TESTS::keyOf(expected));
+            }
+            REQUIRE(expected == -1);
+        }
+
+        std::vector<core::Key> seen;
+        manager.scan(TESTS::keyOf(100), TESTS::keyOf(130), [&seen](const memtable::Record &record) {
+            seen.push_back(record.toEntry().primaryKey_);
+            return true;
+        });
+
+        // [100, 130) minus the tombstoned 105, 115 and 125
+        REQUIRE(seen.size() == 27);
+        REQUIRE(seen.front() == TESTS::keyOf(100));
+        REQUIRE(seen.back() == TESTS::keyOf(129));
+        REQUIRE(std::ranges::find(seen, TESTS::keyOf(105)) == seen.end());
+    }
+};
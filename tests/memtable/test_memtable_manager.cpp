@@ -0,0 +1,48 @@
+//
+// Created by frostzt on 10/17/2026.
+//
+
+#include "catch2/catch_test_macros.hpp"
+#include "lib/memtable/memtable_manager.hpp"
+#include "lib/utils/constants.hpp"
+#include "tests/test_utils.hpp"
+
+TEST_CASE("memtable size should track distinct keys", "[MEMTABLE]") {
+    for (const auto backend: {memtable::MemTableBackend::AVL, memtable::MemTableBackend::SkipList}) {
+        const memtable::MemTable table{"customers", backend};
+
+        for (int64_t i = 0; i < 100; ++i) {
+            table.put(core::Entry{"customers", core::Key{{TESTS::makeField(i)}}, {}, false});
+        }
+
+        // Overwrites do not add entries
+        for (int64_t i = 0; i < 50; ++i) {
+            table.put(core::Entry{"customers", core::Key{{TESTS::makeField(i)}}, {}, false});
+        }
+
+        REQUIRE(table.size() == 100);
+        REQUIRE(table.approximateMemoryUsage() > 0);
+    }
+};
+
+TEST_CASE("memtable manager should rotate on its byte budget", "[MEMTABLE]") {
+    memtable::MemTableManager manager{"customers", memtable::MemTableBackend::SkipList, 256_KB};
+
+    constexpr int64_t total = 10000;
+    for (int64_t i = 0; i < total; ++i) {
+        manager.apply(core::Entry{"customers", core::Key{{TESTS::makeField(i)}}, {{"name", TESTS::makeField("x")}},
+                                  false});
+    }
+
+    REQUIRE(manager.frozenCount() > 0);
+
+    // Reads see entries in both the active and frozen tables
+    for (int64_t i = 0; i < total; i += 101) {
+        REQUIRE(manager.get(core::Key{{TESTS::makeField(i)}}).has_value());
+    }
+
+    const auto oldest = manager.flushOldestFrozen();
+    REQUIRE(oldest != nullptr);
+    REQUIRE(oldest->isFrozen());
+    REQUIRE(oldest->approximateMemoryUsage() >= 256_KB);
+};
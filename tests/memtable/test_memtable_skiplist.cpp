@@ -0,0 +1,80 @@
+//
+// Created by frostzt on 10/17/2026.
+//
+
+#include <thread>
+#include <vector>
+
+#include "catch2/catch_test_macros.hpp"
+#include "lib/memtable/memtable.hpp"
+#include "tests/test_utils.hpp"
+
+TEST_CASE("skiplist memtable should put and get entries", "[MEMTABLE]") {
+    const std::string tableName = "customers";
+    const memtable::MemTable table{tableName, memtable::MemTableBackend::SkipList};
+
+    const auto primaryKey = core::Key{{TESTS::makeField("8f1860aa-5d34-43b1-b70e-917fe5227642")}};
+    const core::Entry preEntry{tableName, primaryKey, {{"name", TESTS::makeField("Sourav")}}, false};
+    table.put(preEntry);
+
+    const auto gotEntry = table.get(primaryKey);
+    REQUIRE(gotEntry.has_value());
+    REQUIRE(core::Entry::compareEntries(preEntry, gotEntry.value()));
+
+    const auto missing = table.get(core::Key{{TESTS::makeField("missing")}});
+    REQUIRE(!missing.has_value());
+};
+
+TEST_CASE("skiplist memtable should return the newest version of a key", "[MEMTABLE]") {
+    const std::string tableName = "customers";
+    const memtable::MemTable table{tableName, memtable::MemTableBackend::SkipList};
+
+    const auto primaryKey = core::Key{{TESTS::makeField("cid")}};
+    table.put(core::Entry{tableName, primaryKey, {{"name", TESTS::makeField("old")}}, false, 10});
+    table.put(core::Entry{tableName, primaryKey, {{"name", TESTS::makeField("new")}}, false, 20});
+
+    const auto gotEntry = table.get(primaryKey);
+    REQUIRE(gotEntry.has_value());
+    REQUIRE(gotEntry->timestamp_ == 20);
+    REQUIRE(gotEntry->rowData_.at("name") == TESTS::makeField("new"));
+
+    table.del(primaryKey, 30);
+    const auto deleted = table.get(primaryKey);
+    REQUIRE(deleted.has_value());
+    REQUIRE(deleted->isTombstone_);
+
+    // Only the newest version is visible through the ordered view
+    REQUIRE(table.orderedEntries().size() == 1);
+    REQUIRE(table.size() == 1);
+};
+
+TEST_CASE("skiplist memtable should keep entries ordered under concurrent inserts", "[MEMTABLE]") {
+    const std::string tableName = "customers";
+    const memtable::MemTable table{tableName, memtable::MemTableBackend::SkipList};
+
+    constexpr int threadCount = 8;
+    constexpr int perThreadCount = 2000;
+
+    std::vector<std::thread> threads;
+    threads.reserve(threadCount);
+    for (int t = 0; t < threadCount; ++t) {
+        threads.emplace_back([&table, t]() {
+            for (int i = 0; i < perThreadCount; ++i) {
+                const auto key = core::Key{{TESTS::makeField(static_cast<int64_t>(i * threadCount + t))}};
+                table.put(core::Entry{"customers", key, {}, false});
+            }
+        });
+    }
+
+    for (auto &thread: threads) thread.join();
+
+    const auto entries = table.orderedEntries();
+    REQUIRE(entries.size() == threadCount * perThreadCount);
+    for (size_t i = 1; i < entries.size(); ++i) {
+        REQUIRE(entries[i - 1].primaryKey_ < entries[i].primaryKey_);
+    }
+
+    for (int i = 0; i < threadCount * perThreadCount; i += 97) {
+        REQUIRE(table.get(core::Key{{TESTS::makeField(static_cast<int64_t>(i))}}).has_value());
+    }
+};
@@ -0,0 +1,73 @@
+//
+// Created by frostzt on 10/17/2026.
+//
+
+#include "catch2/catch_test_macros.hpp"
+#include "lib/sstable/block_cache.hpp"
+
+namespace {
+    sstable::BlockCache::Block blockOf(const size_t size, const uint8_t fill) {
+        return std::make_shared<const std::vector<uint8_t> >(size, fill);
+    }
+} // namespace
+
+TEST_CASE("block cache should return inserted blocks and count hits and misses", "[SSTABLE]") {
+    sstable::BlockCache cache(1_MB);
+
+    REQUIRE(cache.lookup(1, 0) == nullptr);
+
+    cache.insert(1, 0, blockOf(100, 1));
+    cache.insert(1, 100, blockOf(100, 2));
+    cache.insert(2, 0, blockOf(100, 3));
+
+    REQUIRE(cache.lookup(1, 0)->front() == 1);
+    REQUIRE(cache.lookup(1, 100)->front() == 2);
+    REQUIRE(cache.lookup(2, 0)->front() == 3);
+    REQUIRE(cache.lookup(2, 100) == nullptr);
+    REQUIRE(cache.usage() == 300);
+
+    const auto stats = cache.stats();
+    REQUIRE(stats.hits == 3);
+    REQUIRE(stats.misses == 2);
+    REQUIRE(stats.inserts == 3);
+    REQUIRE(stats.hitRate() == 0.6);
+};
+
+TEST_CASE("block cache should evict the least recently used block of a full shard", "[SSTABLE]") {
+    // A single shard makes the eviction order deterministic
+    sstable::BlockCache cache(300, 0);
+
+    cache.insert(1, 0, blockOf(100, 1));
+    cache.insert(1, 100, blockOf(100, 2));
+    cache.insert(1, 200, blockOf(100, 3));
+
+    // Touch the oldest block so the second one becomes the victim
+    REQUIRE(cache.lookup(1, 0) != nullptr);
+    cache.insert(1, 300, blockOf(100, 4));
+
+    REQUIRE(cache.lookup(1, 100) == nullptr);
+    REQUIRE(cache.lookup(1, 0) != nullptr);
+    REQUIRE(cache.lookup(1, 300) != nullptr);
+    REQUIRE(cache.usage() == 300);
+    REQUIRE(cache.stats().evictions == 1);
+
+    // Blocks that can never fit are not cached at all
+    cache.insert(1, 400, blockOf(400, 5));
+    REQUIRE(cache.lookup(1, 400) == nullptr);
+    REQUIRE(cache.usage() == 300);
+};
+
+TEST_CASE("block cache should drop every block of an erased file", "[SSTABLE]") {
+    sstable::BlockCache cache(1_MB);
+
+    for (uint64_t offset = 0; offset < 1000; offset += 100) {
+        cache.insert(1, offset, blockOf(100, 1));
+        cache.insert(2, offset, blockOf(100, 2));
+    }
+
+    cache.eraseFile(1);
+
+    REQUIRE(cache.usage() == 1000);
+    REQUIRE(cache.lookup(1, 0) == nullptr);
+    REQUIRE(cache.lookup(2, 0) != nullptr);
+};
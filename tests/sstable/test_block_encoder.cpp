@@ -0,0 +1,91 @@
+//
+// Created by frostzt on 10/17/2026.
+//
+
+#include <vector>
+
+#include "catch2/catch_test_macros.hpp"
+#include "lib/sstable/block_encoder.hpp"
+#include "lib/entry/key.hpp"
+#include "lib/sstable/block_iterator.hpp"
+#include "tests/test_utils.hpp"
+
+namespace {
+    std::vector<uint8_t> buildBlock(const std::shared_ptr<sstable::KeyEncoder> &keys, const int64_t count,
+                                    const size_t restartInterval) {
+        sstable::BasicBlockEncoder encoder(keys, 1_MB, restartInterval);
+        for (int64_t i = 0; i < count; ++i) encoder.add(TESTS::regionKeyOf(2 * i), "value_" + std::to_string(i));
+
+        return encoder.finish();
+    }
+} // namespace
+
+TEST_CASE("prefix key encoder should roundtrip keys against the previous key", "[SSTABLE]") {
+    sstable::PrefixKeyEncoder encoder;
+
+    std::vector<uint8_t> out;
+    encoder.encode("customer:0001", "customer:0002", out);
+
+    // 12 shared bytes, a single byte suffix
+    REQUIRE(out.size() == 3);
+    REQUIRE(out[0] == 12);
+    REQUIRE(out[1] == 1);
+
+    size_t read = 0;
+    REQUIRE(encoder.decode("customer:0001", out.data(), read) == "customer:0002");
+    REQUIRE(read == out.size());
+
+    out.clear();
+    encoder.encode("", "customer:0002", out);
+    REQUIRE(encoder.decode("", out.data(), read) == "customer:0002");
+};
+
+TEST_CASE("block encoder should shrink blocks of keys sharing prefixes", "[SSTABLE]") {
+    const auto raw = buildBlock(std::make_shared<sstable::RawKeyEncoder>(), 500, 16);
+    const auto prefix = buildBlock(std::make_shared<sstable::PrefixKeyEncoder>(), 500, 16);
+
+    REQUIRE(prefix.size() < raw.size() * 3 / 4);
+};
+
+TEST_CASE("block iterator should scan and seek through restart points", "[SSTABLE]") {
+    const auto keys = std::make_shared<sstable::PrefixKeyEncoder>();
+
+    for (const size_t interval: {1, 3, 16, 1000}) {
+        const auto block = std::make_shared<const std::vector<uint8_t> >(buildBlock(keys, 100, interval));
+        sstable::BlockIterator it(block, keys.get());
+
+        int64_t expected = 0;
+        for (it.seekToFirst(); it.valid(); it.next()) {
+            REQUIRE(it.key() == TESTS::regionKeyOf(2 * expected));
+            REQUIRE(it.value() == "value_" + std::to_string(expected));
+            expected++;
+        }
+        REQUIRE(expected == 100);
+
+        for (int64_t target = -1; target < 200; ++target) {
+            it.seek(TESTS::regionKeyOf(target));
+            if (target > 198) {
+                REQUIRE(!it.valid());
+                continue;
+            }
+
+            const int64_t next = target < 0 ? 0 : (target + 1) / 2;
+            REQUIRE(it.valid());
+            REQUIRE(it.key() == TESTS::regionKeyOf(2 * next));
+            REQUIRE(it.value() == "value_" + std::to_string(next));
+        }
+    }
+};
+
+TEST_CASE("block iterator should treat an empty block as having no pairs", "[SSTABLE]") {
+    const auto keys = std::make_shared<sstable::PrefixKeyEncoder>();
+    sstable::BasicBlockEncoder encoder(keys);
+    REQUIRE(encoder.estimatedSize() == 0);
+
+    sstable::BlockIterator it(std::make_shared<const std::vector<uint8_t> >(encoder.finish()), keys.get());
+    it.seekToFirst();
+    REQUIRE(!it.valid());
+
+    it.seek(TESTS::regionKeyOf(0));
+    REQUIRE(!it.valid());
+};
@@ -0,0 +1,60 @@
+//
+// Created by frostzt on 10/17/2026.
+//
+
+#include <string>
+#include <vector>
+
+#include "catch2/catch_test_macros.hpp"
+#include "lib/sstable/bloom_filter_policy.hpp"
+
+namespace {
+    std::string keyOf(const size_t i) { return "customer:" + std::to_string(i); }
+
+    sstable::BlockedBloomFilterPolicy buildFilter(const size_t keys, const size_t bitsPerKey) {
+        sstable::BlockedBloomFilterPolicy writer(bitsPerKey);
+        for (size_t i = 0; i < keys; ++i) writer.add(keyOf(i));
+
+        std::vector<uint8_t> serialized;
+        writer.serialize(&serialized);
+
+        sstable::BlockedBloomFilterPolicy reader(bitsPerKey);
+        reader.deserialize(serialized.data(), serialized.size());
+        return reader;
+    }
+} // namespace
+
+TEST_CASE("blocked bloom filter should never reject an added key", "[SSTABLE]") {
+    const auto filter = buildFilter(10000, 10);
+    REQUIRE(filter.blockCount() == (10000 * 10 + 511) / 512);
+
+    for (size_t i = 0; i < 10000; ++i) {
+        REQUIRE(filter.mayContain(keyOf(i)));
+        REQUIRE(filter.mayContainPortable(keyOf(i)));
+    }
+};
+
+TEST_CASE("blocked bloom filter should keep false positives near 1% at 10 bits per key", "[SSTABLE]") {
+    const auto filter = buildFilter(10000, 10);
+
+    size_t falsePositives = 0;
+    for (size_t i = 10000; i < 110000; ++i) {
+        const bool hit = filter.mayContain(keyOf(i));
+        REQUIRE(hit == filter.mayContainPortable(keyOf(i)));
+        falsePositives += hit ? 1 : 0;
+    }
+
+    REQUIRE(falsePositives < 2000);
+};
+
+TEST_CASE("blocked bloom filter should match everything when its block is unreadable", "[SSTABLE]") {
+    sstable::BlockedBloomFilterPolicy filter;
+
+    const std::vector<uint8_t> garbage{1, 2, 3};
+    filter.deserialize(garbage.data(), garbage.size());
+    REQUIRE(filter.mayContain(keyOf(1)));
+
+    // An empty filter rejects everything once serialized
+    const auto empty = buildFilter(0, 10);
+    REQUIRE(!empty.mayContain(keyOf(1)));
+};
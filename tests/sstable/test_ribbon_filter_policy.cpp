@@ -0,0 +1,62 @@
+//
+// Created by frostzt on 10/17/2026.
+//
+
+#include <string>
+#include <vector>
+
+#include "catch2/catch_test_macros.hpp"
+#include "lib/sstable/ribbon_filter_policy.hpp"
+
+namespace {
+    std::string keyOf(const size_t i) { return "customer:" + std::to_string(i); }
+} // namespace
+
+TEST_CASE("ribbon filter should never reject an added key and stay under 8 bits per key", "[SSTABLE]") {
+    constexpr size_t kKeys = 50000;
+
+    sstable::RibbonFilterPolicy writer;
+    for (size_t i = 0; i < kKeys; ++i) writer.add(keyOf(i));
+
+    std::vector<uint8_t> serialized;
+    writer.serialize(&serialized);
+    REQUIRE(serialized.size() * 8 < kKeys * 8);
+
+    const auto reader = sstable::createFilterPolicy(writer.name());
+    REQUIRE(reader != nullptr);
+    reader->deserialize(serialized.data(), serialized.size());
+
+    for (size_t i = 0; i < kKeys; ++i) REQUIRE(reader->mayContain(keyOf(i)));
+
+    // 7 fingerprint bits, 1/128 expected
+    size_t falsePositives = 0;
+    for (size_t i = kKeys; i < kKeys + 100000; ++i) falsePositives += reader->mayContain(keyOf(i)) ? 1 : 0;
+    REQUIRE(falsePositives < 1200);
+};
+
+TEST_CASE("ribbon filter should handle empty and duplicate key sets", "[SSTABLE]") {
+    sstable::RibbonFilterPolicy writer(8);
+    for (int i = 0; i < 3; ++i) writer.add(keyOf(1));
+
+    std::vector<uint8_t> serialized;
+    writer.serialize(&serialized);
+
+    sstable::RibbonFilterPolicy reader;
+    reader.deserialize(serialized.data(), serialized.size());
+    REQUIRE(reader.mayContain(keyOf(1)));
+
+    std::vector<uint8_t> empty;
+    sstable::RibbonFilterPolicy().serialize(&empty);
+    reader.deserialize(empty.data(), empty.size());
+    REQUIRE(reader.slotCount() == 64);
+};
+
+TEST_CASE("ribbon filter should match everything when its block is unreadable", "[SSTABLE]") {
+    sstable::RibbonFilterPolicy filter;
+
+    const std::vector<uint8_t> garbage{1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+    filter.deserialize(garbage.data(), garbage.size());
+    REQUIRE(filter.mayContain(keyOf(1)));
+
+    REQUIRE(sstable::createFilterPolicy("cuckoo") == nullptr);
+};
@@ -0,0 +1,161 @@
+//
+// Created by frostzt on 10/17/2026.
+//
+
+#include <filesystem>
+#include <fstream>
+#include <functional>
+
+#include "catch2/catch_test_macros.hpp"
+#include "lib/io/posix_engine.hpp"
+#include "lib/sstable/bloom_filter_policy.hpp"
+#include "lib/sstable/ribbon_filter_policy.hpp"
+#include "lib/sstable/sstable_reader.hpp"
+#include "lib/sstable/sstable_writer.hpp"
+#include "tests/test_utils.hpp"
+
+namespace {
+    /** Writes even keys 0..2*count into table 1 of `dir`, every 10th one a tombstone */
+    void writeTable(const std::string &dir, const std::shared_ptr<io_engine::IoEngine> &engine, const int64_t count,
+                    sstable::SSTableOptions options = sstable::SSTableOptions::defaults()) {
+        std::filesystem::remove_all(dir);
+        std::filesystem::create_directories(dir);
+
+        const memtable::MemTable table{"customers", memtable::MemTableBackend::SkipList};
+        for (int64_t i = 0; i < count; ++i) {
+            table.put(core::Entry{"customers", TESTS::keyOf(2 * i),
+                                  {{"name", TESTS::makeField("user_" + std::to_string(i))}}, i % 10 == 0,
+                                  static_cast<uint64_t>(100 + i)});
+        }
+
+        sstable::SSTableWriter::writeMemTable(engine, dir, sstable::tableFileName(1), table, std::move(options));
+    }
+} // namespace
+
+TEST_CASE("sstable reader should find every written key and nothing else", "[SSTABLE]") {
+    const std::string dir = "sstable_reader_get";
+    const auto engine = std::make_shared<io_engine::POSIXEngine>(0);
+    writeTable(dir, engine, 2000);
+
+    const auto cache = std::make_shared<sstable::BlockCache>(1_MB);
+    const sstable::SSTableReader reader(engine, dir, sstable::tableFileName(1), 1, cache);
+    REQUIRE(reader.properties().entries == 2000);
+
+    for (int64_t i = 0; i < 2000; ++i) {
+        const auto entry = reader.get(TESTS::keyOf(2 * i));
+        REQUIRE(entry.has_value());
+        REQUIRE(entry->primaryKey_ == TESTS::keyOf(2 * i));
+        REQUIRE(entry->isTombstone_ == (i % 10 == 0));
+        REQUIRE(entry->timestamp_ == static_cast<uint64_t>(100 + i));
+
+        REQUIRE(!reader.get(TESTS::keyOf(2 * i + 1)).has_value());
+    }
+
+    REQUIRE(!reader.get(TESTS::keyOf(-1)).has_value());
+    REQUIRE(!reader.get(TESTS::keyOf(5000)).has_value());
+
+    const auto stats = reader.stats();
+    REQUIRE(stats.gets == 4002);
+    REQUIRE(stats.getNanos > 0);
+
+    // Every data block was read from the file once, every other lookup hit the cache
+    REQUIRE(cache->stats().misses == reader.properties().dataBlocks);
+    REQUIRE(cache->stats().hits > 0);
+
+    std::filesystem::remove_all(dir);
+};
+
+TEST_CASE("sstable iterator should scan and seek across blocks in key order", "[SSTABLE]") {
+    const std::string dir = "sstable_reader_iterator";
+    const auto engine = std::make_shared<io_engine::POSIXEngine>(0);
+    writeTable(dir, engine, 2000);
+
+    const sstable::SSTableReader reader(engine, dir, sstable::tableFileName(1), 1);
+    REQUIRE(reader.properties().dataBlocks > 1);
+
+    SECTION("full scan") {
+        auto it = reader.newIterator();
+
+        int64_t expected = 0;
+        for (it.seekToFirst(); it.valid(); it.next()) {
+            REQUIRE(it.entry().primaryKey_ == TESTS::keyOf(2 * expected));
+            expected++;
+        }
+        REQUIRE(expected == 2000);
+    }
+
+    SECTION("seek lands on the first key not less than the target") {
+        auto it = reader.newIterator();
+
+        it.seek(TESTS::keyOf(1001));
+        REQUIRE(it.valid());
+        REQUIRE(it.entry().primaryKey_ == TESTS::keyOf(1002));
+
+        it.seek(TESTS::keyOf(-5));
+        REQUIRE(it.valid());
+        REQUIRE(it.entry().primaryKey_ == TESTS::keyOf(0));
+
+        it.seek(TESTS::keyOf(3998));
+        REQUIRE(it.valid());
+        it.next();
+        REQUIRE(!it.valid());
+
+        it.seek(TESTS::keyOf(3999));
+        REQUIRE(!it.valid());
+    }
+
+    std::filesystem::remove_all(dir);
+};
+
+TEST_CASE("sstable reader should answer most absent keys from the filter", "[SSTABLE]") {
+    const std::string dir = "sstable_reader_filter";
+    const auto engine = std::make_shared<io_engine::POSIXEngine>(0);
+
+    const std::vector<std::function<std::unique_ptr<sstable::FilterPolicy>()> > factories{
+        [] { return std::make_unique<sstable::BlockedBloomFilterPolicy>(); },
+        [] { return std::make_unique<sstable::RibbonFilterPolicy>(); },
+    };
+
+    for (const auto &factory: factories) {
+        auto options = sstable::SSTableOptions::defaults();
+        options.filterFactory = factory;
+        writeTable(dir, engine, 2000, options);
+
+        // The reader finds the policy through the footer, no factory needed
+        const sstable::SSTableReader reader(engine, dir, sstable::tableFileName(1), 1);
+        const uint64_t openReads = reader.stats().blockReads;
+
+        for (int64_t i = 0; i < 2000; ++i) {
+            REQUIRE(!reader.get(TESTS::keyOf(2 * i + 1)).has_value());
+        }
+
+        const auto stats = reader.stats();
+        REQUIRE(stats.filterNegatives > 1950);
+        REQUIRE(stats.blockReads - openReads == stats.gets - stats.filterNegatives);
+
+        for (int64_t i = 0; i < 2000; ++i) {
+            REQUIRE(reader.get(TESTS::keyOf(2 * i)).has_value());
+        }
+    }
+
+    std::filesystem::remove_all(dir);
+};
+
+TEST_CASE("sstable reader should reject files that are not tables", "[SSTABLE]") {
+    const std::string dir = "sstable_reader_invalid";
+    const auto engine = std::make_shared<io_engine::POSIXEngine>(0);
+    writeTable(dir, engine, 10);
+
+    // Flip a byte of the footer magic
+    const auto path = std::filesystem::path(dir) / sstable::tableFileName(1);
+    {
+        std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekp(-1, std::ios::end);
+        file.put('X');
+    }
+
+    REQUIRE_THROWS_AS(sstable::SSTableReader(engine, dir, sstable::tableFileName(1), 1), std::runtime_error);
+    REQUIRE_THROWS_AS(sstable::SSTableReader(engine, dir, sstable::tableFileName(2), 2), std::runtime_error);
+
+    std::filesystem::remove_all(dir);
+};
@@ -0,0 +1,138 @@
+//
+// Created by frostzt on 10/17/2026.
+//
+
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+
+#include "catch2/catch_test_macros.hpp"
+#include "lib/compression/lz_4_compressor.hpp"
+#include "lib/io/posix_engine.hpp"
+#include "lib/sstable/block_iterator.hpp"
+#include "lib/sstable/sstable_writer.hpp"
+#include "lib/utils/crypto_utils.hpp"
+#include "tests/test_utils.hpp"
+
+namespace {
+    std::vector<uint8_t> readFile(const std::filesystem::path &path) {
+        std::ifstream in(path, std::ios::binary);
+        return {std::istreambuf_iterator(in), std::istreambuf_iterator<char>()};
+    }
+
+    /** Verifies and unpacks the block at `handle` */
+    std::vector<uint8_t> readBlock(const std::vector<uint8_t> &file, const sstable::BlockHandle &handle) {
+        const auto header = sstable::BlockHeader::decode(file.data() + handle.offset);
+        const uint8_t *payload = file.data() + handle.offset + sstable::BlockHeader::kEncodedLength;
+
+        REQUIRE(handle.size == sstable::BlockHeader::kEncodedLength + header.compressedSize);
+        REQUIRE(Utility::computeCRC32(reinterpret_cast<const std::byte *>(payload), 0, header.compressedSize) ==
+                header.checksum);
+
+        std::vector<uint8_t> raw;
+        if (header.compression == compression::CompressorID::LZ4) {
+            compression::LZ4Compressor().decompress(payload, header.compressedSize, raw);
+        } else {
+            raw.assign(payload, payload + header.compressedSize);
+        }
+
+        REQUIRE(raw.size() == header.uncompressedSize);
+        return raw;
+    }
+
+    /** Splits a block written with the default key encoder into its pairs */
+    std::vector<std::pair<std::string, std::string> > decodeBlock(const std::vector<uint8_t> &block) {
+        sstable::PrefixKeyEncoder keys;
+        std::vector<std::pair<std::string, std::string> > pairs;
+
+        sstable::BlockIterator it(std::make_shared<const std::vector<uint8_t> >(block), &keys);
+        for (it.seekToFirst(); it.valid(); it.next()) {
+            pairs.emplace_back(it.key(), std::string(it.value()));
+        }
+
+        return pairs;
+    }
+} // namespace
+
+TEST_CASE("sstable writer should flush a memtable into blocks, index, meta and footer", "[SSTABLE]") {
+    const std::string dir = "sstable_writer_test";
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+
+    const memtable::MemTable table{"customers", memtable::MemTableBackend::SkipList};
+    for (int64_t i = 0; i < 2000; ++i) {
+        table.put(core::Entry{"customers", TESTS::keyOf(i), {{"name", TESTS::makeField("user_" + std::to_string(i))}},
+                              i % 10 == 0, static_cast<uint64_t>(100 + i)});
+    }
+
+    const auto engine = std::make_shared<io_engine::POSIXEngine>(0);
+    const auto props = sstable::SSTableWriter::writeMemTable(engine, dir, sstable::tableFileName(1), table);
+
+    REQUIRE(props.entries == 2000);
+    REQUIRE(props.tombstones == 200);
+    REQUIRE(props.minTimestamp == 100);
+    REQUIRE(props.maxTimestamp == 2099);
+    REQUIRE(props.dataBlocks > 1);
+
+    const auto path = std::filesystem::path(dir) / "000001.sst";
+    REQUIRE(std::filesystem::exists(path));
+    REQUIRE(!std::filesystem::exists(path.string() + ".tmp"));
+
+    const auto file = readFile(path);
+    REQUIRE(file.size() == props.fileSize);
+
+    const auto footer = sstable::Footer::decode(file.data() + file.size() - sstable::Footer::kEncodedLength);
+    REQUIRE(footer.has_value());
+    REQUIRE(footer->compressor == compression::CompressorID::LZ4);
+    REQUIRE(footer->filter.isNull());
+
+    const auto metaBlock = readBlock(file, footer->meta);
+    const auto meta = sstable::TableProperties::decode(metaBlock.data(), metaBlock.size());
+    REQUIRE(meta.has_value());
+    REQUIRE(meta->entries == props.entries);
+    REQUIRE(meta->smallestKey == props.smallestKey);
+    REQUIRE(meta->largestKey == props.largestKey);
+
+    // Walk every data block through the index and check that all entries come back in order
+    const auto index = decodeBlock(readBlock(file, footer->index));
+    REQUIRE(index.size() == props.dataBlocks);
+
+    int64_t expected = 0;
+    for (const auto &[lastKey, encodedHandle]: index) {
+        sstable::BlockHandle handle;
+        const auto *data = reinterpret_cast<const uint8_t *>(encodedHandle.data());
+        REQUIRE(handle.decodeFrom(data, data + encodedHandle.size()) != nullptr);
+
+        const auto pairs = decodeBlock(readBlock(file, handle));
+        REQUIRE(pairs.back().first == lastKey);
+
+        for (const auto &[key, value]: pairs) {
+            const auto entry = core::Entry::deserialize(reinterpret_cast<const std::byte *>(value.data()),
+                                                        value.size());
+            REQUIRE(entry.has_value());
+            REQUIRE(entry->primaryKey_ == TESTS::keyOf(expected));
+            REQUIRE(entry->isTombstone_ == (expected % 10 == 0));
+            expected++;
+        }
+    }
+    REQUIRE(expected == 2000);
+
+    std::filesystem::remove_all(dir);
+};
+
+TEST_CASE("sstable writer should leave nothing behind when abandoned", "[SSTABLE]") {
+    const std::string dir = "sstable_writer_abandon";
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+
+    {
+        sstable::SSTableWriter writer(std::make_shared<io_engine::POSIXEngine>(0), dir, sstable::tableFileName(7));
+        const core::Entry entry{"customers", TESTS::keyOf(1), {}, false, 1};
+        const auto bytes = entry.serialize();
+        const std::string_view view(reinterpret_cast<const char *>(bytes.data()), bytes.size());
+        writer.add(entry.primaryKey_.orderedBytes(), view);
+    }
+
+    REQUIRE(std::filesystem::is_empty(dir));
+    std::filesystem::remove_all(dir);
+};
@@ -7,6 +7,7 @@
 #define TEST_UTILS_HPP
 
 #include "lib/datatypes/field.hpp"
+#include "lib/entry/key.hpp"
 
 namespace TESTS {
     inline core::datatypes::Field makeField(std::string v) {
@@ -36,6 +37,14 @@ namespace TESTS {
     inline core::datatypes::Field makeField(std::chrono::system_clock::time_point v) {
         return core::datatypes::Field{v, core::datatypes::FieldType::Timestamp, nullptr};
     }
+
+    /** Single column primary key `i` */
+    inline core::Key keyOf(const int64_t i) { return core::Key{{makeField(i)}}; }
+
+    /** Ordered bytes of the (region, customer id) composite primary key */
+    inline std::string regionKeyOf(const int64_t i) {
+        return core::Key{{makeField(std::string("eu-west-1")), makeField(i)}}.orderedBytes();
+    }
 } // namespace TESTS
 
 #endif //TEST_UTILS_HPP
@@ -2,6 +2,9 @@
 // Created by frostzt on 7/17/2025.
 //
 
+#include <algorithm>
+#include <span>
+
 #include "catch2/catch_test_macros.hpp"
 #include "lib/entry/entry.hpp"
 #include "tests/test_utils.hpp"
@@ -12,3 +15,50 @@ TEST_CASE("should convert to bytes", "[BYTE_PARSER]") {
     REQUIRE(!serialized.empty());
     auto de = entry.toHex();
 };
+
+TEST_CASE("serializeInto should write exactly serializedSize bytes and round trip", "[BYTE_PARSER]") {
+    const core::Row row{
+        {"name", TESTS::makeField(std::string("alice"))},
+        {"age", TESTS::makeField(int32_t{30})},
+        {"balance", TESTS::makeField(12.5)},
+        {"seen", TESTS::makeField(std::chrono::system_clock::time_point(std::chrono::nanoseconds(99)))},
+        {"token", TESTS::makeField(core::datatypes::UUID("123e4567-e89b-12d3-a456-426614174000"))},
+        {"blob", TESTS::makeField(std::vector<uint8_t>{1, 2, 3})},
+        {"nothing", core::datatypes::Field{std::monostate{}, core::datatypes::FieldType::Null, nullptr}},
+    };
+    const core::Entry entry("customer", core::Key{{TESTS::makeField("cid"), TESTS::makeField(int64_t{7})}}, row,
+                            false, 42);
+
+    const auto serialized = entry.serialize();
+    REQUIRE(serialized.size() == entry.serializedSize());
+
+    // Into the middle of a larger buffer, the bytes around it are left alone
+    std::vector<std::byte> buffer(entry.serializedSize() + 8, std::byte{0xAB});
+    entry.serializeInto(std::span(buffer).subspan(4, entry.serializedSize()));
+    REQUIRE(std::equal(serialized.begin(), serialized.end(), buffer.begin() + 4));
+    REQUIRE(buffer[3] == std::byte{0xAB});
+    REQUIRE(buffer[buffer.size() - 4] == std::byte{0xAB});
+
+    const auto decoded = core::Entry::deserialize(serialized.data(), serialized.size());
+    REQUIRE(decoded.has_value());
+    REQUIRE(core::Entry::compareEntries(*decoded, entry));
+};
+
+TEST_CASE("serializeInto should size packed rows around the varint length boundary", "[BYTE_PARSER]") {
+    const auto schema = std::make_shared<const core::TableSchema>(
+        "byte_utils_packed", std::vector<core::ColumnSchema>{{"name", core::datatypes::FieldType::String}});
+    core::SchemaRegistry::global().put(schema);
+
+    // The packed row's length prefix grows from one to two bytes within this range
+    for (size_t length = 100; length < 160; ++length) {
+        const core::Entry entry(schema, core::Key{{TESTS::makeField(int64_t{1})}},
+                                {{"name", TESTS::makeField(std::string(length, 'x'))}}, false, 5);
+
+        const auto serialized = entry.serialize();
+        REQUIRE(serialized.size() == entry.serializedSize());
+
+        const auto decoded = core::Entry::deserialize(serialized.data(), serialized.size());
+        REQUIRE(decoded.has_value());
+        REQUIRE(core::Entry::compareEntries(*decoded, entry));
+    }
+};
@@ -0,0 +1,61 @@
+//
+// Created by frostzt on 10/17/2026.
+//
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include "catch2/catch_test_macros.hpp"
+#include "lib/utils/crypto_utils.hpp"
+
+namespace {
+    std::vector<std::byte> randomBytes(const size_t size, const uint32_t seed) {
+        std::mt19937 gen(seed);
+        std::vector<std::byte> bytes(size);
+        for (auto &b: bytes) b = static_cast<std::byte>(gen() & 0xFF);
+        return bytes;
+    }
+} // namespace
+
+TEST_CASE("crc32c should match the Castagnoli check value", "[CRC32]") {
+    const std::string check = "123456789";
+    const auto *data = reinterpret_cast<const std::byte *>(check.data());
+
+    REQUIRE(Utility::computeCRC32(data, 0, check.size()) == 0xE3069283U);
+    REQUIRE(Utility::extendCRC32Software(0, data, check.size()) == 0xE3069283U);
+    REQUIRE(Utility::computeCRC32(data, 0, 0) == 0);
+
+    // 32 zero bytes, RFC 3720 B.4
+    const std::vector<std::byte> zeros(32, std::byte{0});
+    REQUIRE(Utility::computeCRC32(zeros, 0, 0) == 0x8A9136AAU);
+};
+
+TEST_CASE("crc32c hardware and software paths should agree", "[CRC32]") {
+    // Lengths around the interleaved lane boundaries (3 * 256 and 3 * 8192) and odd offsets to
+    // exercise the unaligned head and the byte tail
+    const auto bytes = randomBytes(64 * 1024 + 64, 7);
+    for (const size_t length: {size_t{0}, size_t{1}, size_t{7}, size_t{8}, size_t{63}, size_t{767}, size_t{768},
+                               size_t{769}, size_t{4096}, size_t{24575}, size_t{24576}, size_t{24577},
+                               size_t{64 * 1024}}) {
+        for (size_t offset = 0; offset < 8; ++offset) {
+            const std::byte *data = bytes.data() + offset;
+            const uint32_t software = Utility::extendCRC32Software(0, data, length);
+
+            REQUIRE(Utility::computeCRC32(bytes.data(), offset, length) == software);
+            if (Utility::hasHardwareCRC32()) {
+                REQUIRE(Utility::extendCRC32Hardware(0, data, length) == software);
+            }
+        }
+    }
+};
+
+TEST_CASE("crc32c should extend across split buffers", "[CRC32]") {
+    const auto bytes = randomBytes(100000, 11);
+    const uint32_t whole = Utility::computeCRC32(bytes, 0, 0);
+
+    for (const size_t split: {size_t{1}, size_t{13}, size_t{4096}, size_t{50001}, size_t{99999}}) {
+        const uint32_t head = Utility::computeCRC32(bytes.data(), 0, split);
+        REQUIRE(Utility::extendCRC32(head, bytes.data() + split, bytes.size() - split) == whole);
+    }
+};
@@ -6,6 +6,7 @@
 
 #include "catch2/catch_test_macros.hpp"
 #include "lib/wal/wal_codec.hpp"
+#include "lib/wal/wal_segment_reader.hpp"
 #include "lib/entry/entry.hpp"
 #include "tests/test_utils.hpp"
 
@@ -84,3 +85,40 @@ TEST_CASE("should encode and decode a full WAL file with multiple entries", "[WA
     in.close();
     std::filesystem::remove(fileName);
 };
+
+TEST_CASE("segment reader should decode records straight from the mapped file", "[WAL]") {
+    std::string fileName = "00001_test.wal";
+    std::ofstream out(fileName, std::ios_base::out | std::ios_base::binary);
+    REQUIRE(out.good());
+
+    std::vector<core::Entry> written;
+    for (int i = 0; i < 100; ++i) {
+        written.emplace_back("customers", core::Key{{TESTS::makeField(i)}},
+                             core::Row{{"name", TESTS::makeField("user_" + std::to_string(i))}}, false);
+        ::WAL::writeRecord(out, written.back());
+    }
+
+    // Torn tail: a record header whose payload never made it to disk
+    out.write("WAL01\xff\x00\x00\x00", 9);
+    out.close();
+
+    ::WAL::WALSegmentReader reader(fileName);
+
+    size_t read = 0;
+    while (auto entry = reader.next()) {
+        REQUIRE(core::Entry::compareEntries(written[read], *entry));
+        read++;
+    }
+
+    REQUIRE(read == written.size());
+    REQUIRE(reader.offset() == reader.size() - 9);
+
+    std::filesystem::remove(fileName);
+
+    // An empty segment has nothing to map and nothing to read
+    std::ofstream{fileName};
+    ::WAL::WALSegmentReader empty(fileName);
+    REQUIRE(!empty.next().has_value());
+
+    std::filesystem::remove(fileName);
+};
@@ -3,6 +3,7 @@
 //
 
 #include <filesystem>
+#include <thread>
 
 #include "catch2/catch_test_macros.hpp"
 #include "lib/wal/wal_manager.hpp"
@@ -96,3 +97,36 @@ TEST_CASE("writer should flush data to disk", "[WAL]") {
     fileIn.close();
     std::filesystem::remove_all(path);
 };
+
+TEST_CASE("group commit should make every concurrent append durable", "[WAL]") {
+    std::string path = "wal";
+    std::filesystem::create_directory(path);
+
+    // A single writer so every appender lands in the same commit queue
+    ::WAL::WALManager manager(1, 64_KB, path, ::WAL::FlushMode::GROUP_COMMIT);
+
+    constexpr int threadCount = 8;
+    constexpr int perThreadCount = 500;
+
+    std::atomic<int> failed{0};
+    std::vector<std::thread> threads;
+    threads.reserve(threadCount);
+    for (int t = 0; t < threadCount; ++t) {
+        threads.emplace_back([&manager, &failed, t]() {
+            for (int i = 0; i < perThreadCount; ++i) {
+                const core::Entry entry("customer", core::Key{{TESTS::makeField(t * perThreadCount + i)}},
+                                        {{"name", TESTS::makeField("sourav")}}, false);
+                if (!manager.append(entry)) failed++;
+            }
+        });
+    }
+
+    for (auto &thread: threads) thread.join();
+    REQUIRE(failed == 0);
+
+    // Nothing is left buffered: everything is readable without closing the writer first
+    REQUIRE(manager.loadAll().size() == threadCount * perThreadCount);
+
+    manager.close();
+    std::filesystem::remove_all(path);
+};